@@ -11,6 +11,7 @@ dataset_name = ""
 rename_dict = { "aemin":"AE-Min",
                 "aemax":"AE-Max",
                 "crc32":"CRC32",
+                "crc32c":"CRC32C",
                 "fastcdc":"FastCDC",
                 "gear":"Gear",
                 "maxp":"MAXP",
@@ -18,6 +19,18 @@ rename_dict = { "aemin":"AE-Min",
                 "ram":"RAM",
                 "seqcdc":"SeqCDC",
                 "tttd":"TTTD",
+                "vrabins256":"VRabin-256",
+                "vrabins512":"VRabin-512",
+                "vtttd256":"VTTTD-256",
+                "vtttd512":"VTTTD-512",
+                "vseqcdc256":"VSeqCDC-256",
+                "vseqcdc512":"VSeqCDC-512",
+                "vcrc256":"VCRC-256",
+                "vcrc512":"VCRC-512",
+                "vfastcdc256":"VFastCDC-256",
+                "vfastcdc512":"VFastCDC-512",
+                "vgear256":"VGear-256",
+                "vgear512":"VGear-512",
                 "vaemax128":"VAEMax-128",
                 "vaemax256":"VAEMax-256",
                 "vaemax512":"VAEMax-512",                
@@ -36,14 +49,36 @@ def build_custom_order(keys):
     custom_order = []
     if("CRC32" in keys):
         custom_order.append("CRC32")
+    if("VCRC-256" in keys):
+        custom_order.append("VCRC-256")
+    if("VCRC-512" in keys):
+        custom_order.append("VCRC-512")
+    if("CRC32C" in keys):
+        custom_order.append("CRC32C")
     if("FastCDC" in keys):
         custom_order.append("FastCDC")
+    if("VFastCDC-256" in keys):
+        custom_order.append("VFastCDC-256")
+    if("VFastCDC-512" in keys):
+        custom_order.append("VFastCDC-512")
     if("Gear" in keys):
         custom_order.append("Gear")
+    if("VGear-256" in keys):
+        custom_order.append("VGear-256")
+    if("VGear-512" in keys):
+        custom_order.append("VGear-512")
     if("Rabin" in keys):
         custom_order.append("Rabin")
+    if("VRabin-256" in keys):
+        custom_order.append("VRabin-256")
+    if("VRabin-512" in keys):
+        custom_order.append("VRabin-512")
     if("TTTD" in keys):
         custom_order.append("TTTD")
+    if("VTTTD-256" in keys):
+        custom_order.append("VTTTD-256")
+    if("VTTTD-512" in keys):
+        custom_order.append("VTTTD-512")
     
     if("AE-Max" in keys):
         custom_order.append("AE-Max")
@@ -83,6 +118,10 @@ def build_custom_order(keys):
     
     if("SeqCDC" in keys):
         custom_order.append("SeqCDC")
+    if("VSeqCDC-256" in keys):
+        custom_order.append("VSeqCDC-256")
+    if("VSeqCDC-512" in keys):
+        custom_order.append("VSeqCDC-512")
     
     for key in keys:
         if(key not in rename_dict.keys()):
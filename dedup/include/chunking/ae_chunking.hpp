@@ -12,64 +12,77 @@
 #define DEFAULT_AE_AVG_BLOCK_SIZE 4096
 
 class AE_Chunking : public virtual AVX_Chunking_Technique {
-   private:
+   protected:
     uint64_t avg_block_size;
     uint64_t window_size;
     uint64_t curr_pos;
     AE_Mode extreme_mode;
+    // Native search of the chunk resume_cutpoint is searching: next position and the
+    // extreme value so far with its position. scan_pos is 0 if there is none
+    uint64_t scan_pos = 0;
+    uint64_t scan_value = 0;
+    uint64_t scan_value_pos = 0;
 
     /**
-     * @brief SSE128, AVX256 and AVX512 arrays for SIMD operations
-     * 
+     * @brief finds the next cut point in an array of bytes
+     * @param buff: the buff to find the cutpoint in.
+     * @param size: the size of the buffer
+     * @return: cutpoint position in the buffer 
      */
-    #if defined(__SSE3__)
-    __m128i* sse_array;
-    #endif
+    uint64_t find_cutpoint(char* buff, uint64_t size) override;
 
-    #if defined(__AVX2__)
-    __m256i* avx256_array;
-    #endif
+    /**
+     * @brief native search of a whole chunk
+     * @param MAXIMUM: whether the cut point follows a maximum (AE_Mode MAX) or a minimum
+     */
+    template <bool MAXIMUM>
+    uint64_t find_cutpoint_native(char* buff, uint64_t size);
 
-    #if defined(__AVX512F__)
-    __m512i* avx512_array;
-    #endif
+    /**
+     * @brief continues the native search from the scan members as the chunk grows. The SIMD
+     * search summarizes the whole chunk, so it waits for all its bytes like Chunking_Technique
+     * @return: cutpoint position in the buffer, 0 if more bytes are needed
+     */
+    uint64_t resume_cutpoint(char* buff, uint64_t size, bool end_of_data) override;
 
-    #if defined(__ARM_NEON)
-    uint8x16_t* neon_array;
-    #endif
+    template <bool MAXIMUM>
+    uint64_t resume_native(char* buff, uint64_t size, bool end_of_data);
 
-    #if defined(__ALTIVEC__)
-    __vector unsigned char* altivec_array;
-    #endif
+    void reset_scan() override;
 
     /**
-     * @brief finds the next cut point in an array of bytes
-     * @param buff: the buff to find the cutpoint in.
-     * @param size: the size of the buffer
-     * @return: cutpoint position in the buffer 
+     * @brief native search from the scan members, which are updated if it reaches size
+     * @return: cutpoint position in the buffer, size if there is none
      */
-    uint64_t find_cutpoint(char* buff, uint64_t size) override;
-    uint64_t find_cutpoint_native(char* buff, uint64_t size);
+    template <bool MAXIMUM>
+    uint64_t scan_native(char* buff, uint64_t size);
    
-    #if defined(__SSE3__)
-    uint64_t find_cutpoint_sse128(char* buff, uint64_t size);
-    #endif
-    
-    #if defined(__AVX2__)
-    uint64_t find_cutpoint_avx256(char* buff, uint64_t size);
-    #endif
-    
-    #if defined(__AVX512F__)
-    uint64_t find_cutpoint_avx512(char* buff, uint64_t size);
-    #endif
-
-    #if defined(__ARM_NEON)
-    uint64_t find_cutpoint_neon(char* buff, uint64_t size);
-    #endif
-
-    #if defined(__ALTIVEC__)
-    uint64_t find_cutpoint_altivec(char* buff, uint64_t size);
-    #endif
+    /**
+     * @brief finds the next cut point with the range scans of a SIMD vector type (see simd_kernels.hpp),
+     * giving the same cut points as find_cutpoint_native. No_Slide_Vector types search with find_cutpoint_noslide
+     * @param MAXIMUM: whether the cut point follows a maximum (AE_Mode MAX) or a minimum
+     */
+    template <class Vector, bool MAXIMUM>
+    uint64_t find_cutpoint_simd(char* buff, uint64_t size);
+
+    /**
+     * @brief search of the no-slide modes: the extreme value of the whole window after the current one is found
+     * with find_extremum, and the search jumps to its first position instead of sliding through the values
+     * between them. Gives the same cut points as find_cutpoint_native
+     */
+    template <class Vector, bool MAXIMUM>
+    uint64_t find_cutpoint_noslide(char* buff, uint64_t size);
+
+    /**
+     * @brief finds the cut points of a buffer with the search of simd_mode, selected once for the buffer
+     */
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+
+    /**
+     * @brief finds the cut points of a buffer with the search of a vector type, or the native search for void
+     */
+    template <class Vector, bool MAXIMUM>
+    uint64_t find_cutpoints_for(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts);
 
 
     public:
@@ -86,8 +99,35 @@ class AE_Chunking : public virtual AVX_Chunking_Technique {
      */
     AE_Chunking(const Config& config);
 
-    ~AE_Chunking();
+    /**
+     * @brief Checks whether the CPU supports a SIMD mode
+     * @param mode: SIMD mode
+     * @return: bool
+     */
+    bool supports_simd_mode(SIMD_Mode mode) const override;
+
+};
+
+/**
+ * @brief AE chunking with the search fixed at compile time: the vector type of its SIMD mode (void for the
+ * native search) and the extreme mode. The driver creates it from the config, so finding the cut points of a
+ * buffer selects nothing at runtime.
+ */
+template <class Vector, bool MAXIMUM>
+class AE_Chunking_Specialized : public AE_Chunking {
+    uint64_t find_cutpoint(char* buff, uint64_t size) override;
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+    uint64_t resume_cutpoint(char* buff, uint64_t size, bool end_of_data) override;
 
+   public:
+    using AE_Chunking::AE_Chunking;
 };
 
+// Instantiated in ae_chunking.cpp for the native search and each vector type of the binary
+#define EXTERN_AE_CHUNKING_SPECIALIZATIONS(VECTOR) \
+    extern template class AE_Chunking_Specialized<VECTOR, true>; \
+    extern template class AE_Chunking_Specialized<VECTOR, false>;
+EXTERN_AE_CHUNKING_SPECIALIZATIONS(void)
+FOR_EACH_SIMD_VECTOR(EXTERN_AE_CHUNKING_SPECIALIZATIONS)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file autotune.hpp
+ * @author WASL
+ * @brief Calibration run choosing the SIMD mode and buffer size of a chunking
+ * technique at startup (simd_mode=autotune)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _AUTOTUNE_
+#define _AUTOTUNE_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "chunking_common.hpp"
+#include "config.hpp"
+
+// Random bytes and zero bytes generated for the calibration
+#define AUTOTUNE_RANDOM_BYTES (3 * 1024 * 1024)
+#define AUTOTUNE_ZERO_BYTES (1024 * 1024)
+// Bytes read from the input for the calibration, at most AUTOTUNE_SAMPLE_BYTES_PER_FILE per file
+#define AUTOTUNE_SAMPLE_BYTES (4 * 1024 * 1024)
+#define AUTOTUNE_SAMPLE_BYTES_PER_FILE (1024 * 1024)
+// Every combination is timed this many times, the fastest run is kept
+#define AUTOTUNE_ROUNDS 3
+
+typedef std::function<std::unique_ptr<Chunking_Technique>(const Config&)> Chunking_Technique_Factory;
+
+struct Autotune_Result {
+    SIMD_Mode simd_mode;
+    uint64_t buffer_size;
+    // Chunking throughput on the calibration data in MB/sec, 0 if read from the profile
+    double throughput;
+};
+
+/**
+ * @brief Times every SIMD mode the configured chunking technique supports on
+ * this CPU with every candidate buffer size, on synthetic data and on data
+ * sampled from the input, the same way Chunking Throughput is measured.
+ * Combinations that do not give the chunk boundaries of simd_mode=auto with
+ * the configured buffer size are skipped. The fastest combination is printed
+ * and set in config, and cached in the autotune_profile file if configured.
+ *
+ * @param config: config of the run, its SIMD mode and buffer size are replaced
+ * @param input_path: directory to chunk, or manifest listing the files to chunk
+ * @param manifest_mode: true if input_path is a manifest
+ * @param create_chunking_technique: creates the chunking technique of a config
+ * @return Autotune_Result
+ */
+Autotune_Result autotune_chunking(Config& config, const std::string& input_path, bool manifest_mode,
+                                  const Chunking_Technique_Factory& create_chunking_technique);
+
+#endif
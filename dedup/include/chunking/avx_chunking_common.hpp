@@ -2,20 +2,13 @@
 #define _AVX_COMMON_CHUNKING_
 
 #include <chunking_common.hpp>
-
-#if defined(__SSE3__) || defined(__AVX2__) || defined(__AVX512F__) || defined(__BMI2__)
-    #include <x86intrin.h>
-#elif defined(__ARM_NEON)
-    #include <arm_neon.h>
-#elif defined(__ALTIVEC__)
-    #include <altivec.h>
-    #undef vector // Avoid conflict with std::vector
-    #undef bool // Avoid conflict with std::bool
-#endif
+#include "simd_dispatch.hpp"
+#include "simd_kernels.hpp"
 
 #include <iostream>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 
 #define SSE_REGISTER_SIZE_BITS 128
@@ -27,6 +20,81 @@
 #define AVX512_REGISTER_SIZE_BITS 512
 #define AVX512_REGISTER_SIZE_BYTES 64
 #define AVX512_REGISTER_SIZE_INT32 16
+#define AVX512_REGISTER_SIZE_INT64 8
+
+#define AVX256_REGISTER_SIZE_INT64 4
+#define AVX256_REGISTER_SIZE_INT32 8
+
+// Number of bytes contributing to a gear hash: older bytes are shifted out
+#define GEAR_HASH_WINDOW_SIZE 64
+// Positions hashed by each lane of the gear kernels when searching for a single cut-point
+#define GEAR_SIMD_LANE_SPAN 512
+
+// Positions fingerprinted by each lane of the Rabin kernels per block of find_cutpoint
+#define RABIN_SIMD_LANE_SPAN 512
+
+// Window of the SS-CDC CRC: its removal table cancels the byte leaving a window of this many bytes
+#define CRC_HASH_WINDOW_SIZE 256
+
+// Most streams the lockstep kernels advance at once, one per 64-bit lane
+#define STREAM_LANES_MAX 8
+
+/**
+ * @brief State of the streams advanced in lockstep by the multi-stream kernels, one entry per lane.
+ * Positions are offsets in the data of the lane.
+ */
+struct Stream_Lanes {
+    // Address of the data of each stream
+    uint64_t data[STREAM_LANES_MAX];
+    // Next position to hash
+    uint64_t pos[STREAM_LANES_MAX];
+    // Cut-point of the lane if no position before it matches
+    uint64_t end[STREAM_LANES_MAX];
+    // Gear: first position tested against the second mask. Rabin: first position that may end the chunk
+    uint64_t phase[STREAM_LANES_MAX];
+    uint64_t hash[STREAM_LANES_MAX];
+    // Written by the kernels for the lanes that found their cut-point
+    uint64_t cut[STREAM_LANES_MAX];
+};
+
+// Positions the SeqCDC kernels compare per block, one bit each in the comparison masks
+#define SEQ_SIMD_BLOCK_SIZE 64
+
+/**
+ * @brief State of a SeqCDC cut-point search, handed from the SIMD kernels to the scalar code
+ */
+struct Seq_Scan_State {
+    // Next position compared with the byte before it
+    uint64_t pos;
+    uint64_t opposing_slope_count;
+    uint64_t seq_length;
+};
+
+/**
+ * @brief Maximum and minimum byte of the complete EXTREMA_BLOCK_SIZE-byte blocks of the data being chunked.
+ * The blocks [first, end) are summarized, more are added as range queries reach them.
+ */
+struct Block_Extrema {
+    const char *buff = nullptr;
+    // Number of complete blocks in buff
+    uint64_t num_blocks = 0;
+    uint64_t first = 0;
+    uint64_t end = 0;
+    std::vector<uint8_t> max;
+    std::vector<uint8_t> min;
+};
+
+// Bytes find_run looks ahead for a run. Bounds the detection done for a chunk that ends before its run.
+#define RUN_SKIP_LOOKAHEAD 1024
+
+/**
+ * @brief Run of equal bytes found by find_run, empty (start == end) if there is none. The bytes up to end
+ * are known to be equal, the run may go on after it (see skip_run).
+ */
+struct Byte_Run {
+    uint64_t start;
+    uint64_t end;
+};
 
 #define NEON_REGISTER_SIZE_BITS 128
 #define NEON_REGISTER_SIZE_BYTES 16
@@ -39,199 +107,301 @@ class AVX_Chunking_Technique: public virtual Chunking_Technique{
 
     SIMD_Mode simd_mode;
 
-    #ifdef __SSE3__
-        const __m128i K_INV_ZERO = _mm_set1_epi8(0xFF);
-    #endif
-    
-    #ifdef __AVX2__
-        const __m256i K_INV_ZERO_256 = _mm256_set1_epi8(0xFF);
-    #endif
-
     // For debugging only
     uint64_t chunk_counter;
 
-    public:
+    Block_Extrema block_extrema;
+
+    // Skip the runs of equal bytes where the chunker would not find a cut-point (run_skip in the config)
+    bool run_skip = false;
+
     /**
-     * @brief Finds maximum value in the region between <start_pos, end_pos> within the data stream *buff using SIMD instructions
+     * @brief Starts the block summaries of the data searched by the next range queries
      * 
      * @param buff Data Stream
+     * @param size Size of the data
+     */
+    void reset_block_extrema(const char *buff, uint64_t size);
+
+    /**
+     * @brief Summarizes the blocks [first_block, end_block) that are not summarized yet with the kernel of simd_mode
+     */
+    void summarize_blocks(uint64_t first_block, uint64_t end_block);
+
+    /**
+     * @brief Finds the maximum value in the region between <start_pos, end_pos> of the data given to
+     * reset_block_extrema. The complete blocks of the region are read from their summaries and only the
+     * partial blocks at its ends are scanned, so overlapping regions do not scan the same bytes again.
+     * 
      * @param start_pos Starting position of scanned region
      * @param end_pos Ending position of scanned region
      * @return uint8_t Maximum Value
      */
-    #ifdef __SSE3__
-        uint8_t find_maximum_sse128(char *buff, uint64_t start_pos, uint64_t end_pos, __m128i *xmm_array);
-    #endif
-    
-    #ifdef __AVX2__
-        uint8_t find_maximum_avx256(char *buff, uint64_t start_pos, uint64_t end_pos, __m256i *ymm_array);
-    #endif
-
-    #if defined(__AVX512F__)
-        uint8_t find_maximum_avx512(char *buff, uint64_t start_pos, uint64_t end_pos, __m512i *zmm_array);
-    #endif
-
-    #if defined(__ARM_NEON)
-        uint8_t find_maximum_neon(char *buff, uint64_t start_pos, uint64_t end_pos, uint8x16_t *neon_array);
-    #endif
-
-    #ifdef __ALTIVEC__
-        uint8_t find_maximum_altivec(char *buff, uint64_t start_pos, uint64_t end_pos, __vector unsigned char *vec_array);
-    #endif
+    uint8_t range_maximum(uint64_t start_pos, uint64_t end_pos);
 
     /**
-     * @brief Finds minimum value in the region between <start_pos, end_pos> within the data stream *buff using SIMD instructions
+     * @brief Finds the minimum value in the region between <start_pos, end_pos>, see range_maximum
      * 
-     * @param buff Data Stream
      * @param start_pos Starting position of scanned region
      * @param end_pos Ending position of scanned region
      * @return uint8_t Minimum Value
      */
+    uint8_t range_minimum(uint64_t start_pos, uint64_t end_pos);
 
-    #ifdef __SSE3__
-        uint8_t find_minimum_sse128(char *buff, uint64_t start_pos, uint64_t end_pos, __m128i *xmm_array);
-    #endif
-    
-    #ifdef __AVX2__
-        uint8_t find_minimum_avx256(char *buff, uint64_t start_pos, uint64_t end_pos, __m256i *ymm_array);
-    #endif  
-
-    #if defined(__AVX512F__)
-        uint8_t find_minimum_avx512(char *buff, uint64_t start_pos, uint64_t end_pos, __m512i *zmm_array);
-    #endif
+    /**
+     * @brief Finds the first run of equal bytes in the region between <start, end> that covers a whole
+     * RUN_SKIP_BLOCK_SIZE-byte block, with the kernel of simd_mode. The run is extended back to start and
+     * ends with that block. Only the first RUN_SKIP_LOOKAHEAD bytes are searched: without a run, the returned
+     * run is empty and starts where the search stopped. Without run_skip, it is empty and starts at end.
+     * 
+     * @param buff Data Stream
+     * @param start Starting position of searched region
+     * @param end Ending position of searched region
+     * @return Byte_Run
+     */
+    Byte_Run find_run(const char *buff, uint64_t start, uint64_t end);
 
-    #if defined(__ARM_NEON)
-        uint8_t find_minimum_neon(char *buff, uint64_t start_pos, uint64_t end_pos, uint8x16_t *neon_array);
-    #endif
+    /**
+     * @brief Finds the first byte not equal to value in the region between <start, end> with the range scan
+     * of simd_mode
+     * 
+     * @return uint64_t Its position, end if all bytes are equal to value
+     */
+    uint64_t run_end(const char *buff, uint64_t start, uint64_t end, uint8_t value);
 
-    #ifdef __ALTIVEC__
-        uint8_t find_minimum_altivec(char *buff, uint64_t start_pos, uint64_t end_pos, __vector unsigned char *vec_array);
-    #endif
+    /**
+     * @brief Finds where a run returned by find_run really ends. Only done once the run is skipped, so a
+     * chunk that ends at the start of a long run does not scan the rest of it.
+     * 
+     * @return uint64_t The first position after the run before end, run.end if the run is empty
+     */
+    uint64_t skip_run(const char *buff, const Byte_Run &run, uint64_t end);
 
+    public:
     /**
-     * @brief Executes a range scan comparing bytes serially against the target value between <start_pos, end_pos> within the data stream *buff using SIMD instructions.
-     * Comparison operator: GEQ (>=)
+     * @brief Evaluates a gear hash at every position of a region using SIMD instructions. Each 64-bit
+     * lane hashes lane_span consecutive positions, warming up with the GEAR_HASH_WINDOW_SIZE bytes preceding
+     * them, so every position is hashed over its full window.
+     * For each mask, bit p % 64 of words[mask][p / 64] is set if (hash & mask) == 0, p being relative to start.
      * 
      * @param buff Data Stream
-     * @param start_pos Starting position of scanned region
-     * @param end_pos Ending position of scanned region
-     * @param target_value Target value
-     * @return uint64_t Position of first matching candidate. 
-     * @return end_position if no match found
+     * @param start Position of the first hash, at least GEAR_HASH_WINDOW_SIZE
+     * @param lane_span Positions hashed by each lane, a multiple of 64
+     * @param gear_table Table of 256 random values indexed by byte
+     * @param masks Masks to test the hashes against
+     * @param num_masks Number of masks, 1 or 2
+     * @param words One output array per mask, of lanes * lane_span / 64 words
      */
-    #ifdef __SSE3__
-        uint64_t range_scan_geq_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #ifdef SIMD_AVX256_KERNELS
+        void mark_gear_candidates_avx256(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *gear_table,
+                                         const uint64_t *masks, uint64_t num_masks, uint64_t **words);
     #endif
 
-    #ifdef __AVX2__
-        uint64_t range_scan_geq_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #if defined(SIMD_AVX512_KERNELS)
+        void mark_gear_candidates_avx512(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *gear_table,
+                                         const uint64_t *masks, uint64_t num_masks, uint64_t **words);
     #endif
 
-    #if defined(__AVX512F__)
-        uint64_t range_scan_geq_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
+    /**
+     * @brief Number of 64-bit lanes the gear kernel of simd_mode uses, 0 if it has none
+     * 
+     * @return uint64_t
+     */
+    uint64_t gear_lanes() const;
 
-    #if defined(__ARM_NEON)
-        uint64_t range_scan_geq_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
+    /**
+     * @brief Calls the gear kernel of simd_mode, see mark_gear_candidates_avx256
+     */
+    void mark_gear_candidates(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *gear_table,
+                              const uint64_t *masks, uint64_t num_masks, uint64_t **words);
 
-    #if defined(__ALTIVEC__)
-        uint64_t range_scan_geq_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
-    
     /**
-     * @brief Executes a range scan comparing bytes serially against the target value between <start_pos, end_pos> within the data stream *buff using SIMD instructions.
-     * Comparison operator: GT (>)
+     * @brief Marks the positions whose Rabin fingerprint over the window_size bytes ending there satisfies
+     * (fingerprint & mask) == 0, one 64-bit lane per span of positions, as mark_gear_candidates_avx256 does.
+     * Each lane first appends the window_size bytes preceding its span, so start must be at least window_size.
      * 
-     * @param buff Data Stream
-     * @param start_pos Starting position of scanned region
-     * @param end_pos Ending position of scanned region
-     * @param target_value Target value
-     * @return uint64_t Position of first matching candidate. 
-     * @return end_position if no match found
+     * @param buff Data being chunked
+     * @param start First position to mark
+     * @param lane_span Positions marked by each lane, a multiple of 64
+     * @param mod_table Table reducing the fingerprint modulo the polynomial
+     * @param out_table Table sliding a byte out of the window
+     * @param window_size Size of the window in bytes
+     * @param pol_shift Shift of the fingerprint giving the index in mod_table
+     * @param masks Masks to test the fingerprints against
+     * @param num_masks Number of masks, 1 or 2
+     * @param words One output array per mask, of rabin_lanes() * lane_span / 64 words
      */
-    #ifdef __SSE3__
-        uint64_t range_scan_gt_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #ifdef SIMD_AVX256_KERNELS
+        void mark_rabin_candidates_avx256(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *mod_table,
+                                          const uint64_t *out_table, uint64_t window_size, uint64_t pol_shift,
+                                          const uint64_t *masks, uint64_t num_masks, uint64_t **words);
     #endif
 
-    #ifdef __AVX2__
-        uint64_t range_scan_gt_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #if defined(SIMD_AVX512_KERNELS)
+        void mark_rabin_candidates_avx512(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *mod_table,
+                                          const uint64_t *out_table, uint64_t window_size, uint64_t pol_shift,
+                                          const uint64_t *masks, uint64_t num_masks, uint64_t **words);
     #endif
 
-    #if defined(__AVX512F__)
-        uint64_t range_scan_gt_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
+    /**
+     * @brief Number of 64-bit lanes the Rabin kernel of simd_mode uses, 0 if it has none
+     * 
+     * @return uint64_t
+     */
+    uint64_t rabin_lanes() const;
 
-    #if defined(__ARM_NEON)
-        uint64_t range_scan_gt_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    /**
+     * @brief Calls the Rabin kernel of simd_mode, see mark_rabin_candidates_avx256
+     */
+    void mark_rabin_candidates(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *mod_table,
+                               const uint64_t *out_table, uint64_t window_size, uint64_t pol_shift,
+                               const uint64_t *masks, uint64_t num_masks, uint64_t **words);
+
+    /**
+     * @brief Marks the positions whose SS-CDC CRC over the CRC_HASH_WINDOW_SIZE bytes ending there satisfies
+     * (hash & break_mask) == magic_number, one 32-bit lane per span of positions. Lane j marks the positions
+     * [start + j * lane_span, start + (j + 1) * lane_span) after hashing the window preceding them, so start must
+     * be at least CRC_HASH_WINDOW_SIZE. lane_span must be a multiple of 64, and lanes * lane_span below 2^31.
+     * 
+     * @param buff Data being chunked
+     * @param start First position to mark
+     * @param lane_span Number of positions marked by each lane
+     * @param crct Table appending a byte to the CRC
+     * @param crcu Table removing the byte leaving the window
+     * @param break_mask Bits of the CRC compared with magic_number
+     * @param magic_number Value marking a candidate
+     * @param words Output array of lanes * lane_span / 64 words
+     */
+    #ifdef SIMD_AVX256_KERNELS
+        void mark_crc_candidates_avx256(const char *buff, uint64_t start, uint64_t lane_span, const uint32_t *crct,
+                                        const uint32_t *crcu, uint32_t break_mask, uint32_t magic_number, uint64_t *words);
     #endif
 
-    #if defined(__ALTIVEC__)
-        uint64_t range_scan_gt_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #if defined(SIMD_AVX512_KERNELS)
+        void mark_crc_candidates_avx512(const char *buff, uint64_t start, uint64_t lane_span, const uint32_t *crct,
+                                        const uint32_t *crcu, uint32_t break_mask, uint32_t magic_number, uint64_t *words);
     #endif
 
-     /**
-     * @brief Executes a range scan comparing bytes serially against the target value between <start_pos, end_pos> within the data stream *buff using SIMD instructions.
-     * Comparison operator: LEQ (<=)
+    /**
+     * @brief Number of 32-bit lanes the CRC kernel of simd_mode uses, 0 if it has none
      * 
-     * @param buff Data Stream
-     * @param start_pos Starting position of scanned region
-     * @param end_pos Ending position of scanned region
-     * @param target_value Target value
-     * @return uint64_t Position of first matching candidate. 
-     * @return end_position if no match found
+     * @return uint64_t
      */
-    #ifdef __SSE3__
-        uint64_t range_scan_leq_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
+    uint64_t crc_lanes() const;
 
-    #ifdef __AVX2__
-        uint64_t range_scan_leq_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
+    /**
+     * @brief Calls the CRC kernel of simd_mode, see mark_crc_candidates_avx256
+     */
+    void mark_crc_candidates(const char *buff, uint64_t start, uint64_t lane_span, const uint32_t *crct,
+                             const uint32_t *crcu, uint32_t break_mask, uint32_t magic_number, uint64_t *words);
 
-    #if defined(__AVX512F__)
-        uint64_t range_scan_leq_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
+    /**
+     * @brief Number of 64-bit lanes of the multi-stream kernels of simd_mode, 0 if it has none
+     * 
+     * @return uint64_t
+     */
+    uint64_t stream_lanes() const;
 
-    #if defined(__ARM_NEON)
-        uint64_t range_scan_leq_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    /**
+     * @brief Advances the active lanes of a Gear or FastCDC multi-stream chunker in lockstep, one byte per
+     * lane and step, until at least one of them finds its cut-point. A lane hashes the positions from pos:
+     * a position before phase is a cut-point if (hash & mask_0) == 0, one at or after phase if (hash & mask_1) == 0.
+     * A lane reaching end without a match cuts at end.
+     * The data of every lane must be readable 8 bytes past end.
+     * 
+     * @param lanes State of the lanes, updated for the lanes still searching
+     * @param active Bit mask of the lanes to advance, not 0
+     * @param gear_table Table of 256 random values indexed by byte
+     * @param mask_0 Mask tested before phase
+     * @param mask_1 Mask tested from phase
+     * @return uint64_t Bit mask of the lanes whose cut-point is in lanes.cut
+     */
+    #ifdef SIMD_AVX256_KERNELS
+        uint64_t advance_gear_lanes_avx256(Stream_Lanes &lanes, uint64_t active, const uint64_t *gear_table,
+                                           uint64_t mask_0, uint64_t mask_1);
     #endif
 
-    #ifdef __ALTIVEC__
-        uint64_t range_scan_leq_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #if defined(SIMD_AVX512_KERNELS)
+        uint64_t advance_gear_lanes_avx512(Stream_Lanes &lanes, uint64_t active, const uint64_t *gear_table,
+                                           uint64_t mask_0, uint64_t mask_1);
     #endif
 
+    uint64_t advance_gear_lanes(Stream_Lanes &lanes, uint64_t active, const uint64_t *gear_table,
+                                uint64_t mask_0, uint64_t mask_1);
+
     /**
-     * @brief Executes a range scan comparing bytes serially against the target value between <start_pos, end_pos> within the data stream *buff using SIMD instructions.
-     * Comparison operator: LT (<)
+     * @brief Advances the active lanes of a Rabin multi-stream chunker in lockstep until at least one of
+     * them finds its cut-point. Each step slides the byte window_size positions back out of the fingerprint
+     * and appends the byte at pos, so every lane must be at least window_size bytes into its chunk.
+     * The position closing a chunk is a cut-point if it is at or after phase and (hash & mask) == 0,
+     * and the chunk then ends after it. A lane reaching end without a match cuts at end.
+     * The data of every lane must be readable 8 bytes past end.
      * 
-     * @param buff Data Stream
-     * @param start_pos Starting position of scanned region
-     * @param end_pos Ending position of scanned region
-     * @param target_value Target value
-     * @return uint64_t Position of first matching candidate. 
-     * @return end_position if no match found
+     * @param lanes State of the lanes, updated for the lanes still searching
+     * @param active Bit mask of the lanes to advance, not 0
+     * @param mod_table Table reducing the fingerprint modulo the polynomial
+     * @param out_table Table sliding a byte out of the window
+     * @param mask Fingerprint mask
+     * @param window_size Size of the window in bytes
+     * @param pol_shift Shift of the fingerprint giving the index in mod_table
+     * @return uint64_t Bit mask of the lanes whose cut-point is in lanes.cut
      */
-    #ifdef __SSE3__
-        uint64_t range_scan_lt_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #ifdef SIMD_AVX256_KERNELS
+        uint64_t advance_rabin_lanes_avx256(Stream_Lanes &lanes, uint64_t active, const uint64_t *mod_table,
+                                            const uint64_t *out_table, uint64_t mask, uint64_t window_size,
+                                            uint64_t pol_shift);
     #endif
 
-    #ifdef __AVX2__
-        uint64_t range_scan_lt_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #if defined(SIMD_AVX512_KERNELS)
+        uint64_t advance_rabin_lanes_avx512(Stream_Lanes &lanes, uint64_t active, const uint64_t *mod_table,
+                                            const uint64_t *out_table, uint64_t mask, uint64_t window_size,
+                                            uint64_t pol_shift);
     #endif
 
-    #if defined(__AVX512F__)
-        uint64_t range_scan_lt_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
-    #endif
+    uint64_t advance_rabin_lanes(Stream_Lanes &lanes, uint64_t active, const uint64_t *mod_table,
+                                 const uint64_t *out_table, uint64_t mask, uint64_t window_size,
+                                 uint64_t pol_shift);
 
-    #if defined(__ARM_NEON)
-        uint64_t range_scan_lt_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    /**
+     * @brief Searches the SeqCDC cut-point of buff from state, SEQ_SIMD_BLOCK_SIZE positions at a time. A block
+     * compares its bytes with the preceding ones into a mask of the slopes continuing the sequence and one of
+     * the opposing slopes, equal bytes being in neither. BMI2 then finds the first run of seq_length_threshold
+     * continuing slopes (pext drops the equal bytes) and the jump_trigger-th opposing slope (pdep), which skips
+     * jump_size bytes as in the scalar search. The kernel stops at the cut-point, or when less than a block
+     * is left before size with state ready for the scalar search to finish.
+     * seq_length_threshold and jump_trigger must be between 1 and 65535, and state.pos at least 1.
+     * 
+     * @param buff Data being chunked
+     * @param size Size of buff
+     * @param decreasing True to search decreasing sequences, false for increasing ones
+     * @param seq_length_threshold Length of the sequence ending a chunk
+     * @param jump_trigger Number of opposing slopes triggering a jump
+     * @param jump_size Number of bytes skipped by a jump
+     * @param state Search state, updated
+     * @return bool True if state.pos is the cut-point
+     */
+    #ifdef SIMD_AVX256_KERNELS
+        bool find_seq_cutpoint_avx256(const char *buff, uint64_t size, bool decreasing, uint64_t seq_length_threshold,
+                                      uint64_t jump_trigger, uint64_t jump_size, Seq_Scan_State &state);
     #endif
 
-    #ifdef __ALTIVEC__
-        uint64_t range_scan_lt_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value);
+    #if defined(SIMD_AVX512_KERNELS)
+        bool find_seq_cutpoint_avx512(const char *buff, uint64_t size, bool decreasing, uint64_t seq_length_threshold,
+                                      uint64_t jump_trigger, uint64_t jump_size, Seq_Scan_State &state);
     #endif
 
+    /**
+     * @brief Number of bytes the SeqCDC kernel of simd_mode compares per instruction, 0 if it has none
+     * 
+     * @return uint64_t
+     */
+    uint64_t seq_lanes() const;
+
+    /**
+     * @brief Calls the SeqCDC kernel of simd_mode, see find_seq_cutpoint_avx256
+     */
+    bool find_seq_cutpoint(const char *buff, uint64_t size, bool decreasing, uint64_t seq_length_threshold,
+                           uint64_t jump_trigger, uint64_t jump_size, Seq_Scan_State &state);
 
     /**
      * @brief Helper functions to compare 2 128-bit XMM registers
@@ -240,39 +410,39 @@ class AVX_Chunking_Technique: public virtual Chunking_Technique{
      * @param b Second XMM register containing 8-bit packed values
      * @return __m128i Result of bytewise comparison
      */
-    #ifdef __SSE3__
-        inline __m128i Greater8uSSE(__m128i a, __m128i b){
-        return _mm_andnot_si128(_mm_cmpeq_epi8(_mm_min_epu8(a, b), a), K_INV_ZERO);
+    #ifdef SIMD_SSE128_KERNELS
+        SIMD_TARGET_SSE128 inline __m128i Greater8uSSE(__m128i a, __m128i b){
+        return _mm_andnot_si128(_mm_cmpeq_epi8(_mm_min_epu8(a, b), a), _mm_set1_epi8((char)0xFF));
         }
 
-        inline __m128i GreaterOrEqual8uSSE(__m128i a, __m128i b){
+        SIMD_TARGET_SSE128 inline __m128i GreaterOrEqual8uSSE(__m128i a, __m128i b){
             return _mm_cmpeq_epi8(_mm_max_epu8(a, b), a);
         }
 
-        inline __m128i Lesser8uSSE(__m128i a, __m128i b){
-                return _mm_andnot_si128(_mm_cmpeq_epi8(_mm_max_epu8(a, b), a), K_INV_ZERO);
+        SIMD_TARGET_SSE128 inline __m128i Lesser8uSSE(__m128i a, __m128i b){
+                return _mm_andnot_si128(_mm_cmpeq_epi8(_mm_max_epu8(a, b), a), _mm_set1_epi8((char)0xFF));
         }
 
-        inline __m128i LesserOrEqual8uSSE(__m128i a, __m128i b){
+        SIMD_TARGET_SSE128 inline __m128i LesserOrEqual8uSSE(__m128i a, __m128i b){
                 return _mm_cmpeq_epi8(_mm_min_epu8(a, b), a);
         }
-        inline __m128i NotEqual8uSSE(__m128i a, __m128i b){
-                return _mm_andnot_si128(_mm_cmpeq_epi8(a, b), K_INV_ZERO);
+        SIMD_TARGET_SSE128 inline __m128i NotEqual8uSSE(__m128i a, __m128i b){
+                return _mm_andnot_si128(_mm_cmpeq_epi8(a, b), _mm_set1_epi8((char)0xFF));
         }
     #endif
 
-    #ifdef __AVX2__
-        inline __m256i Greater8uAVX256(__m256i a, __m256i b){
-        return _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a), K_INV_ZERO_256);
+    #ifdef SIMD_AVX256_KERNELS
+        SIMD_TARGET_AVX256 inline __m256i Greater8uAVX256(__m256i a, __m256i b){
+        return _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a), _mm256_set1_epi8((char)0xFF));
         }
-        inline __m256i Lesser8uAVX256(__m256i a, __m256i b){
-                return _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a), K_INV_ZERO_256);
+        SIMD_TARGET_AVX256 inline __m256i Lesser8uAVX256(__m256i a, __m256i b){
+                return _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a), _mm256_set1_epi8((char)0xFF));
         }
 
-        inline __m256i GreaterOrEqual8uAVX256(__m256i a, __m256i b){
+        SIMD_TARGET_AVX256 inline __m256i GreaterOrEqual8uAVX256(__m256i a, __m256i b){
             return _mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a);
         }
-        inline __m256i LesserOrEqual8uAVX256(__m256i a, __m256i b){
+        SIMD_TARGET_AVX256 inline __m256i LesserOrEqual8uAVX256(__m256i a, __m256i b){
             return _mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a);
         }
     #endif
@@ -282,8 +452,8 @@ class AVX_Chunking_Technique: public virtual Chunking_Technique{
     /**
      * @brief: Helper functions to print __m512i in human readable format for debugging
     */
-    #if defined(__AVX512F__)
-    inline void printm512i(__m512i entry){
+    #if defined(SIMD_AVX512_KERNELS)
+    SIMD_TARGET_AVX512 inline void printm512i(__m512i entry){
         // Print __m512i as 16 32-bit values
         uint32_t val[16];
         std::memcpy(val, &entry, sizeof(val));
@@ -293,7 +463,7 @@ class AVX_Chunking_Technique: public virtual Chunking_Technique{
         std::cout << std::endl;
     }
 
-     inline void printm512i_left(__m512i entry){
+     SIMD_TARGET_AVX512 inline void printm512i_left(__m512i entry){
         // Print leftmost 32-bit value from __m512i
 
         uint32_t val[16];
@@ -303,7 +473,7 @@ class AVX_Chunking_Technique: public virtual Chunking_Technique{
         std::cout << std::endl;
     }
 
-    inline void printm512i_left_byte(__m512i entry){
+    SIMD_TARGET_AVX512 inline void printm512i_left_byte(__m512i entry){
 
         // Print leftmost 8-bit value from __m512i
         
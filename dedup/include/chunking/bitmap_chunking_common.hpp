@@ -0,0 +1,116 @@
+/**
+ * @file bitmap_chunking_common.hpp
+ * @author WASL
+ * @brief Two-phase candidate bitmap framework shared by the rolling hash
+ * chunking techniques (Gear, FastCDC, Rabin, TTTD and CRC)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _BITMAP_CHUNKING_COMMON_
+#define _BITMAP_CHUNKING_COMMON_
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "chunking_common.hpp"
+#include "config.hpp"
+
+#define BITMAP_MAX_LEVELS 2
+#define BITMAP_WORD_BITS 64
+
+class Bitmap_Chunking_Technique : public virtual Chunking_Technique {
+    /**
+     * @brief Splits chunking into two phases. Phase 1 evaluates the rolling
+     * hash at every position of a large region and records the positions
+     * satisfying each boundary condition ("level") in a bitmap. Phase 1 has
+     * no dependency between positions beyond the hash window, so it can be
+     * split across threads. Phase 2 walks the bitmaps serially and applies
+     * the min/avg/max rules of the technique to select the cut-points.
+     *
+     * Phase 2 must return exactly what find_cutpoint would return for the
+     * same chunk, so the hashes written to the output file do not change.
+     */
+
+    protected:
+        bool candidate_bitmap_enabled = false;
+        uint64_t candidate_bitmap_threads = 1;
+        uint64_t candidate_bitmap_region_size = 16 * 1024 * 1024;
+        uint64_t candidate_levels = 1;
+
+        // One bit per byte of the current region, one bitmap per level
+        std::vector<uint64_t> candidate_bitmaps[BITMAP_MAX_LEVELS];
+
+        /**
+         * @brief Read the candidate bitmap parameters from the config file
+         * @param config: config object
+         * @param levels: number of boundary conditions evaluated in phase 1
+         * @return: void
+         */
+        void init_candidate_bitmap(const Config& config, uint64_t levels);
+
+        /**
+         * @brief Phase 1 kernel. Sets bit p of bitmaps[l] if the hash window
+         * ending at position p satisfies the boundary condition of level l.
+         * Positions closer to the start of the buffer than the window size
+         * have an incomplete window and are never consulted by phase 2.
+         * @param buff: the region being chunked
+         * @param start: first position to evaluate, a multiple of BITMAP_WORD_BITS
+         * @param end: one past the last position to evaluate
+         * @param bitmaps: one output bitmap per level
+         * @return: void
+         */
+        virtual void mark_candidates(const char* buff, uint64_t start,
+                                     uint64_t end, uint64_t** bitmaps) = 0;
+
+        /**
+         * @brief Phase 2. Finds the cut-point of the chunk beginning at
+         * buff + start using the candidate bitmaps
+         * @param buff: the region being chunked
+         * @param start: position of the first byte of the chunk in the region
+         * @param size: number of bytes find_cutpoint would be given
+         * @return: cutpoint position relative to start
+         */
+        virtual uint64_t find_cutpoint_bitmap(char* buff, uint64_t start,
+                                              uint64_t size) = 0;
+
+        /**
+         * @brief Position of the first candidate of a level in [from, to)
+         * @return: candidate position or to if there is none
+         */
+        uint64_t next_candidate(uint64_t level, uint64_t from, uint64_t to) const;
+
+        /**
+         * @brief Position of the last candidate of a level in [from, to)
+         * @return: candidate position or to if there is none
+         */
+        uint64_t last_candidate(uint64_t level, uint64_t from, uint64_t to) const;
+
+        /**
+         * @brief Runs phase 1 over a region, splitting the work between
+         * candidate_bitmap_threads threads
+         * @param buff: the region being chunked
+         * @param size: size of the region in bytes
+         * @return: void
+         */
+        void build_candidate_bitmaps(const char* buff, uint64_t size);
+
+    public:
+        /**
+         * @brief Chunk a stream in two phases when the candidate bitmap mode
+         * is enabled. Falls back to Chunking_Technique::chunk_stream otherwise
+         *
+         * @param stream: input stream containing the data to be chunked, positioned at the first byte to chunk
+         * @param length: number of bytes from the current position to the end of the stream
+         * @param chunk_limit: no chunk starting at or after this many bytes is created
+         * @return: number of bytes covered by the chunks created
+         */
+        uint64_t chunk_stream(std::vector<std::string>& hashes, std::istream& stream,
+                              uint64_t length, uint64_t chunk_limit) override;
+};
+
+#endif
@@ -19,10 +19,13 @@
 #include <istream>
 #include <cstdint>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 #include "hash.hpp"
 #include "config.hpp"
 #include "file_chunk.hpp"
+#include "fingerprint_index.hpp"
 #include "hashing_common.hpp"
 
 class Chunking_Technique{
@@ -32,19 +35,97 @@ class Chunking_Technique{
      */
 
     protected:
+        // Bytes emitted since the start of the current file or range
+        uint64_t emitted_bytes = 0;
+        // Chunks starting at or after this offset are not inserted into the fingerprint index.
+        // Set for byte ranges so the chunks in the overlap are only counted by the next range
+        uint64_t index_limit = UINT64_MAX;
+        // Bytes given to feed that are not in a chunk yet, and their offset in the stream
+        std::vector<char> feed_buffer;
+        uint64_t feed_offset = 0;
+
+        /**
+         * @brief Cut-point search of a chunk whose bytes arrive in pieces. buff holds the chunk from its first
+         * byte and the bytes received so far. If the cut-point is not among them and end_of_data is false,
+         * returns 0 and is called again once more bytes are added. The default waits for end_of_data and calls
+         * find_cutpoint once. Techniques that carry their scan state from one call to the next override it, so
+         * the search does not start over and the cut-points do not depend on the size of the pieces.
+         *
+         * @param buff: bytes of the chunk received so far
+         * @param size: number of bytes in buff, at most chunk_size_limit()
+         * @param end_of_data: no byte is added to the chunk after these
+         * @return: size of the chunk, 0 if more bytes are needed
+         */
+        virtual uint64_t resume_cutpoint(char* buff, uint64_t size, bool end_of_data);
+
+        /**
+         * @brief Drops the scan state of the chunk in progress, before chunking a new stream
+         */
+        virtual void reset_scan() {}
+
+        /**
+         * @brief Times find_cutpoints for the bytes of the stream in buff
+         * @param buff: bytes of the stream from the start of the chunk in progress
+         * @param size: number of bytes in buff
+         * @param end_of_stream: no byte follows buff in the stream
+         * @param cuts: the ends of the chunks completed in buff are appended to it
+         * @return: start of the chunk in progress, size if there is none
+         */
+        uint64_t next_cutpoints(char* buff, uint64_t size, bool end_of_stream, std::vector<uint64_t>& cuts);
+
+        /**
+         * @brief Loop of find_cutpoints, cutting the chunks of buff one after the other
+         * @param resume: called like resume_cutpoint with each chunk, at most chunk_size_limit() bytes of it
+         * and whether these are all its bytes. Techniques pass a search without virtual calls, selected once
+         * for the whole buffer
+         */
+        template <class Resume>
+        uint64_t cut_chunks(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts,
+                            Resume resume) {
+            uint64_t limit = chunk_size_limit();
+            uint64_t chunk_start = 0;
+            while (chunk_start < size) {
+                uint64_t available = std::min(size - chunk_start, limit);
+                uint64_t chunk_size = resume(buff + chunk_start, available, end_of_data || available == limit);
+                if (chunk_size == 0) {
+                    break;
+                }
+                chunk_start += chunk_size;
+                cuts.push_back(chunk_start);
+            }
+            return chunk_start;
+        }
+
+        /**
+         * @brief cut_chunks for a search that needs all the bytes of the chunk, given like find_cutpoint.
+         * As the default resume_cutpoint, the chunk in progress waits for them
+         */
+        template <class Search>
+        uint64_t cut_whole_chunks(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts,
+                                  Search search) {
+            return cut_chunks(buff, size, end_of_data, cuts,
+                              [&search](char* chunk, uint64_t chunk_size, bool complete) -> uint64_t {
+                                  return complete ? search(chunk, chunk_size) : 0;
+                              });
+        }
+
         /**
-         * @brief a helper function to create a chunk from a data buffer
-         * @param file_chunks: chunks vector
-         * @param data: the data buffer
-         * @param buffer_end: the logical size of the buffer in bytes
-         * @return: size of the chunk
+         * @brief a helper function to hash and record a chunk whose boundary is already known
+         * @param hashes: hashes vector
+         * @param data: pointer to the first byte of the chunk
+         * @param chunk_size: size of the chunk in bytes
+         * @return: void
          */
-        int64_t create_chunk(std::vector<std::string>& hashes, char* data, uint64_t buffer_end);
-        
+        void emit_chunk(std::vector<std::string>& hashes, char* data, uint64_t chunk_size);
+
     public:
         std::string technique_name;
         std::unique_ptr<Hashing_Technique> hash_method;
-        uint64_t stream_buffer_size;
+        // Optional index shared with other processes, every hashed chunk is inserted into it
+        std::unique_ptr<Fingerprint_Index> fingerprint_index;
+        // Bytes read from a stream at a time, 0 for 1 MiB. Does not limit the chunks of techniques with a
+        // maximum chunk size
+        uint64_t stream_buffer_size = 0;
         std::chrono::duration<double, std::milli> total_time_chunking =
         std::chrono::duration<double, std::milli>::zero();
         std::chrono::duration<double, std::milli> total_time_hashing =
@@ -64,6 +145,68 @@ class Chunking_Technique{
             return 0;
         }
 
+        /**
+         * @brief Finds the cut-points of all the chunks completed in a buffer in one call. The scan state of
+         * the chunk in progress at the end of buff is kept, and the next call starts with that chunk.
+         * 
+         * @param buff: bytes of the stream from the start of a chunk
+         * @param size: number of bytes in buff
+         * @param end_of_data: no byte follows buff in the stream, so the last bytes are a chunk too
+         * @param cuts: the ends of the chunks, as offsets in buff, are appended to it
+         * @return: uint64_t start of the chunk in progress, size if there is none
+         */
+        virtual uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts);
+
+        /**
+         * @brief Check whether the technique has kernels for a SIMD mode that run on this CPU
+         * 
+         * @param mode: SIMD mode
+         * @return: bool
+         */
+        virtual bool supports_simd_mode(SIMD_Mode mode) const {
+            return mode == SIMD_Mode::NONE;
+        }
+
+        /**
+         * @brief Maximum chunk size of the technique
+         * 
+         * @return: uint64_t, 0 if the technique has none
+         */
+        virtual uint64_t get_max_block_size() const {
+            return 0;
+        }
+
+        /**
+         * @brief Largest chunk created from a stream: the maximum chunk size of the technique, or the stream
+         * buffer size if it is larger. Chunks of techniques without a maximum are cut at the buffer size.
+         * 
+         * @return: uint64_t
+         */
+        uint64_t chunk_size_limit() const;
+
+        /**
+         * @brief Starts chunking a stream given piece by piece to feed
+         */
+        void begin_feed();
+
+        /**
+         * @brief Chunks the next bytes of the stream started with begin_feed. The bytes of the chunk in
+         * progress are kept with its scan state until its cut-point is found, so the pieces may have any size
+         * and the boundaries are those of chunk_stream.
+         * 
+         * @param data: next bytes of the stream
+         * @param length: number of bytes in data
+         * @return: offsets from the start of the stream of the ends of the chunks completed
+         */
+        std::vector<uint64_t> feed(const char* data, uint64_t length);
+
+        /**
+         * @brief Ends the stream started with begin_feed and cuts the bytes left into chunks
+         * 
+         * @return: offsets of the ends of the remaining chunks, the last one is the end of the stream
+         */
+        std::vector<uint64_t> end_feed();
+
         /**
          * @brief calculates the size of the given file
          * 
@@ -79,14 +222,55 @@ class Chunking_Technique{
          * @return: Vector of struct File_Chunk
          */
         std::vector<std::string> chunk_file(std::string file_path);
+
+        /**
+         * @brief Chunk a batch of files. Gives the chunks of chunk_file for every file, techniques with a
+         * multi-stream kernel chunk the files of the batch together
+         * 
+         * @param file_paths: Paths of the files to chunk
+         * @return: Chunk hashes of every file, in the order of file_paths
+         */
+        virtual std::vector<std::vector<std::string>> chunk_files(const std::vector<std::string>& file_paths);
+
+        /**
+         * @brief Chunk the byte range <start, end> of a file. The first chunk starts at start and chunking
+         * continues past end until a chunk would start at or after end + overlap, so that the chunks of the
+         * next range can be resynchronized with these ones. Chunks see the rest of the file exactly as
+         * chunk_file would, so once both agree on a boundary all following chunks are identical.
+         *
+         * @param file_path: String containing path to file
+         * @param start: Offset of the first byte of the range
+         * @param end: Offset one past the last byte of the range
+         * @param overlap: Number of bytes past end in which chunks may still start
+         * @return: Vector of chunk hashes
+         */
+        std::vector<std::string> chunk_file_range(std::string file_path, uint64_t start, uint64_t end, uint64_t overlap);
+
+        /**
+         * @brief Chunk a file from offset start, which must be a chunk boundary, until a chunk would start at
+         * or after start + limit. Chunking the rest of the file from the returned offset gives the same chunks
+         * as chunk_file.
+         *
+         * @param file_path: String containing path to file
+         * @param start: Offset of the first byte to chunk
+         * @param limit: Number of bytes after start in which chunks may start
+         * @param hashes: Vector the chunk hashes are appended to
+         * @return: Offset of the end of the last chunk created
+         */
+        uint64_t chunk_file_segment(std::string file_path, uint64_t start, uint64_t limit, std::vector<std::string>& hashes);
+
         /**
          * @brief Chunk a stream using a chunking technique and append the struct File_Chunks from this operation
-         * to the vector passed in
+         * to the vector passed in. The stream is read stream_buffer_size bytes at a time, find_cutpoints cuts
+         * the chunks completed in the buffer and the chunk in progress keeps growing until its cut-point is
+         * found or it reaches chunk_size_limit().
          * 
-         * @param stream: input stream containing the data to be chunked
-         * @return: void
+         * @param stream: input stream containing the data to be chunked, positioned at the first byte to chunk
+         * @param length: number of bytes from the current position to the end of the stream
+         * @param chunk_limit: no chunk starting at or after this many bytes is created
+         * @return: number of bytes covered by the chunks created
          */
-        virtual void chunk_stream(std::vector<std::string>& hashes, std::istream& stream);
+        virtual uint64_t chunk_stream(std::vector<std::string>& hashes, std::istream& stream, uint64_t length, uint64_t chunk_limit);
 
         virtual ~Chunking_Technique() {};
 
@@ -99,4 +283,26 @@ class Chunking_Technique{
         static std::unique_ptr<std::istream> read_file_to_buffer(std::string file_path);
 };
 
+/**
+ * @brief Returns the lookup table of a technique for a parameter, such as its window size. The table is built
+ * by build the first time the parameter is requested in the process, then shared read-only by every instance
+ * and thread. Tables are never freed, so the pointer stays valid.
+ *
+ * @param key: the parameter the table depends on
+ * @param build: fills a default-constructed Table for key
+ * @return: const Table*
+ */
+template <class Table, class Build>
+const Table* shared_table(uint64_t key, Build build){
+    static std::mutex tables_mutex;
+    static std::map<uint64_t, std::unique_ptr<Table>> tables;
+    std::lock_guard<std::mutex> lock(tables_mutex);
+    std::unique_ptr<Table>& table = tables[key];
+    if(!table){
+        table = std::make_unique<Table>();
+        build(*table);
+    }
+    return table.get();
+}
+
 #endif
\ No newline at end of file
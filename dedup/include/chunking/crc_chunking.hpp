@@ -7,17 +7,25 @@
 #include <algorithm>
 
 #include "avx_chunking_common.hpp"
+#include "bitmap_chunking_common.hpp"
 #include "config.hpp"
 
 #include <cstring>
 
+#if defined(SIMD_CRC32C_KERNELS) && !defined(SIMD_X86_KERNELS)
+    #include <arm_acle.h>
+#endif
+
 #define DEFAULT_SS_CRC_AVG_BLOCK_SIZE 4096
 
+// crcu removes the byte leaving a window of this many bytes
+#define SS_CRC_TABLE_WINDOW_SIZE 256
+
 #define vector_idx(table,idx) \
 	((__v16si)table)[idx]
 
 
-static const uint32_t crct[256] __attribute__ ((aligned(16))) =
+alignas(64) inline constexpr uint32_t crct[256] =
 {
     0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,
     0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
@@ -53,7 +61,7 @@ static const uint32_t crct[256] __attribute__ ((aligned(16))) =
     0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
 };
 
-    static const uint32_t crcu[256] =
+alignas(64) inline constexpr uint32_t crcu[256] =
 {
     0x00000000,0xce3371cb,0x4717e5d7,0x8924941c,0x8e2fcbae,0x401cba65,0xc9382e79,0x070b5fb2,
     0xc72e911d,0x091de0d6,0x803974ca,0x4e0a0501,0x49015ab3,0x87322b78,0x0e16bf64,0xc025ceaf,
@@ -89,9 +97,31 @@ static const uint32_t crct[256] __attribute__ ((aligned(16))) =
     0x73694326,0xbd5a32ed,0x347ea6f1,0xfa4dd73a,0xfd468888,0x3375f943,0xba516d5f,0x74621c94,
 };
 
+// CRC32C polynomial (Castagnoli), bit-reflected
+#define CRC32C_POLYNOMIAL 0x82F63B78
+
+// A CRC32C table. The rolling hash is kept without the conditioning of crc32c::ExtendPortable
+struct alignas(64) CRC32C_Table {
+    uint32_t table[256];
+};
+
+// Extends the hash by a byte, the same as the CRC32C instruction. Built at compile time
+constexpr CRC32C_Table make_crc32c_hash_table(){
+    CRC32C_Table hash_table{};
+    for(uint32_t b = 0; b < 256; b++){
+        uint32_t crc = b;
+        for(int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+        hash_table.table[b] = crc;
+    }
+    return hash_table;
+}
+
+inline constexpr CRC32C_Table CRC32C_HASH_TABLE = make_crc32c_hash_table();
+
 static const uint32_t ss_crc_magic_number = 0;
 
-class SS_CRC_Chunking : public virtual AVX_Chunking_Technique{
+class SS_CRC_Chunking : public virtual AVX_Chunking_Technique, public virtual Bitmap_Chunking_Technique{
     private:
         uint64_t avg_block_size;
         uint64_t max_block_size;
@@ -101,11 +131,40 @@ class SS_CRC_Chunking : public virtual AVX_Chunking_Technique{
 
         uint64_t total_size_chunked;
 
-        std::vector<uint64_t> boundary_candidates_vector;
-        uint8_t *boundary_candidates_bitmask;
+        // True if the hash at a position only depends on the window ending there,
+        // as the candidate bitmap and its SIMD kernels require
+        bool window_hash;
+
+        CRC_Polynomial polynomial;
+        // CRC32C is computed with the CRC32C instruction when the CPU has it
+        bool crc32c_hardware;
+
+        // hash_table extends the hash by a byte, out_table removes the byte
+        // leaving the window. crct and crcu for CRC32, CRC32C_HASH_TABLE and
+        // the table of the window size from crc32c_out_table for CRC32C
+        const uint32_t* hash_table;
+        const uint32_t* out_table;
+
+        /**
+         * @brief returns the CRC32C table removing the byte leaving a window of
+         * window_size bytes, built once per window size and shared by every instance
+         */
+        static const uint32_t* crc32c_out_table(uint64_t window_size);
+
+        /**
+         * @brief extends the hash by the bytes of [start, end)
+         * @return: the extended hash
+         */
+        uint32_t extend_hash(uint32_t hash, const char* buff, uint64_t start, uint64_t end) const;
+
+        /**
+         * @brief rolls the window over [start, end) until the hash matches the
+         * magic number, start must be at least window_size
+         * @param hash: hash of the window ending before start, updated in place
+         * @return: position of the match, end if there is none
+         */
+        uint64_t roll_hash(const char* buff, uint64_t start, uint64_t end, uint32_t& hash) const;
 
-        
-   
         /**
          * @brief finds the next cut point in an array of bytes
          * @param buff: the buff to find the cutpoint in.
@@ -116,6 +175,33 @@ class SS_CRC_Chunking : public virtual AVX_Chunking_Technique{
 
         uint64_t find_cutpoint_native(char* buff, uint64_t size);
 
+        /**
+         * @brief finds the cut points of a buffer with find_cutpoint_native, waiting for whole chunks
+         */
+        uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+
+        /**
+         * @brief marks the positions whose window CRC matches the magic number
+         * @param buff: the region being chunked
+         * @param start: first position to evaluate
+         * @param end: one past the last position to evaluate
+         * @param bitmaps: output candidate bitmap
+         */
+        void mark_candidates(const char* buff, uint64_t start, uint64_t end,
+                             uint64_t** bitmaps) override;
+
+        void mark_candidates_native(const char* buff, uint64_t start, uint64_t end,
+                                    uint64_t** bitmaps);
+
+        /**
+         * @brief finds the next cut point using the candidate bitmap
+         * @param buff: the region being chunked
+         * @param start: position of the chunk in the region
+         * @param size: the size of the buffer find_cutpoint would be given
+         * @return: cutpoint position relative to start
+         */
+        uint64_t find_cutpoint_bitmap(char* buff, uint64_t start, uint64_t size) override;
+
     public:
         SS_CRC_Chunking();
 
@@ -123,6 +209,19 @@ class SS_CRC_Chunking : public virtual AVX_Chunking_Technique{
 
         ~SS_CRC_Chunking();
 
+        /**
+         * @brief Checks whether the CPU supports a SIMD mode with a CRC kernel (avx256 or avx512)
+         * @param mode: SIMD mode
+         * @return: bool
+         */
+        bool supports_simd_mode(SIMD_Mode mode) const override;
+
+        /**
+         * @brief Maximum chunk size of the technique
+         * @return: uint64_t
+         */
+        uint64_t get_max_block_size() const override;
+
 };
 
 #endif
\ No newline at end of file
@@ -1,16 +1,28 @@
 #ifndef _FastCDC_CHUNKING_
 #define _FastCDC_CHUNKING_
 
+#include "avx_chunking_common.hpp"
+#include "multi_stream_chunking.hpp"
+#include "bitmap_chunking_common.hpp"
 #include "chunking_common.hpp"
 #include "config.hpp"
 
-class FastCDC : public virtual Chunking_Technique {
+#include <type_traits>
+
+// Number of bytes contributing to a gear hash: older bytes are shifted out
+#define FASTCDC_WINDOW_SIZE 64
+
+// Candidate bitmap levels: positions matching the small and the large mask
+#define FASTCDC_SMALL_MASK_LEVEL 0
+#define FASTCDC_LARGE_MASK_LEVEL 1
+
+class FastCDC : public virtual Multi_Stream_Chunking_Technique, public virtual Bitmap_Chunking_Technique {
     /**
      * @brief Class implementing gear's based chunking
      *
      */
 
-   private:
+   protected:
     uint64_t min_block_size;
     uint64_t max_block_size;
     uint64_t avg_block_size;
@@ -27,6 +39,74 @@ class FastCDC : public virtual Chunking_Technique {
      */
     uint64_t find_cutpoint(char* buff, uint64_t size) override;
 
+    uint64_t find_cutpoint_native(char* buff, uint64_t size);
+
+    /**
+     * @brief native search with the average size and masks passed as
+     * arguments: uint64_t values, or std::integral_constant to compile them
+     * as immediates
+     */
+    template <class Avg_Size, class Small_Mask, class Large_Mask>
+    uint64_t find_cutpoint_native(char* buff, uint64_t size, Avg_Size avg_size,
+                                  Small_Mask small, Large_Mask large);
+
+    /**
+     * @brief hashes the positions [i, length) until one is a cut point,
+     * skipping the runs of equal bytes found by find_run
+     * @param first_phase: first position tested with the large mask
+     * @param fp: the hash of the positions before i
+     * @param small, large: the masks, as in find_cutpoint_native
+     * @return: the cut point, length if there is none
+     */
+    template <class Small_Mask, class Large_Mask>
+    uint64_t hash_until_cutpoint(const char* data, uint64_t i, uint64_t length,
+                                 uint64_t first_phase, uint64_t fp,
+                                 Small_Mask small, Large_Mask large);
+
+    /**
+     * @brief finds the next cut point hashing blocks of positions with the
+     * gear kernel of simd_mode. Returns the same cut point as find_cutpoint_native
+     */
+    uint64_t find_cutpoint_simd(char* buff, uint64_t size);
+
+    /**
+     * @brief finds the cut points of a buffer with the search of simd_mode, selected once for the buffer
+     */
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+
+    /**
+     * @brief marks the positions whose gear hash satisfies the small and
+     * the large masks
+     * @param buff: the region being chunked
+     * @param start: first position to evaluate
+     * @param end: one past the last position to evaluate
+     * @param bitmaps: output candidate bitmaps, one per mask
+     * @return: void
+     */
+    void mark_candidates(const char* buff, uint64_t start, uint64_t end,
+                         uint64_t** bitmaps) override;
+
+    void mark_candidates_native(const char* buff, uint64_t start, uint64_t end,
+                                uint64_t** bitmaps);
+
+    /**
+     * @brief finds the next cut point using the candidate bitmaps
+     * @param buff: the region being chunked
+     * @param start: position of the chunk in the region
+     * @param size: the size of the buffer find_cutpoint would be given
+     * @return: cutpoint position relative to start
+     */
+    uint64_t find_cutpoint_bitmap(char* buff, uint64_t start, uint64_t size) override;
+
+    /**
+     * @brief prepares a lane of the multi-stream kernel for the chunk at chunk_start
+     * @return: false if the chunk ends before the first position hashed
+     */
+    bool begin_lane(uint64_t lane, const char* data, uint64_t chunk_start, uint64_t size,
+                    uint64_t& cut) override;
+
+    uint64_t advance_lanes(uint64_t active) override;
+
     static constexpr uint64_t GEAR_TABLE[256] = {
         0x651748f5a15f8222, 0xd6eda276c877d8ea, 0x66896ef9591b326b,
         0xcd97506b21370a12, 0x8c9c5c9acbeb2a05, 0xb8b9553ee17665ef,
@@ -129,6 +209,48 @@ class FastCDC : public virtual Chunking_Technique {
     FastCDC(const Config& config);
 
     ~FastCDC();
+
+    /**
+     * @brief Checks whether the CPU supports a SIMD mode with a gear kernel (avx256 or avx512)
+     * @param mode: SIMD mode
+     * @return: bool
+     */
+    bool supports_simd_mode(SIMD_Mode mode) const override;
+
+    /**
+     * @brief Maximum chunk size of the technique
+     * @return: uint64_t
+     */
+    uint64_t get_max_block_size() const override;
+};
+
+/**
+ * @brief FastCDC with a power of two average size and a normalization level
+ * fixed at compile time, so the native search tests immediate masks. The
+ * driver creates it for the common sizes when simd_mode is none.
+ */
+template <uint64_t AVG_BLOCK_SIZE, uint64_t NORMALIZATION_LEVEL>
+class FastCDC_Specialized : public FastCDC {
+    static_assert((AVG_BLOCK_SIZE & (AVG_BLOCK_SIZE - 1)) == 0, "AVG_BLOCK_SIZE must be a power of two");
+    static constexpr int MASK_BITS = __builtin_ctzll(AVG_BLOCK_SIZE);
+    using Avg_Size = std::integral_constant<uint64_t, AVG_BLOCK_SIZE>;
+    using Small_Mask = std::integral_constant<uint64_t, (1ULL << (MASK_BITS + NORMALIZATION_LEVEL)) - 1>;
+    using Large_Mask = std::integral_constant<uint64_t, (1ULL << (MASK_BITS - NORMALIZATION_LEVEL)) - 1>;
+
+    uint64_t find_cutpoint(char* buff, uint64_t size) override;
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+
+   public:
+    using FastCDC::FastCDC;
 };
 
+// Average sizes and normalization levels instantiated in fastcdc.cpp
+#define FOR_EACH_FASTCDC_SPECIALIZATION(X) \
+    X(4096, 0) X(4096, 1) X(4096, 2) X(4096, 3) \
+    X(8192, 0) X(8192, 1) X(8192, 2) X(8192, 3) \
+    X(16384, 0) X(16384, 1) X(16384, 2) X(16384, 3)
+#define EXTERN_FASTCDC_SPECIALIZATION(AVG_BLOCK_SIZE, NORMALIZATION_LEVEL) \
+    extern template class FastCDC_Specialized<AVG_BLOCK_SIZE, NORMALIZATION_LEVEL>;
+FOR_EACH_FASTCDC_SPECIALIZATION(EXTERN_FASTCDC_SPECIALIZATION)
+
 #endif
\ No newline at end of file
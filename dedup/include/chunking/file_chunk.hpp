@@ -65,6 +65,13 @@ class File_Chunk {
          */
         BYTE* get_hash() const;
 
+        /**
+         * @brief Get the size of the hash of the chunk in bytes, 0 if the chunk has not been hashed
+         * 
+         * @return unsigned int 
+         */
+        unsigned int get_hash_size() const;
+
         /**
          * @brief Returns the hash and size of the chunk as a string
          * 
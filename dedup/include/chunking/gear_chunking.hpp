@@ -1,10 +1,16 @@
 #ifndef _Gear_CHUNKING_
 #define _Gear_CHUNKING_
 
+#include "avx_chunking_common.hpp"
+#include "multi_stream_chunking.hpp"
+#include "bitmap_chunking_common.hpp"
 #include "chunking_common.hpp"
 #include "config.hpp"
 
-class Gear_Chunking : public virtual Chunking_Technique {
+// Number of bytes contributing to a gear hash: older bytes are shifted out
+#define GEAR_WINDOW_SIZE 64
+
+class Gear_Chunking : public virtual Multi_Stream_Chunking_Technique, public virtual Bitmap_Chunking_Technique {
     /**
      * @brief Class implementing gear's based chunking
      *
@@ -15,7 +21,8 @@ class Gear_Chunking : public virtual Chunking_Technique {
     uint64_t max_block_size;
     uint64_t avg_block_size;
     uint64_t mask;
-
+    // Next position to hash of the chunk resume_cutpoint is searching, 0 if none
+    uint64_t scan_pos = 0;
 
 
     const uint64_t GEAR_TABLE[256] = {
@@ -123,6 +130,83 @@ class Gear_Chunking : public virtual Chunking_Technique {
      */
     uint64_t find_cutpoint(char* buff, uint64_t size) override;
 
+    /**
+     * @brief continues the search of find_cutpoint from scan_pos as the chunk grows
+     * @return: the cut point, 0 if more bytes are needed
+     */
+    uint64_t resume_cutpoint(char* buff, uint64_t size, bool end_of_data) override;
+
+    void reset_scan() override;
+
+    /**
+     * @brief finds the cut points of a buffer, resuming the search of each chunk without virtual calls
+     */
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+
+    /**
+     * @brief finds the cut point among the positions [idx, end) of a chunk
+     * @param idx: first position to hash, set to where hashing stopped
+     * @param finish: hash every position, otherwise the kernel may leave
+     * the positions after its last whole block for a later call
+     * @return: the cut point, end if there is none before idx
+     */
+    uint64_t search_cutpoint(const char* buff, uint64_t& idx, uint64_t end, bool finish);
+
+    uint64_t find_cutpoint_native(const char* buff, uint64_t& idx, uint64_t end);
+
+    /**
+     * @brief calculates the hash of the positions before idx from the bytes
+     * still in its window, as hashing them from the minimum chunk size would
+     * @return: the hash
+     */
+    uint64_t hash_window(const char* data, uint64_t idx);
+
+    /**
+     * @brief hashes the positions [idx, end) until one is a cut point,
+     * skipping the runs of equal bytes found by find_run
+     * @param hash: the hash of the positions before idx
+     * @return: the cut point, or where hashing stopped if there is none
+     */
+    uint64_t hash_until_cutpoint(const char* data, uint64_t idx, uint64_t end, uint64_t hash);
+
+    /**
+     * @brief finds the next cut point hashing blocks of positions with the
+     * gear kernel of simd_mode. Returns the same cut point as find_cutpoint_native
+     */
+    uint64_t find_cutpoint_simd(const char* buff, uint64_t& idx, uint64_t end, bool finish);
+
+    /**
+     * @brief marks the positions whose gear hash satisfies the mask
+     * @param buff: the region being chunked
+     * @param start: first position to evaluate
+     * @param end: one past the last position to evaluate
+     * @param bitmaps: output candidate bitmap
+     * @return: void
+     */
+    void mark_candidates(const char* buff, uint64_t start, uint64_t end,
+                         uint64_t** bitmaps) override;
+
+    void mark_candidates_native(const char* buff, uint64_t start, uint64_t end,
+                                uint64_t** bitmaps);
+
+    /**
+     * @brief finds the next cut point using the candidate bitmap
+     * @param buff: the region being chunked
+     * @param start: position of the chunk in the region
+     * @param size: the size of the buffer find_cutpoint would be given
+     * @return: cutpoint position relative to start
+     */
+    uint64_t find_cutpoint_bitmap(char* buff, uint64_t start, uint64_t size) override;
+
+    /**
+     * @brief prepares a lane of the multi-stream kernel for the chunk at chunk_start
+     * @return: false if the chunk ends before the first position hashed
+     */
+    bool begin_lane(uint64_t lane, const char* data, uint64_t chunk_start, uint64_t size,
+                    uint64_t& cut) override;
+
+    uint64_t advance_lanes(uint64_t active) override;
+
 
    public:
     /**
@@ -143,6 +227,19 @@ class Gear_Chunking : public virtual Chunking_Technique {
      * @return A vector of File_Chuncks
      */
     std::vector<File_Chunk> chunk_file(std::string file_path);
+
+    /**
+     * @brief Checks whether the CPU supports a SIMD mode with a gear kernel (avx256 or avx512)
+     * @param mode: SIMD mode
+     * @return: bool
+     */
+    bool supports_simd_mode(SIMD_Mode mode) const override;
+
+    /**
+     * @brief Maximum chunk size of the technique
+     * @return: uint64_t
+     */
+    uint64_t get_max_block_size() const override;
 };
 
 #endif
\ No newline at end of file
@@ -14,30 +14,11 @@
 #define DEFAULT_MAXP_MAX_BLOCK_SIZE 65536
 
 class MAXP_Chunking : public virtual AVX_Chunking_Technique {
-   private:
+   protected:
     uint64_t max_block_size;
     uint64_t window_size;
 
-    #ifdef __SSE3__
-    __m128i *xmm_array;
-    #endif
-
-    #ifdef __AVX2__
-    __m256i *ymm_array;
-    #endif
     
-    #if defined(__AVX512F__)
-    __m512i *zmm_array;
-    #endif
-
-    #if defined(__ARM_NEON)
-    uint8x16_t *neon_array;
-    #endif
-
-    #ifdef __ALTIVEC__
-    __vector unsigned char *altivec_array;
-    #endif
-
     /**
      * @brief finds the next cut point in an array of bytes
      * @param buff: the buff to find the cutpoint in.
@@ -47,25 +28,31 @@ class MAXP_Chunking : public virtual AVX_Chunking_Technique {
     uint64_t find_cutpoint(char* buff, uint64_t size) override;
     uint64_t find_cutpoint_native(char *buff, uint64_t size);
     
-    #ifdef __SSE3__
-    uint64_t find_cutpoint_sse128(char *buff, uint64_t size);
-    #endif
+    /**
+     * @brief finds the next cut point with the range scans of a SIMD vector type, see simd_kernels.hpp.
+     * No_Slide_Vector types search with find_cutpoint_noslide
+     */
+    template <class Vector>
+    uint64_t find_cutpoint_simd(char *buff, uint64_t size);
 
-    #ifdef __AVX2__
-    uint64_t find_cutpoint_avx256(char *buff, uint64_t size);
-    #endif
-    
-    #if defined(__AVX512F__)
-    uint64_t find_cutpoint_avx512(char *buff, uint64_t size);
-    #endif
+    /**
+     * @brief search of the no-slide modes: the maximum of the whole window after the current maximum is found
+     * with find_extremum, and the search jumps to its first position instead of sliding through the values
+     * between them. Gives the same cut points as find_cutpoint_simd
+     */
+    template <class Vector>
+    uint64_t find_cutpoint_noslide(char *buff, uint64_t size);
 
-    #if defined(__ARM_NEON)
-    uint64_t find_cutpoint_neon(char *buff, uint64_t size);
-    #endif
+    /**
+     * @brief finds the cut points of a buffer with the search of simd_mode, selected once for the buffer
+     */
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
 
-    #ifdef __ALTIVEC__
-    uint64_t find_cutpoint_altivec(char *buff, uint64_t size);
-    #endif
+    /**
+     * @brief finds the cut points of a buffer with the search of a vector type, or the native search for void
+     */
+    template <class Vector>
+    uint64_t find_cutpoints_for(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts);
 
    public:
     /**
@@ -81,8 +68,37 @@ class MAXP_Chunking : public virtual AVX_Chunking_Technique {
      */
     MAXP_Chunking(const Config& config);
 
-    ~MAXP_Chunking();
+    /**
+     * @brief Checks whether the CPU supports a SIMD mode and its kernels can scan the window
+     * @param mode: SIMD mode
+     * @return: bool
+     */
+    bool supports_simd_mode(SIMD_Mode mode) const override;
+
+    /**
+     * @brief Maximum chunk size of the technique
+     * @return: uint64_t
+     */
+    uint64_t get_max_block_size() const override;
+
+};
+
+/**
+ * @brief MAXP chunking with the search fixed at compile time: the vector type of its SIMD mode, void for the
+ * native search
+ */
+template <class Vector>
+class MAXP_Chunking_Specialized : public MAXP_Chunking {
+    uint64_t find_cutpoint(char* buff, uint64_t size) override;
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
 
+   public:
+    using MAXP_Chunking::MAXP_Chunking;
 };
 
+// Instantiated in maxp_chunking.cpp for the native search and each vector type of the binary
+#define EXTERN_MAXP_CHUNKING_SPECIALIZATION(VECTOR) extern template class MAXP_Chunking_Specialized<VECTOR>;
+EXTERN_MAXP_CHUNKING_SPECIALIZATION(void)
+FOR_EACH_SIMD_VECTOR(EXTERN_MAXP_CHUNKING_SPECIALIZATION)
+
 #endif
\ No newline at end of file
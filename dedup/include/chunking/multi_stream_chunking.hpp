@@ -0,0 +1,68 @@
+/**
+ * @file multi_stream_chunking.hpp
+ * @author WASL
+ * @brief Chunking of several files at once, one file per SIMD lane
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _MULTI_STREAM_CHUNKING_
+#define _MULTI_STREAM_CHUNKING_
+
+#include <string>
+#include <vector>
+
+#include "avx_chunking_common.hpp"
+#include "chunking_common.hpp"
+
+// Bytes readable past the end of every file, the kernels load 8 bytes per lane at a time
+#define STREAM_DATA_PADDING 8
+
+class Multi_Stream_Chunking_Technique : public virtual AVX_Chunking_Technique {
+    /**
+     * @brief Interface for chunking techniques whose hash only depends on the current chunk. Each lane of
+     * the multi-stream kernel of simd_mode chunks a different file, so a single cut-point search keeps the
+     * lanes busy without splitting it. A lane moves on to the next file of the batch when its file is done.
+     * Chunks are exactly those of chunk_file, and chunk_size_limit() caps them the same way.
+     */
+
+    protected:
+        // State of the streams, one per lane
+        Stream_Lanes stream_state;
+
+        /**
+         * @brief Prepares a lane for the chunk starting at chunk_start, hashing serially what the kernel
+         * cannot. Returns false if the cut-point was found serially.
+         *
+         * @param lane: lane to prepare, its data address is already set
+         * @param data: data of the file chunked by the lane
+         * @param chunk_start: offset of the chunk in data
+         * @param size: number of bytes find_cutpoint would be given
+         * @param cut: offset in data of the end of the chunk, if found serially
+         * @return: true if the lane must be advanced by the kernel
+         */
+        virtual bool begin_lane(uint64_t lane, const char* data, uint64_t chunk_start, uint64_t size,
+                                uint64_t& cut) = 0;
+
+        /**
+         * @brief Runs the multi-stream kernel of the technique on stream_state
+         *
+         * @param active: bit mask of the lanes to advance
+         * @return: bit mask of the lanes whose cut-point is in stream_state.cut
+         */
+        virtual uint64_t advance_lanes(uint64_t active) = 0;
+
+    public:
+        /**
+         * @brief Chunk a batch of files, interleaving them across the lanes of the multi-stream kernel.
+         * Falls back to chunking the files one by one if simd_mode has no multi-stream kernel.
+         *
+         * @param file_paths: paths of the files to chunk
+         * @return: chunk hashes of every file, in the order of file_paths
+         */
+        std::vector<std::vector<std::string>> chunk_files(const std::vector<std::string>& file_paths) override;
+};
+
+#endif
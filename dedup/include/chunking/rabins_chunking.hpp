@@ -7,6 +7,8 @@
 #include <cstring>
 #include <fstream>
 
+#include "bitmap_chunking_common.hpp"
+#include "multi_stream_chunking.hpp"
 #include "chunking_common.hpp"
 #include "config.hpp"
 #include "rabins_hashing.hpp"
@@ -20,7 +22,70 @@
 #define POLYNOMIAL_DEGREE 53
 #define POL_SHIFT (POLYNOMIAL_DEGREE - 8)
 
-class Rabins_Chunking : public virtual Chunking_Technique {
+/**
+ * @brief calculates the degree of the polynomial p, -1 for 0
+ */
+constexpr int rabin_deg(uint64_t p) {
+    return p ? 63 - __builtin_clzll(p) : -1;
+}
+
+/**
+ * @brief calculates the remainder of x divided by the polynomial p
+ */
+constexpr uint64_t rabin_mod(uint64_t x, uint64_t p) {
+    while (rabin_deg(x) >= rabin_deg(p)) {
+        x ^= p << (rabin_deg(x) - rabin_deg(p));
+    }
+    return x;
+}
+
+/**
+ * @brief appends byte b to the hash using polynomial pol
+ */
+constexpr uint64_t rabin_append_byte(uint64_t hash, uint8_t b, uint64_t pol) {
+    return rabin_mod((hash << 8) | b, pol);
+}
+
+// Tables of the fingerprint that only depend on POLYNOMIAL, built at compile time
+struct alignas(64) Rabin_Polynomial_Tables {
+    // mod_table[b] = A | B, where A = (b(x) * x^k mod pol) and B = b(x) * x^k, k = deg(POLYNOMIAL)
+    //
+    // The 8 bits above deg(Polynomial) determine what happens next and so
+    // these bits are used as a lookup to this table. The value is split in
+    // two parts: Part A contains the result of the modulus operation, part
+    // B is used to cancel out the 8 top bits so that one XOR operation is
+    // enough to reduce modulo Polynomial
+    uint64_t mod_table[256];
+
+    // Appending 32 bits shifts the top 32 bits of the hash above deg(Polynomial).
+    // append_tables[j][b] = b(x) * x^(k + 8j) mod pol reduces byte j of them,
+    // counted from the lowest, so four lookups replace four dependent appends
+    // (slicing-by-4).
+    uint64_t append_tables[4][256];
+};
+
+constexpr Rabin_Polynomial_Tables make_rabin_polynomial_tables() {
+    Rabin_Polynomial_Tables tables{};
+    int k = rabin_deg(POLYNOMIAL);
+    for (int b = 0; b < 256; b++) {
+        tables.mod_table[b] = rabin_mod(((uint64_t)b) << k, POLYNOMIAL) | ((uint64_t)b) << k;
+        tables.append_tables[0][b] = rabin_mod(((uint64_t)b) << k, POLYNOMIAL);
+        for (int j = 1; j < 4; j++) {
+            tables.append_tables[j][b] = rabin_append_byte(tables.append_tables[j - 1][b], 0, POLYNOMIAL);
+        }
+    }
+    return tables;
+}
+
+inline constexpr Rabin_Polynomial_Tables RABIN_POLYNOMIAL_TABLES = make_rabin_polynomial_tables();
+
+// Table sliding a byte out of a window, which depends on the window size. Built once per window size
+// in the process and shared, see rabin_init
+struct alignas(64) Rabin_Window_Table {
+    uint64_t out_table[256];
+};
+
+class Rabins_Chunking : public virtual Multi_Stream_Chunking_Technique, public virtual Bitmap_Chunking_Technique {
     /**
      * @brief Class implementing rabin's based chunking
      *
@@ -32,21 +97,26 @@ class Rabins_Chunking : public virtual Chunking_Technique {
     uint64_t min_block_size;
     uint64_t fingerprint_mask;
 
+    // Circular buffer of the last window_size bytes, rounded up to a power of two
     uint8_t *window;
+    uint64_t window_mask;
     unsigned int wpos;
     unsigned int count;
     unsigned int pos;
     unsigned int start;
     uint64_t digest;
     uint64_t window_size;
+    // Next position to evaluate of the chunk resume_cutpoint is searching, 0 if none
+    uint64_t scan_pos = 0;
 
-    bool tables_initialized = false;
-    uint64_t mod_table[256];
-    uint64_t out_table[256];
+    // Lookup tables shared by every instance, see Rabin_Polynomial_Tables and Rabin_Window_Table
+    static constexpr const uint64_t *mod_table = RABIN_POLYNOMIAL_TABLES.mod_table;
+    static constexpr const uint64_t (*append_tables)[256] = RABIN_POLYNOMIAL_TABLES.append_tables;
+    const uint64_t *out_table;
 
 
     /**
-     * @brief initialize rabin chunking algorithm
+     * @brief initialize rabin chunking algorithm, attaching the out table of window_size
      */
     void rabin_init(void);
 
@@ -71,30 +141,100 @@ class Rabins_Chunking : public virtual Chunking_Technique {
      */
     uint64_t find_cutpoint(char *buf,uint64_t len);
 
+    /**
+     * @brief continues the search of find_cutpoint as the chunk grows, from the digest
+     * of the bytes slid in or from scan_pos
+     * @return: the index after the chunk boundry relative to the buffer, 0 if more bytes are needed
+     */
+    uint64_t resume_cutpoint(char *buf, uint64_t len, bool end_of_data) override;
+
+    void reset_scan() override;
+
+    /**
+     * @brief finds the cut points of a buffer, resuming the search of each chunk without virtual calls
+     */
+    uint64_t find_cutpoints(char *buf, uint64_t len, bool end_of_data, std::vector<uint64_t> &cuts) override;
+
+    /**
+     * @brief finds the next chunk boundary by sliding every byte from the reset state,
+     * used when the minimum chunk size is below the window size. Starts after the count
+     * bytes slid in by an earlier call for the same chunk
+     * @param end_of_data: no byte follows buf[len - 1], otherwise 0 is returned if no
+     * boundary is found and the digest is kept for the next call
+     * @return: the index after the chunk boundry relative to the buffer
+     */
+    uint64_t find_cutpoint_sliding(char *buf, uint64_t len, bool end_of_data);
+
+    /**
+     * @brief finds the first position in [idx, limit) whose window fingerprint satisfies
+     * the mask, skipping to the window preceding it. Returns the same cut point as
+     * find_cutpoint_sliding. idx must be at least window_size - 1
+     * @param idx: first position to evaluate, set to where the search stopped
+     * @return: that position, limit if there is none
+     */
+    uint64_t find_cutpoint_native(const char *buf, uint64_t &idx, uint64_t limit);
 
     /**
-     * @brief calculates the mod of x to p
-     * @return: mod of x to p
+     * @brief finds the first position like find_cutpoint_native, fingerprinting blocks
+     * of positions with the Rabin kernel of simd_mode
+     * @param finish: evaluate every position, otherwise the kernel may leave the positions
+     * after its last whole block for a later call
+     * @return: that position, limit if there is none before idx
      */
-    uint64_t mod(uint64_t x, uint64_t p);
+    uint64_t find_cutpoint_simd(const char *buf, uint64_t &idx, uint64_t limit, bool finish);
 
     /**
-     * @brief calculates the degree of the polynomyal p
-     * @return: the degree of the polynomyal
+     * @brief finds the first position in [first, limit) whose window fingerprint
+     * satisfies the mask, skipping the runs of equal bytes found by find_run.
+     * first must be at least window_size - 1
+     * @return: that position, limit if there is none
      */
-    int deg(uint64_t p);
+    uint64_t find_window_cutpoint(const char *buf, uint64_t first, uint64_t limit);
 
     /**
-     * @brief appends byte b to the hash using polynomyal pol
-     * @return: the new hash
+     * @brief calculates the fingerprint of the window_size bytes at buf, 4 bytes at a time
+     * @return: the fingerprint
      */
-    uint64_t append_byte(uint64_t hash, uint8_t b, uint64_t pol);
+    uint64_t fingerprint_window(const char *buf);
 
     /**
-     * @brief initlize mod tables 
+     * @brief marks the positions whose window fingerprint satisfies each of
+     * the given masks. Uses local state only, so it is safe to call from
+     * several threads at once
+     * @param buff: the region being chunked
+     * @param start: first position to evaluate
+     * @param end: one past the last position to evaluate
+     * @param masks: one fingerprint mask per level
+     * @param levels: number of masks
+     * @param bitmaps: output candidate bitmaps, one per mask
      * @return: void
      */
-    void calc_tables(void);
+    void mark_window_candidates(const char *buff, uint64_t start, uint64_t end,
+                                const uint64_t *masks, uint64_t levels,
+                                uint64_t **bitmaps);
+
+    /**
+     * @brief marks the positions whose window fingerprint satisfies the mask
+     */
+    void mark_candidates(const char *buff, uint64_t start, uint64_t end,
+                         uint64_t **bitmaps) override;
+
+    /**
+     * @brief finds the next chunk boundary using the candidate bitmap
+     * @return: the index after the chunk boundry relative to start
+     */
+    uint64_t find_cutpoint_bitmap(char *buff, uint64_t start, uint64_t len) override;
+
+    /**
+     * @brief prepares a lane of the multi-stream kernel for the chunk at chunk_start,
+     * sliding the first window serially
+     * @return: false if the chunk ends within the first window
+     */
+    bool begin_lane(uint64_t lane, const char *data, uint64_t chunk_start, uint64_t len,
+                    uint64_t &cut) override;
+
+    uint64_t advance_lanes(uint64_t active) override;
+
 
    public:
     /**
@@ -115,6 +255,19 @@ class Rabins_Chunking : public virtual Chunking_Technique {
      */
     ~Rabins_Chunking();
 
+    /**
+     * @brief Checks whether the CPU supports a SIMD mode with Rabin kernels (avx256 or avx512)
+     * @param mode: SIMD mode
+     * @return: bool
+     */
+    bool supports_simd_mode(SIMD_Mode mode) const override;
+
+    /**
+     * @brief Maximum chunk size of the technique
+     * @return: uint64_t
+     */
+    uint64_t get_max_block_size() const override;
+
 };
 
 #endif
@@ -12,49 +12,43 @@
 #define DEFAULT_RAM_AVG_BLOCK_SIZE 4096
 
 class RAM_Chunking : public virtual AVX_Chunking_Technique {
-   private:
+   protected:
     uint64_t avg_block_size;
     uint64_t max_block_size;
     uint64_t window_size;
     uint64_t curr_pos;
 
-    #ifdef __SSE3__
-      __m128i *sse_array;
-    #endif
-
-    #ifdef __AVX2__
-      __m256i *avx256_array;
-    #endif
-
-    #if defined(__AVX512F__)
-      __m512i *avx512_array;
-    #endif
-
-    #ifdef __ARM_NEON
-      uint8x16_t *neon_array;
-    #endif
-
-    #ifdef __ALTIVEC__
-      __vector unsigned char *altivec_array;
-    #endif
-
     /**
      * @brief finds the next cut point in an array of bytes
      * @param buff: the buff to find the cutpoint in.
      * @param size: the size of the buffer
      * @return: cutpoint position in the buffer 
      */
-    uint64_t find_cutpoint(char* buff, uint64_t size);
+    uint64_t find_cutpoint(char* buff, uint64_t size) override;
+    uint64_t find_cutpoint_native(char* buff, uint64_t size);
+
+    /**
+     * @brief finds the next cut point with the range scan of a SIMD vector type (see simd_kernels.hpp): the
+     * first position after the window with a value >= the maximum of the window. No_Slide_Vector types find
+     * that maximum with find_extremum instead of block summaries
+     * @param buff: the buff to find the cutpoint in.
+     * @param size: the size of the buffer
+     * @return: cutpoint position in the buffer
+     */
+    template <class Vector>
+    uint64_t find_cutpoint_simd(char* buff, uint64_t size);
+
+    /**
+     * @brief finds the cut points of a buffer with the search of simd_mode, selected once for the buffer
+     */
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
 
     /**
-     * @brief Get the return position (chunk boundary) for RAM using SSE128 instructions. This is the first position after start_position with a value > max_val.
-     * 
-     * @param buff Buffer
-     * @param start_position Starting position of scan within buffer
-     * @param max_value Max value within fixed size window
-     * @return uint64_t Return position in stream
+     * @brief finds the cut points of a buffer with the search of a vector type, or the native search for void
      */
-    
+    template <class Vector>
+    uint64_t find_cutpoints_for(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts);
+
    public:
     /**
      * @brief Default constructor.
@@ -69,8 +63,37 @@ class RAM_Chunking : public virtual AVX_Chunking_Technique {
      */
     RAM_Chunking(const Config& config);
 
-    ~RAM_Chunking();
+    /**
+     * @brief Checks whether the CPU supports a SIMD mode
+     * @param mode: SIMD mode
+     * @return: bool
+     */
+    bool supports_simd_mode(SIMD_Mode mode) const override;
+
+    /**
+     * @brief Maximum chunk size of the technique
+     * @return: uint64_t
+     */
+    uint64_t get_max_block_size() const override;
+
+};
+
+/**
+ * @brief RAM chunking with the search fixed at compile time: the vector type of its SIMD mode, void for the
+ * native search
+ */
+template <class Vector>
+class RAM_Chunking_Specialized : public RAM_Chunking {
+    uint64_t find_cutpoint(char* buff, uint64_t size) override;
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
 
+   public:
+    using RAM_Chunking::RAM_Chunking;
 };
 
+// Instantiated in ram_chunking.cpp for the native search and each vector type of the binary
+#define EXTERN_RAM_CHUNKING_SPECIALIZATION(VECTOR) extern template class RAM_Chunking_Specialized<VECTOR>;
+EXTERN_RAM_CHUNKING_SPECIALIZATION(void)
+FOR_EACH_SIMD_VECTOR(EXTERN_RAM_CHUNKING_SPECIALIZATION)
+
 #endif
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <math.h>
 #include <iostream>
 
-#include "chunking_common.hpp"
+#include "avx_chunking_common.hpp"
 #include "config.hpp"
 
 #include <cstring>
@@ -21,7 +21,7 @@
 #define DEFAULT_SEQ_OP_MODE INCREASING;
 
 
-class Seq_Chunking : public virtual Chunking_Technique {
+class Seq_Chunking : public virtual AVX_Chunking_Technique {
    private:
     uint64_t seq_length_threshold;
     uint64_t jump_trigger;
@@ -32,6 +32,10 @@ class Seq_Chunking : public virtual Chunking_Technique {
     uint64_t min_block_size;
     uint64_t avg_block_size;
     uint64_t max_block_size;
+
+    // Search of the chunk resume_cutpoint is continuing, valid if scan_active
+    Seq_Scan_State scan_state = {};
+    bool scan_active = false;
    
     /**
      * @brief finds the next cut point in an array of bytes
@@ -40,8 +44,38 @@ class Seq_Chunking : public virtual Chunking_Technique {
      * @return: cutpoint position in the buffer 
      */
     uint64_t find_cutpoint(char* buff, uint64_t size) override;
-    uint64_t find_cutpoint_decreasing(char *buff, uint64_t size);
-    uint64_t find_cutpoint_increasing(char *buff, uint64_t size);
+
+    /**
+     * @brief continues the search of find_cutpoint from scan_state as the chunk grows
+     * @return: cutpoint position in the buffer, 0 if more bytes are needed
+     */
+    uint64_t resume_cutpoint(char* buff, uint64_t size, bool end_of_data) override;
+
+    void reset_scan() override;
+
+    /**
+     * @brief finds the cut points of a buffer, resuming the search of each chunk without virtual calls
+     */
+    uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+
+    /**
+     * @brief searches up to size from state, which is left where the search stopped if
+     * there is no cut-point
+     * @return: cutpoint position in the buffer, size if there is none
+     */
+    uint64_t search_cutpoint(char* buff, uint64_t size, Seq_Scan_State &state);
+
+    /**
+     * @brief scalar search, from the position and counts of state
+     */
+    uint64_t find_cutpoint_decreasing(char *buff, uint64_t size, Seq_Scan_State &state);
+    uint64_t find_cutpoint_increasing(char *buff, uint64_t size, Seq_Scan_State &state);
+
+    /**
+     * @brief searches with the SeqCDC kernel of simd_mode, and finishes the
+     * last bytes with the scalar search
+     */
+    uint64_t find_cutpoint_simd(char* buff, uint64_t size, Seq_Scan_State &state);
 
    public:
     /**
@@ -59,6 +93,19 @@ class Seq_Chunking : public virtual Chunking_Technique {
 
     ~Seq_Chunking();
 
+    /**
+     * @brief Checks whether the CPU supports a SIMD mode with a SeqCDC kernel (avx256 or avx512, with BMI2)
+     * @param mode: SIMD mode
+     * @return: bool
+     */
+    bool supports_simd_mode(SIMD_Mode mode) const override;
+
+    /**
+     * @brief Maximum chunk size of the technique
+     * @return: uint64_t
+     */
+    uint64_t get_max_block_size() const override;
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+/**
+ * @file simd_dispatch.hpp
+ * @author WASL
+ * @brief Selects which SIMD kernels are compiled and which of them the CPU
+ * running the binary supports
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SIMD_DISPATCH_
+#define _SIMD_DISPATCH_
+
+#include <functional>
+
+#include "config.hpp"
+
+/**
+ * On x86, the SSE128, AVX256 and AVX512 kernels are always compiled. Each
+ * kernel is compiled for its own instruction set with a target attribute, so
+ * the rest of the binary runs on any x86-64 CPU. The kernel used is chosen
+ * at startup from simd_mode, after checking that the CPU supports it.
+ *
+ * NEON and AltiVec kernels are still selected by the compiler flags.
+ *
+ * The CRC32C instruction (SSE4.2 on x86, the CRC extension on ARMv8) is
+ * used by CRC chunking independently of simd_mode.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+    #define SIMD_X86_KERNELS
+    #define SIMD_SSE128_KERNELS
+    #define SIMD_AVX256_KERNELS
+    #define SIMD_AVX512_KERNELS
+    #define SIMD_TARGET_SSE128 __attribute__((target("sse,sse2,sse3,ssse3,sse4.1")))
+    #define SIMD_TARGET_AVX256 __attribute__((target("avx,avx2")))
+    #define SIMD_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx512bw")))
+    // Kernels that also process their comparison masks with BMI2
+    #define SIMD_TARGET_AVX256_BMI2 __attribute__((target("avx,avx2,bmi,bmi2,popcnt")))
+    #define SIMD_TARGET_AVX512_BMI2 __attribute__((target("avx512f,avx512vl,avx512bw,bmi,bmi2,popcnt")))
+    #define SIMD_TARGET_BMI2 __attribute__((target("bmi,bmi2,popcnt")))
+    #define SIMD_CRC32C_KERNELS
+    #define SIMD_TARGET_CRC32C __attribute__((target("sse4.2")))
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+    #define SIMD_CRC32C_KERNELS
+    #define SIMD_TARGET_CRC32C
+#endif
+
+#if defined(__ARM_NEON)
+    #define SIMD_NEON_KERNELS
+    #define SIMD_TARGET_NEON
+#endif
+
+#if defined(__ALTIVEC__)
+    #define SIMD_ALTIVEC_KERNELS
+    #define SIMD_TARGET_ALTIVEC
+#endif
+
+/**
+ * @brief Check whether the kernels of a SIMD mode are compiled into this
+ * binary and supported by the CPU running it
+ *
+ * @param mode: SIMD mode to check
+ * @return bool
+ */
+bool simd_mode_supported(SIMD_Mode mode);
+
+/**
+ * @brief Check whether the CRC32C instruction is compiled into this binary
+ * and supported by the CPU running it
+ *
+ * @return bool
+ */
+bool crc32c_hardware_supported();
+
+/**
+ * @brief Check whether the CPU running the binary supports BMI2, used with
+ * the avx256 and avx512 kernels of SeqCDC
+ *
+ * @return bool
+ */
+bool bmi2_supported();
+
+/**
+ * @brief Get the widest SIMD mode supported by this binary and CPU
+ *
+ * @return SIMD_Mode
+ */
+SIMD_Mode best_simd_mode();
+
+/**
+ * @brief Get the widest SIMD mode for which supported returns true, the mode
+ * simd_mode=auto selects for a chunking technique. The no-slide modes are
+ * never selected.
+ *
+ * @param supported: whether the technique has kernels for a mode that run on
+ * this CPU
+ * @return SIMD_Mode, NONE if no mode is supported
+ */
+SIMD_Mode best_simd_mode(const std::function<bool(SIMD_Mode)>& supported);
+
+/**
+ * @brief Get the name of a SIMD mode as written in config files
+ *
+ * @param mode: SIMD mode
+ * @return const char*
+ */
+const char* simd_mode_name(SIMD_Mode mode);
+
+#endif
@@ -0,0 +1,586 @@
+/**
+ * @file simd_kernels.hpp
+ * @author WASL
+ * @brief Byte kernels of the extreme-value chunkers, written once over the vector type of each SIMD mode
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SIMD_KERNELS_
+#define _SIMD_KERNELS_
+
+#include "simd_dispatch.hpp"
+
+#if defined(SIMD_X86_KERNELS)
+    #include <x86intrin.h>
+#elif defined(SIMD_NEON_KERNELS)
+    #include <arm_neon.h>
+#elif defined(SIMD_ALTIVEC_KERNELS)
+    #include <altivec.h>
+    #undef vector // Avoid conflict with std::vector
+    #undef bool // Avoid conflict with std::bool
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+// Independent registers the find_extremum kernels accumulate into
+#define EXTREMA_ACCUMULATORS 4
+
+// Bytes summarized by each entry of Block_Extrema
+#define EXTREMA_BLOCK_SIZE 64
+
+// Bytes of the blocks the run detector checks for a single repeated value. Every run of at least
+// 2 * RUN_SKIP_BLOCK_SIZE - 1 equal bytes covers one of them.
+#define RUN_SKIP_BLOCK_SIZE 128
+
+// The generic kernels are inlined into the entry points of a vector type, which are compiled for its instruction set
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+/**
+ * @brief Comparison of a range scan with its target value: GEQ (>=), GT (>), LEQ (<=), LT (<) or NEQ (!=)
+ */
+enum class Scan_Op { GEQ, GT, LEQ, LT, NEQ };
+
+/**
+ * Each SIMD mode has a vector type: a struct of static members describing its registers.
+ *   type, BYTES              register type and its width in bytes
+ *   MASK_BITS_PER_BYTE       bits per byte of a comparison mask, byte i setting bit MASK_BITS_PER_BYTE * i
+ *   MASKED_LOADS             load_partial reads only the requested bytes, so tails are not compared twice
+ *   load(v, p)                  unaligned load of BYTES bytes into v
+ *   load_partial(v, p, n, fill) load of n < BYTES bytes into v, its other bytes set to fill
+ *   set1(v, value)              byte broadcast into v
+ *   max(a, b), min(a, b)        unsigned byte maximum / minimum of a and b, stored in a
+ *   horizontal_max/min(v)       maximum / minimum byte of a register
+ *   compare<OP>(data, t)        mask of the bytes of data comparing with t as OP
+ * The members take registers by reference and return none: the kernels below are compiled without the
+ * instruction set of the registers, where passing them by value would change the calling convention.
+ *
+ * The kernels below are written once over these members. SIMD_VECTOR_KERNELS adds them to a vector type as
+ * static members compiled for its instruction set, so supporting another register width or instruction set
+ * only takes its vector type, and another comparison only takes a case in each compare.
+ */
+
+template <class Vector>
+SIMD_INLINE uint64_t first_match(uint64_t cmp_mask){
+    return __builtin_ctzll(cmp_mask) / Vector::MASK_BITS_PER_BYTE;
+}
+
+/**
+ * @brief Finds the first position in <start_position, end_position> whose byte compares as OP with target_value.
+ * The region may have any alignment and length. Without masked loads, the last register of the region is
+ * compared again and the positions already compared are dropped. Regions shorter than a register are loaded
+ * with load_partial, so no byte outside the region is read.
+ * @return end_position if no byte matches
+ */
+template <class Vector, Scan_Op OP>
+SIMD_INLINE uint64_t simd_range_scan(const char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
+    constexpr uint64_t BYTES = Vector::BYTES;
+    typename Vector::type target, data;
+    Vector::set1(target, target_value);
+    uint64_t pos = start_position;
+    for(; pos + BYTES <= end_position; pos += BYTES){
+        Vector::load(data, buff + pos);
+        uint64_t cmp_mask = Vector::template compare<OP>(data, target);
+        if(cmp_mask)
+            return pos + first_match<Vector>(cmp_mask);
+    }
+
+    uint64_t tail = end_position - pos;
+    if(tail == 0)
+        return end_position;
+    uint64_t cmp_mask;
+    if(!Vector::MASKED_LOADS && end_position - start_position >= BYTES){
+        Vector::load(data, buff + end_position - BYTES);
+        cmp_mask = Vector::template compare<OP>(data, target);
+        cmp_mask >>= Vector::MASK_BITS_PER_BYTE * (BYTES - tail);
+    }
+    else {
+        Vector::load_partial(data, buff + pos, tail, 0);
+        cmp_mask = Vector::template compare<OP>(data, target);
+        cmp_mask &= ((uint64_t)1 << (Vector::MASK_BITS_PER_BYTE * tail)) - 1;
+    }
+    return cmp_mask ? pos + first_match<Vector>(cmp_mask) : end_position;
+}
+
+// Stores the maximum (MAXIMUM) or minimum of acc and v in acc
+template <class Vector, bool MAXIMUM>
+SIMD_INLINE void simd_combine(typename Vector::type &acc, const typename Vector::type &v){
+    if constexpr (MAXIMUM)
+        Vector::max(acc, v);
+    else
+        Vector::min(acc, v);
+}
+
+/**
+ * @brief Finds the maximum (MAXIMUM) or minimum byte in <start_pos, end_pos>. EXTREMA_ACCUMULATORS independent
+ * registers accumulate the data, so consecutive loads do not wait on each other, and are reduced once at the
+ * end. The bytes after the last complete register are covered by one more load ending at end_pos, comparing a
+ * byte twice does not change the result, or by a masked load.
+ */
+template <class Vector, bool MAXIMUM>
+SIMD_INLINE uint8_t simd_find_extremum(const char *buff, uint64_t start_pos, uint64_t end_pos){
+    using type = typename Vector::type;
+    constexpr uint64_t BYTES = Vector::BYTES;
+    constexpr uint8_t NEUTRAL = MAXIMUM ? 0 : UINT8_MAX;
+    const char *data = buff + start_pos;
+    uint64_t length = end_pos - start_pos;
+    uint64_t num_vectors = length / BYTES;
+    if(num_vectors == 0)
+    {
+        type partial;
+        Vector::load_partial(partial, data, length, NEUTRAL);
+        return MAXIMUM ? Vector::horizontal_max(partial) : Vector::horizontal_min(partial);
+    }
+
+    type acc[EXTREMA_ACCUMULATORS];
+    for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++)
+        Vector::load(acc[j], data);
+
+    uint64_t i = 0;
+    for(; i + EXTREMA_ACCUMULATORS <= num_vectors; i += EXTREMA_ACCUMULATORS){
+        for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++){
+            type v;
+            Vector::load(v, data + (i + j) * BYTES);
+            simd_combine<Vector, MAXIMUM>(acc[j], v);
+        }
+    }
+    for(; i < num_vectors; i++){
+        type v;
+        Vector::load(v, data + i * BYTES);
+        simd_combine<Vector, MAXIMUM>(acc[0], v);
+    }
+
+    uint64_t tail = length % BYTES;
+    if(tail != 0){
+        type last;
+        if(Vector::MASKED_LOADS)
+            Vector::load_partial(last, data + num_vectors * BYTES, tail, NEUTRAL);
+        else
+            Vector::load(last, buff + end_pos - BYTES);
+        simd_combine<Vector, MAXIMUM>(acc[0], last);
+    }
+    for(uint64_t j = 1; j < EXTREMA_ACCUMULATORS; j++)
+        simd_combine<Vector, MAXIMUM>(acc[0], acc[j]);
+    return MAXIMUM ? Vector::horizontal_max(acc[0]) : Vector::horizontal_min(acc[0]);
+}
+
+/**
+ * @brief Finds the first of the RUN_SKIP_BLOCK_SIZE-byte blocks at start, start + RUN_SKIP_BLOCK_SIZE, ... ending
+ * before end whose bytes are all equal
+ * @return end if there is none
+ */
+template <class Vector>
+SIMD_INLINE uint64_t simd_find_uniform_block(const char *buff, uint64_t start, uint64_t end){
+    typename Vector::type value, data;
+    for(uint64_t block = start; block + RUN_SKIP_BLOCK_SIZE <= end; block += RUN_SKIP_BLOCK_SIZE){
+        Vector::set1(value, (uint8_t)buff[block]);
+        uint64_t cmp_mask = 0;
+        for(uint64_t i = 0; i < RUN_SKIP_BLOCK_SIZE; i += Vector::BYTES){
+            Vector::load(data, buff + block + i);
+            cmp_mask |= Vector::template compare<Scan_Op::NEQ>(data, value);
+        }
+        if(!cmp_mask)
+            return block;
+    }
+    return end;
+}
+
+/**
+ * @brief Stores the maximum and minimum byte of each EXTREMA_BLOCK_SIZE-byte block in [first_block, end_block),
+ * indexed by block, reading each block once for both
+ */
+template <class Vector>
+SIMD_INLINE void simd_summarize_blocks(const char *buff, uint64_t first_block, uint64_t end_block, uint8_t *max, uint8_t *min){
+    using type = typename Vector::type;
+    for(uint64_t block = first_block; block < end_block; block++){
+        const char *data = buff + block * EXTREMA_BLOCK_SIZE;
+        type block_max, block_min;
+        Vector::load(block_max, data);
+        block_min = block_max;
+        for(uint64_t i = Vector::BYTES; i < EXTREMA_BLOCK_SIZE; i += Vector::BYTES){
+            type v;
+            Vector::load(v, data + i);
+            Vector::max(block_max, v);
+            Vector::min(block_min, v);
+        }
+        max[block] = Vector::horizontal_max(block_max);
+        min[block] = Vector::horizontal_min(block_min);
+    }
+}
+
+// Entry points of a vector type, the kernels above compiled for its instruction set
+#define SIMD_VECTOR_KERNELS(TARGET, VECTOR) \
+    template <Scan_Op OP> \
+    TARGET static uint64_t range_scan(const char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){ \
+        return simd_range_scan<VECTOR, OP>(buff, start_position, end_position, target_value); \
+    } \
+    template <bool MAXIMUM> \
+    TARGET static uint8_t find_extremum(const char *buff, uint64_t start_pos, uint64_t end_pos){ \
+        return simd_find_extremum<VECTOR, MAXIMUM>(buff, start_pos, end_pos); \
+    } \
+    TARGET static void summarize_blocks(const char *buff, uint64_t first_block, uint64_t end_block, uint8_t *max, uint8_t *min){ \
+        simd_summarize_blocks<VECTOR>(buff, first_block, end_block, max, min); \
+    } \
+    TARGET static uint64_t find_uniform_block(const char *buff, uint64_t start, uint64_t end){ \
+        return simd_find_uniform_block<VECTOR>(buff, start, end); \
+    }
+
+#if defined(SIMD_X86_KERNELS)
+// Predicate of the AVX-512 mask compares for a comparison. The SSE128 and AVX256 compares only use them when
+// the whole binary is built with the AVX-512 flags (make simd512_all).
+inline constexpr int scan_predicate(Scan_Op op){
+    return op == Scan_Op::GEQ ? _MM_CMPINT_NLT : op == Scan_Op::GT ? _MM_CMPINT_NLE :
+           op == Scan_Op::LEQ ? _MM_CMPINT_LE : op == Scan_Op::LT ? _MM_CMPINT_LT : _MM_CMPINT_NE;
+}
+#endif
+
+#if defined(SIMD_SSE128_KERNELS)
+struct SSE128_Vector {
+    using type = __m128i;
+    static constexpr uint64_t BYTES = sizeof(__m128i);
+    static constexpr uint64_t MASK_BITS_PER_BYTE = 1;
+    static constexpr bool MASKED_LOADS = false;
+
+    SIMD_TARGET_SSE128 static inline void load(type &v, const char *p){ v = _mm_loadu_si128((const __m128i *)p); }
+    // Copies the bytes over fill bytes, so no byte outside the region is read
+    SIMD_TARGET_SSE128 static inline void load_partial(type &v, const char *p, uint64_t n, uint8_t fill){
+        alignas(BYTES) char copy[BYTES];
+        std::memset(copy, fill, BYTES);
+        std::memcpy(copy, p, n);
+        load(v, copy);
+    }
+    SIMD_TARGET_SSE128 static inline void set1(type &v, uint8_t value){ v = _mm_set1_epi8((char)value); }
+    SIMD_TARGET_SSE128 static inline void max(type &a, const type &b){ a = _mm_max_epu8(a, b); }
+    SIMD_TARGET_SSE128 static inline void min(type &a, const type &b){ a = _mm_min_epu8(a, b); }
+
+    // Folds the high byte of each 16-bit lane onto the low one, which leaves 16-bit values minpos can reduce
+    SIMD_TARGET_SSE128 static inline uint8_t horizontal_min(const type &v){
+        return (uint8_t)_mm_cvtsi128_si32(_mm_minpos_epu16(_mm_min_epu8(v, _mm_srli_epi16(v, 8))));
+    }
+
+    // The maximum is the minimum of the inverted bytes
+    SIMD_TARGET_SSE128 static inline uint8_t horizontal_max(const type &v){
+        return ~horizontal_min(_mm_xor_si128(v, _mm_set1_epi8(-1)));
+    }
+
+    template <Scan_Op OP>
+    SIMD_TARGET_SSE128 static inline uint64_t compare(const type &data, const type &target){
+        #if defined(__AVX512F__)
+            return _mm_cmp_epu8_mask(data, target, scan_predicate(OP));
+        #else
+            if constexpr (OP == Scan_Op::GEQ)
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(data, target), data));
+            else if constexpr (OP == Scan_Op::GT)
+                return ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(data, target), data)) & 0xFFFF;
+            else if constexpr (OP == Scan_Op::LEQ)
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(data, target), data));
+            else if constexpr (OP == Scan_Op::LT)
+                return ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(data, target), data)) & 0xFFFF;
+            else
+                return ~_mm_movemask_epi8(_mm_cmpeq_epi8(data, target)) & 0xFFFF;
+        #endif
+    }
+
+    SIMD_VECTOR_KERNELS(SIMD_TARGET_SSE128, SSE128_Vector)
+};
+#endif
+
+#if defined(SIMD_AVX256_KERNELS)
+struct AVX256_Vector {
+    using type = __m256i;
+    static constexpr uint64_t BYTES = sizeof(__m256i);
+    static constexpr uint64_t MASK_BITS_PER_BYTE = 1;
+    static constexpr bool MASKED_LOADS = false;
+
+    SIMD_TARGET_AVX256 static inline void load(type &v, const char *p){ v = _mm256_loadu_si256((const __m256i *)p); }
+    // Copies the bytes over fill bytes, so no byte outside the region is read
+    SIMD_TARGET_AVX256 static inline void load_partial(type &v, const char *p, uint64_t n, uint8_t fill){
+        alignas(BYTES) char copy[BYTES];
+        std::memset(copy, fill, BYTES);
+        std::memcpy(copy, p, n);
+        load(v, copy);
+    }
+    SIMD_TARGET_AVX256 static inline void set1(type &v, uint8_t value){ v = _mm256_set1_epi8((char)value); }
+    SIMD_TARGET_AVX256 static inline void max(type &a, const type &b){ a = _mm256_max_epu8(a, b); }
+    SIMD_TARGET_AVX256 static inline void min(type &a, const type &b){ a = _mm256_min_epu8(a, b); }
+
+    SIMD_TARGET_AVX256 static inline uint8_t horizontal_max(const type &v){
+        return SSE128_Vector::horizontal_max(_mm_max_epu8(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+
+    SIMD_TARGET_AVX256 static inline uint8_t horizontal_min(const type &v){
+        return SSE128_Vector::horizontal_min(_mm_min_epu8(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+
+    template <Scan_Op OP>
+    SIMD_TARGET_AVX256 static inline uint64_t compare(const type &data, const type &target){
+        #if defined(__AVX512F__)
+            return _mm256_cmp_epu8_mask(data, target, scan_predicate(OP));
+        #else
+            if constexpr (OP == Scan_Op::GEQ)
+                return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(data, target), data));
+            else if constexpr (OP == Scan_Op::GT)
+                return (uint32_t)~_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(data, target), data));
+            else if constexpr (OP == Scan_Op::LEQ)
+                return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(data, target), data));
+            else if constexpr (OP == Scan_Op::LT)
+                return (uint32_t)~_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(data, target), data));
+            else
+                return (uint32_t)~_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, target));
+        #endif
+    }
+
+    SIMD_VECTOR_KERNELS(SIMD_TARGET_AVX256, AVX256_Vector)
+};
+#endif
+
+#if defined(SIMD_AVX512_KERNELS)
+struct AVX512_Vector {
+    using type = __m512i;
+    static constexpr uint64_t BYTES = sizeof(__m512i);
+    static constexpr uint64_t MASK_BITS_PER_BYTE = 1;
+    static constexpr bool MASKED_LOADS = true;
+
+    SIMD_TARGET_AVX512 static inline void load(type &v, const char *p){ v = _mm512_loadu_si512((const void *)p); }
+    // Masked-off bytes are not read
+    SIMD_TARGET_AVX512 static inline void load_partial(type &v, const char *p, uint64_t n, uint8_t fill){
+        v = _mm512_mask_loadu_epi8(_mm512_set1_epi8((char)fill), ((__mmask64)1 << n) - 1, (const void *)p);
+    }
+    SIMD_TARGET_AVX512 static inline void set1(type &v, uint8_t value){ v = _mm512_set1_epi8((char)value); }
+    SIMD_TARGET_AVX512 static inline void max(type &a, const type &b){ a = _mm512_max_epu8(a, b); }
+    SIMD_TARGET_AVX512 static inline void min(type &a, const type &b){ a = _mm512_min_epu8(a, b); }
+
+    // The masked extracts avoid false uninitialized warnings of GCC on the unmasked ones
+    SIMD_TARGET_AVX512 static inline uint8_t horizontal_max(const type &v){
+        return AVX256_Vector::horizontal_max(_mm256_max_epu8(_mm512_maskz_extracti64x4_epi64(0xF, v, 0),
+                                                             _mm512_maskz_extracti64x4_epi64(0xF, v, 1)));
+    }
+
+    SIMD_TARGET_AVX512 static inline uint8_t horizontal_min(const type &v){
+        return AVX256_Vector::horizontal_min(_mm256_min_epu8(_mm512_maskz_extracti64x4_epi64(0xF, v, 0),
+                                                             _mm512_maskz_extracti64x4_epi64(0xF, v, 1)));
+    }
+
+    template <Scan_Op OP>
+    SIMD_TARGET_AVX512 static inline uint64_t compare(const type &data, const type &target){
+        return _mm512_cmp_epu8_mask(data, target, scan_predicate(OP));
+    }
+
+    SIMD_VECTOR_KERNELS(SIMD_TARGET_AVX512, AVX512_Vector)
+};
+#endif
+
+#if defined(SIMD_NEON_KERNELS)
+struct NEON_Vector {
+    using type = uint8x16_t;
+    static constexpr uint64_t BYTES = sizeof(uint8x16_t);
+    static constexpr uint64_t MASK_BITS_PER_BYTE = 4;
+    static constexpr bool MASKED_LOADS = false;
+
+    static inline void load(type &v, const char *p){ v = vld1q_u8((const uint8_t *)p); }
+    // Copies the bytes over fill bytes, so no byte outside the region is read
+    static inline void load_partial(type &v, const char *p, uint64_t n, uint8_t fill){
+        alignas(BYTES) char copy[BYTES];
+        std::memset(copy, fill, BYTES);
+        std::memcpy(copy, p, n);
+        load(v, copy);
+    }
+    static inline void set1(type &v, uint8_t value){ v = vdupq_n_u8(value); }
+    static inline void max(type &a, const type &b){ a = vmaxq_u8(a, b); }
+    static inline void min(type &a, const type &b){ a = vminq_u8(a, b); }
+
+    // Pairwise reductions down to a single byte
+    static inline uint8_t horizontal_max(const type &v){
+        uint8x8_t pairs = vpmax_u8(vget_low_u8(v), vget_high_u8(v));
+        for(int i = 0; i < 3; i++)
+            pairs = vpmax_u8(pairs, pairs);
+        return vget_lane_u8(pairs, 0);
+    }
+
+    static inline uint8_t horizontal_min(const type &v){
+        uint8x8_t pairs = vpmin_u8(vget_low_u8(v), vget_high_u8(v));
+        for(int i = 0; i < 3; i++)
+            pairs = vpmin_u8(pairs, pairs);
+        return vget_lane_u8(pairs, 0);
+    }
+
+    // ARM doesn't have native MOVEMASK instructions like x86 does. Following advice from an ARM community blog post,
+    // the mask narrows each byte of the comparison to 4 bits:
+    // https://community.arm.com/arm-community-blogs/b/servers-and-cloud-computing-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
+    template <Scan_Op OP>
+    static inline uint64_t compare(const type &data, const type &target){
+        uint8x16_t cmp_array;
+        if constexpr (OP == Scan_Op::GEQ)
+            cmp_array = vcgeq_u8(data, target);
+        else if constexpr (OP == Scan_Op::GT)
+            cmp_array = vcgtq_u8(data, target);
+        else if constexpr (OP == Scan_Op::LEQ)
+            cmp_array = vcleq_u8(data, target);
+        else if constexpr (OP == Scan_Op::LT)
+            cmp_array = vcltq_u8(data, target);
+        else
+            cmp_array = vmvnq_u8(vceqq_u8(data, target));
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp_array), 4)), 0);
+    }
+
+    SIMD_VECTOR_KERNELS(SIMD_TARGET_NEON, NEON_Vector)
+};
+#endif
+
+#if defined(SIMD_ALTIVEC_KERNELS)
+struct ALTIVEC_Vector {
+    using type = __vector unsigned char;
+    static constexpr uint64_t BYTES = sizeof(__vector unsigned char);
+    static constexpr uint64_t MASK_BITS_PER_BYTE = 1;
+    static constexpr bool MASKED_LOADS = false;
+
+    // Use vec_xl instead of vec_ld because vec_ld truncates the load address to a 16 byte boundary
+    static inline void load(type &v, const char *p){ v = vec_xl(0, (const unsigned char *)p); }
+    // Copies the bytes over fill bytes, so no byte outside the region is read
+    static inline void load_partial(type &v, const char *p, uint64_t n, uint8_t fill){
+        alignas(BYTES) char copy[BYTES];
+        std::memset(copy, fill, BYTES);
+        std::memcpy(copy, p, n);
+        load(v, copy);
+    }
+    static inline void set1(type &v, uint8_t value){ v = vec_splats((unsigned char)value); }
+    static inline void max(type &a, const type &b){ a = vec_max(a, b); }
+    static inline void min(type &a, const type &b){ a = vec_min(a, b); }
+
+    // Rotate and combine until every byte holds the result
+    static inline uint8_t horizontal_max(const type &v){
+        type r = v;
+        for(int shift = 8; shift > 0; shift >>= 1)
+            r = vec_max(r, vec_sld(r, r, shift));
+        return vec_extract(r, 0);
+    }
+
+    static inline uint8_t horizontal_min(const type &v){
+        type r = v;
+        for(int shift = 8; shift > 0; shift >>= 1)
+            r = vec_min(r, vec_sld(r, r, shift));
+        return vec_extract(r, 0);
+    }
+
+    template <Scan_Op OP>
+    static inline uint64_t compare(const type &data, const type &target){
+        __vector __bool char cmp_array;
+        if constexpr (OP == Scan_Op::GEQ)
+            cmp_array = vec_cmpge(data, target);
+        else if constexpr (OP == Scan_Op::GT)
+            cmp_array = vec_cmpgt(data, target);
+        else if constexpr (OP == Scan_Op::LEQ)
+            cmp_array = vec_cmple(data, target);
+        else if constexpr (OP == Scan_Op::LT)
+            cmp_array = vec_cmplt(data, target);
+        else {
+            cmp_array = vec_cmpeq(data, target);
+            cmp_array = vec_nor(cmp_array, cmp_array);
+        }
+
+        // Select the most significant bit of each byte. bperm stores the masks in elements 8 and 9, element 9
+        // holding the first 8 selected bits because vec_bperm rearranges the bits in little endian order.
+        // Selecting the bytes from last to first sets bit i of the mask for byte i.
+        __vector unsigned char bit_selector = {120, 112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0};
+        __vector unsigned char perm_array = vec_bperm((__vector unsigned char)cmp_array, bit_selector);
+        return ((uint64_t)vec_extract(perm_array, 9) << 8) | vec_extract(perm_array, 8);
+    }
+
+    SIMD_VECTOR_KERNELS(SIMD_TARGET_ALTIVEC, ALTIVEC_Vector)
+};
+#endif
+
+/**
+ * @brief Vector type of the no-slide modes (sse128_noslide, avx256_noslide, avx512_noslide), with the kernels of
+ * Vector. Instead of sliding range scans from one extreme value to the next, the chunkers find the extreme value
+ * of a whole window with find_extremum and jump to it.
+ */
+template <class Vector>
+struct No_Slide_Vector : Vector {};
+
+template <class Vector>
+inline constexpr bool is_no_slide_vector = false;
+template <class Vector>
+inline constexpr bool is_no_slide_vector<No_Slide_Vector<Vector>> = true;
+
+/**
+ * Chunkers specialized on a vector type are instantiated for each vector type compiled into the binary.
+ * FOR_EACH_SIMD_VECTOR(X) expands to X(SSE128_Vector) X(No_Slide_Vector<SSE128_Vector>) X(AVX256_Vector) ... for
+ * those types.
+ */
+#if defined(SIMD_SSE128_KERNELS)
+    #define SIMD_SSE128_VECTOR(X) X(SSE128_Vector) X(No_Slide_Vector<SSE128_Vector>)
+#else
+    #define SIMD_SSE128_VECTOR(X)
+#endif
+#if defined(SIMD_AVX256_KERNELS)
+    #define SIMD_AVX256_VECTOR(X) X(AVX256_Vector) X(No_Slide_Vector<AVX256_Vector>)
+#else
+    #define SIMD_AVX256_VECTOR(X)
+#endif
+#if defined(SIMD_AVX512_KERNELS)
+    #define SIMD_AVX512_VECTOR(X) X(AVX512_Vector) X(No_Slide_Vector<AVX512_Vector>)
+#else
+    #define SIMD_AVX512_VECTOR(X)
+#endif
+#if defined(SIMD_NEON_KERNELS)
+    #define SIMD_NEON_VECTOR(X) X(NEON_Vector)
+#else
+    #define SIMD_NEON_VECTOR(X)
+#endif
+#if defined(SIMD_ALTIVEC_KERNELS)
+    #define SIMD_ALTIVEC_VECTOR(X) X(ALTIVEC_Vector)
+#else
+    #define SIMD_ALTIVEC_VECTOR(X)
+#endif
+#define FOR_EACH_SIMD_VECTOR(X) \
+    SIMD_SSE128_VECTOR(X) SIMD_AVX256_VECTOR(X) SIMD_AVX512_VECTOR(X) SIMD_NEON_VECTOR(X) SIMD_ALTIVEC_VECTOR(X)
+
+// Names a vector type as a value, void standing for the native search of SIMD mode NONE
+template <class Vector>
+struct Vector_Tag { using type = Vector; };
+
+/**
+ * @brief Calls visit with the Vector_Tag of a SIMD mode, so the caller can instantiate code for its vector type
+ * @param fallback: called instead for the modes without a vector type in this binary
+ */
+template <class Visit, class Fallback>
+inline auto visit_simd_vector(SIMD_Mode mode, Visit visit, Fallback fallback){
+    switch(mode){
+        case SIMD_Mode::NONE:
+            return visit(Vector_Tag<void>{});
+        #if defined(SIMD_SSE128_KERNELS)
+        case SIMD_Mode::SSE128:
+            return visit(Vector_Tag<SSE128_Vector>{});
+        case SIMD_Mode::SSE128_NOSLIDE:
+            return visit(Vector_Tag<No_Slide_Vector<SSE128_Vector>>{});
+        #endif
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return visit(Vector_Tag<AVX256_Vector>{});
+        case SIMD_Mode::AVX256_NOSLIDE:
+            return visit(Vector_Tag<No_Slide_Vector<AVX256_Vector>>{});
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return visit(Vector_Tag<AVX512_Vector>{});
+        case SIMD_Mode::AVX512_NOSLIDE:
+            return visit(Vector_Tag<No_Slide_Vector<AVX512_Vector>>{});
+        #endif
+        #if defined(SIMD_NEON_KERNELS)
+        case SIMD_Mode::NEON:
+            return visit(Vector_Tag<NEON_Vector>{});
+        #endif
+        #if defined(SIMD_ALTIVEC_KERNELS)
+        case SIMD_Mode::ALTIVEC:
+            return visit(Vector_Tag<ALTIVEC_Vector>{});
+        #endif
+        default:
+            return fallback();
+    }
+}
+
+#endif
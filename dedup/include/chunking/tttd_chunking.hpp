@@ -9,16 +9,62 @@
 #include "config.hpp"
 
 #include <cstring>
+#include <string>
+#include <vector>
+
+// Candidate bitmap levels: positions matching the backup and the main divisor
+#define TTTD_BACKUP_LEVEL 0
+#define TTTD_MAIN_LEVEL 1
 
 class TTTD_Chunking : public virtual Rabins_Chunking{
     private:
         uint64_t rabin_mask, backup_mask;
 
         uint64_t avg_block_size, min_block_size, max_block_size;
+
+        void mark_candidates(const char* buff, uint64_t start, uint64_t end,
+                             uint64_t** bitmaps) override;
+
+        uint64_t find_cutpoint_bitmap(char* buff, uint64_t start, uint64_t size) override;
+
+        /**
+         * @brief Waits for all the bytes of the chunk like Chunking_Technique, the backup
+         * cut-point depends on every byte up to the maximum chunk size
+         */
+        uint64_t resume_cutpoint(char* buff, uint64_t size, bool end_of_data) override;
+
+        /**
+         * @brief finds the cut points of a buffer with find_cutpoint, waiting for whole chunks
+         * as resume_cutpoint
+         */
+        uint64_t find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) override;
+
+        /**
+         * @brief Evaluates the positions from min_block_size to warmup_end, whose fingerprint
+         * still contains the byte slid in by the reset of the Rabin window
+         * @return: true if the main divisor matched at cut
+         */
+        bool find_warmup_cutpoint(const char* buff, uint64_t warmup_end, uint64_t& last_backup_pos,
+                                  uint64_t& cut);
     public:
 
+    /**
+     * @brief Finds the next cut point. With simd_mode set, the candidates of both divisors
+     * are marked for blocks of positions by the Rabin kernel, then picked with bit scans
+     */
     uint64_t find_cutpoint(char* buff, uint64_t size) override;
 
+    /**
+     * @brief Chunks the files one by one, the multi-stream kernel of Rabin does not apply to TTTD
+     */
+    std::vector<std::vector<std::string>> chunk_files(const std::vector<std::string>& file_paths) override;
+
+    /**
+     * @brief Maximum chunk size of TTTD
+     * @return: uint64_t
+     */
+    uint64_t get_max_block_size() const override;
+
     //  TTTD_Chunking();
 
      TTTD_Chunking(const Config & config);
@@ -34,7 +34,19 @@
 #define CRC_WINDOW_SIZE "crc_window_size"
 #define CRC_WINDOW_STEP_SIZE "crc_window_step_size"
 #define CRC_HASH_BITS "crc_hash_bits"
+#define CRC_POLYNOMIAL "crc_polynomial"
 #define BUFFER_SIZE "buffer_size"
+#define CANDIDATE_BITMAP "candidate_bitmap"
+#define CANDIDATE_BITMAP_THREADS "candidate_bitmap_threads"
+#define CANDIDATE_BITMAP_REGION_SIZE "candidate_bitmap_region_size"
+#define RUN_SKIP "run_skip"
+#define MANIFEST_RANGE_OVERLAP "manifest_range_overlap"
+#define FINGERPRINT_INDEX "fingerprint_index"
+#define FINGERPRINT_INDEX_CAPACITY "fingerprint_index_capacity"
+#define WRITE_HASH_FILE "write_hash_file"
+#define CHECKPOINT_INTERVAL "checkpoint_interval"
+#define MULTI_STREAM_FILES "multi_stream_files"
+#define AUTOTUNE_PROFILE "autotune_profile"
 #define MAXP_WINDOW_SIZE "maxp_window_size"
 #define MAXP_MAX_BLOCK_SIZE "maxp_max_block_size"
 #define SEQ_JUMP_TRIGGER "seq_jump_trigger"
@@ -73,11 +85,15 @@ enum class ChunkingTech {
 enum class SIMD_Mode{
     NONE,
     SSE128_NOSLIDE,
+    AVX256_NOSLIDE,
+    AVX512_NOSLIDE,
     SSE128,
     AVX256,
     AVX512,
     NEON,
-    ALTIVEC
+    ALTIVEC,
+    // simd_mode=auto or autotune, replaced by the driver once the chunking technique is known
+    AUTO
 };
 
 // define the possible hashing algorithms
@@ -86,12 +102,15 @@ enum class HashingTech { MD5, SHA1, SHA256, SHA512, XXHASH128, MURMURHASH3 };
 // define the the extreme value type of AE algorithm
 enum AE_Mode { MAX, MIN };
 
+// define the CRC polynomials of CRC chunking
+enum class CRC_Polynomial { CRC32, CRC32C };
+
 // define SeqCDC operating modes
 enum Seq_Op_Mode { INCREASING, DECREASING };
 
 
 class Config {
-    const Parser parser;
+    Parser parser;
 
    public:
     Config(std::string config_file_path);
@@ -114,11 +133,29 @@ class Config {
 
     
     /**
-     * @brief Get the SIMD mode for chunking technique
+     * @brief Get the SIMD mode for chunking technique. "auto" and "autotune"
+     * return AUTO: the driver selects the mode with the chunking technique,
+     * or the calibration does. Defaults to none if the key does not
+     * exist. throws ConfigError if the CPU does not support the mode
      * 
      * @return SIMD_Mode
      */
     SIMD_Mode get_simd_mode() const;
+
+    /**
+     * @brief Check whether the SIMD mode and buffer size are chosen by a
+     * calibration run at startup (simd_mode=autotune)
+     *
+     * @return bool
+     */
+    bool get_simd_autotune() const;
+
+    /**
+     * @brief Set the SIMD mode, replacing the value read from the config file
+     *
+     * @param mode: SIMD mode
+     */
+    void set_simd_mode(SIMD_Mode mode);
     
     /**
      * @brief Get the size (in number of bytes) of a chunk when using fixed-size
@@ -322,6 +359,15 @@ class Config {
 
     uint32_t get_crc_hash_bits() const;
 
+    /**
+     * @brief Get the CRC polynomial when using crc chunking, crc32 (default)
+     * or crc32c. throws ConfigError if the value is invalid
+     *
+     * @return CRC_Polynomial
+     */
+
+    CRC_Polynomial get_crc_polynomial() const;
+
     /**
      * @brief Get the desired internal buffer size
      * throws ConfigError if the key does not exist or
@@ -371,6 +417,112 @@ class Config {
      */
     uint64_t get_buffer_size() const;
 
+    /**
+     * @brief Set the buffer size, replacing the value read from the config file
+     *
+     * @param buffer_size: buffer size in bytes
+     */
+    void set_buffer_size(uint64_t buffer_size);
+
+    /**
+     * @brief Check whether the two-phase candidate bitmap mode is enabled
+     * for the rolling hash chunkers. Defaults to false
+     *
+     * @return bool
+     */
+    bool get_candidate_bitmap() const;
+
+    /**
+     * @brief Get the number of threads used to build candidate bitmaps.
+     * Defaults to 1
+     *
+     * @return uint64_t
+     */
+    uint64_t get_candidate_bitmap_threads() const;
+
+    /**
+     * @brief Get the size (in bytes) of the regions scanned in one pass
+     * when building candidate bitmaps. Defaults to 16 MiB
+     *
+     * @return uint64_t
+     */
+    uint64_t get_candidate_bitmap_region_size() const;
+
+    /**
+     * @brief Check whether the chunkers skip the runs of equal bytes in
+     * which they cannot find a cut-point. Defaults to false
+     *
+     * @return bool
+     */
+    bool get_run_skip() const;
+
+    /**
+     * @brief Get the number of bytes past the end of a manifest byte range
+     * in which chunks are still written, so that adjacent ranges can be
+     * resynchronized when merging. Returns 0 if the key does not exist
+     *
+     * @return uint64_t
+     */
+    uint64_t get_manifest_range_overlap() const;
+
+    /**
+     * @brief Get the name of the shared memory fingerprint index to insert
+     * chunks into. Returns an empty string if the key does not exist
+     *
+     * @return std::string
+     */
+    std::string get_fingerprint_index() const;
+
+    /**
+     * @brief Get the number of slots of the fingerprint index when it is
+     * created. Defaults to 16777216
+     *
+     * @return uint64_t
+     */
+    uint64_t get_fingerprint_index_capacity() const;
+
+    /**
+     * @brief Check whether the chunk hashes are written to the output file.
+     * Defaults to true
+     *
+     * @return bool
+     */
+    bool get_write_hash_file() const;
+
+    /**
+     * @brief Get the number of bytes chunked between two checkpoints of a
+     * run. Returns 0 (no checkpoints) if the key does not exist
+     *
+     * @return uint64_t
+     */
+    uint64_t get_checkpoint_interval() const;
+
+    /**
+     * @brief Get the number of files chunked together by the multi-stream
+     * kernels of Gear, FastCDC and Rabin. Returns 0 (one file at a time) if
+     * the key does not exist
+     *
+     * @return uint64_t
+     */
+    uint64_t get_multi_stream_files() const;
+
+    /**
+     * @brief Get the path of the file caching the autotune results.
+     * Returns an empty string (no caching) if the key does not exist
+     *
+     * @return std::string
+     */
+    std::string get_autotune_profile() const;
+
+    /**
+     * @brief Get the chunking parameters of the config file as a single
+     * line, leaving out the SIMD mode, buffer size, hashing and output
+     * settings. Identifies the chunker in the autotune profile
+     *
+     * @return std::string
+     */
+    std::string get_chunking_signature() const;
+
     /**
     * @brief Get the desired window size
     * throws ConfigError if the key does not exist or
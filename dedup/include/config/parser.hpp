@@ -2,6 +2,7 @@
 #define _PARSER_
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 
 class Parser {
@@ -21,6 +22,22 @@ class Parser {
          */
         std::string get_property(const std::string& key) const;
 
+        /**
+         * @brief Set the value of the given key, replacing the value read
+         * from the config file
+         * 
+         * @param key 
+         * @param value 
+         */
+        void set_property(const std::string& key, const std::string& value);
+
+        /**
+         * @brief Get all the stored key value mappings, sorted by key
+         * 
+         * @return std::vector<std::pair<std::string, std::string>> 
+         */
+        std::vector<std::pair<std::string, std::string>> get_properties() const;
+
         /**
          * @brief Prints out all the stored key value mapping
          */
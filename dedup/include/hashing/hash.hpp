@@ -49,6 +49,13 @@ class Hash {
          *  @return BYTE*
         */
         BYTE* getHash() const;
+
+        /**
+         *  @brief return the size of the hash in bytes
+         * 
+         *  @return unsigned int
+        */
+        unsigned int getSize() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file fingerprint_index.hpp
+ * @author WASL
+ * @brief Fingerprint index in POSIX shared memory, shared by cooperating
+ * dedup.exe processes to measure global dedup while chunking
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _FINGERPRINT_INDEX_
+#define _FINGERPRINT_INDEX_
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <string>
+
+#include "hash.hpp"
+
+// Identifies an initialized index, written last by the creating process.
+// Changed with the slot layout, so indexes of older binaries are not attached
+#define FINGERPRINT_INDEX_MAGIC 0x5844495050524447ULL
+// Longer digests are truncated, shorter ones zero padded
+#define FINGERPRINT_KEY_SIZE 32
+// 64-bit words of a slot key: the padded digest, then its size before padding
+#define FINGERPRINT_KEY_WORDS (FINGERPRINT_KEY_SIZE / 8 + 1)
+
+class FingerprintIndexError : public std::exception {
+    const std::string msg;
+    public:
+        FingerprintIndexError(const std::string& msg);
+
+        const char* what() const noexcept override;
+};
+
+struct Fingerprint_Index_Stats {
+    uint64_t total_chunks;
+    uint64_t unique_chunks;
+    uint64_t total_bytes;
+    uint64_t unique_bytes;
+};
+
+class Fingerprint_Index {
+    /**
+     * @brief Open-addressing hash table of chunk digests in a POSIX shared
+     * memory object. The first process to open the object creates it, the
+     * others attach to it. A slot is claimed by a compare-and-swap of the
+     * first key word (never 0) from 0, and every process whose key starts
+     * with that word then stores the other words with a compare-and-swap
+     * from 0 as well. A key is in the slot if all its words are, so no
+     * process waits on another: a key left incomplete by a killed process
+     * is completed by the next one inserting it.
+     *
+     * Counters are accumulated per process and added to the shared ones
+     * by flush(), so the hot path only touches the slot being probed.
+     */
+
+    struct Slot {
+        std::atomic<uint64_t> key[FINGERPRINT_KEY_WORDS];
+        // Written by the process that claimed the slot
+        uint64_t chunk_size;
+    };
+
+    struct Header {
+        std::atomic<uint64_t> magic;
+        uint64_t capacity;
+        std::atomic<uint64_t> total_chunks;
+        std::atomic<uint64_t> unique_chunks;
+        std::atomic<uint64_t> total_bytes;
+        std::atomic<uint64_t> unique_bytes;
+        std::atomic<uint64_t> full;
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                  std::atomic<uint64_t>::is_always_lock_free,
+                  "shared memory atomics must be lock free");
+
+    std::string name;
+    Header* header = nullptr;
+    Slot* slots = nullptr;
+    uint64_t mapping_size = 0;
+    uint64_t mask = 0;
+    bool full_warned = false;
+
+    // Counters not yet added to the shared header
+    Fingerprint_Index_Stats pending = {0, 0, 0, 0};
+
+    public:
+        /**
+         * @brief Attach to the index with the given name, creating it if it
+         * does not exist. throws FingerprintIndexError on failure
+         *
+         * @param name: name of the shared memory object
+         * @param capacity: number of slots, rounded up to a power of 2. Only
+         * used by the process creating the index
+         */
+        Fingerprint_Index(const std::string& name, uint64_t capacity);
+
+        /**
+         * @brief Attach to an existing index without creating it.
+         * throws FingerprintIndexError if it does not exist
+         *
+         * @param name: name of the shared memory object
+         */
+        explicit Fingerprint_Index(const std::string& name);
+
+        Fingerprint_Index(const Fingerprint_Index& other) = delete;
+
+        Fingerprint_Index& operator=(const Fingerprint_Index& other) = delete;
+
+        ~Fingerprint_Index();
+
+        /**
+         * @brief Record a chunk in the index
+         *
+         * @param digest: digest of the chunk
+         * @param digest_size: size of the digest in bytes
+         * @param chunk_size: size of the chunk in bytes
+         * @return: true if no process inserted this digest before
+         */
+        bool insert(const BYTE* digest, unsigned int digest_size, uint64_t chunk_size);
+
+        /**
+         * @brief Add the counters of this process to the shared counters
+         *
+         * @return: void
+         */
+        void flush();
+
+        /**
+         * @brief Get the shared counters, as flushed by all processes
+         *
+         * @return Fingerprint_Index_Stats
+         */
+        Fingerprint_Index_Stats get_stats() const;
+
+        /**
+         * @brief Number of slots in the index
+         *
+         * @return uint64_t
+         */
+        uint64_t get_capacity() const;
+
+        /**
+         * @brief Check whether an insert failed because every slot was taken.
+         * Counters are incomplete once this happens
+         *
+         * @return bool
+         */
+        bool is_full() const;
+
+        /**
+         * @brief Remove the shared memory object. Attached processes keep
+         * their mapping until they exit
+         *
+         * @param name: name of the shared memory object
+         * @return: true if the object existed
+         */
+        static bool remove(const std::string& name);
+};
+
+#endif
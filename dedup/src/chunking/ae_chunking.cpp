@@ -10,6 +10,7 @@
  */
 
 #include <fstream>
+#include <type_traits>
 #include "ae_chunking.hpp"
 
 AE_Chunking::AE_Chunking() {
@@ -19,27 +20,6 @@ AE_Chunking::AE_Chunking() {
 
 	chunk_counter = 0;
 
-	#if defined(__SSE3__)
-	sse_array = nullptr;
-	#endif
-	
-	#if defined(__AVX2__)
-	avx256_array = nullptr;
-	#endif
-	
-	#ifdef __AVX512F__
-	avx512_array = nullptr;
-	#endif
-
-	#ifdef __ARM_NEON
-	neon_array = nullptr;
-	#endif
-
-	#ifdef __ALTIVEC__
-	altivec_array = nullptr;
-	#endif
-
-
 	simd_mode = SIMD_Mode::NONE;
 }
 
@@ -49,189 +29,150 @@ AE_Chunking::AE_Chunking(const Config& config) {
     window_size = avg_block_size - 256;
 	// window_size = avg_block_size / (exp(1) - 1);  // avg_block size / e-1
 
-
-	// Initialize SIMD arrays based on the chosen SIMD mode
-
-	#if defined(__SSE3__)
-	sse_array = nullptr;
-	#endif
-	
-	#if defined(__AVX2__)
-	avx256_array = nullptr;
-	#endif
-	
-	#ifdef __AVX512F__
-	avx512_array = nullptr;
-	#endif
-
-	#ifdef __ARM_NEON
-	neon_array = nullptr;
-	#endif
-
-	#ifdef __ALTIVEC__
-	altivec_array = nullptr;
-	#endif
-
 	simd_mode = config.get_simd_mode();
-	if (simd_mode == SIMD_Mode::NONE) {
-
-	} 
-	#if defined(__SSE3__)
-	else if (simd_mode == SIMD_Mode::SSE128) {
-		if(window_size % SSE_REGISTER_SIZE_BYTES != 0 || (window_size / SSE_REGISTER_SIZE_BYTES) % 2 != 0) {
-            // Check if window size is a multiple of 16
-            // Check if window size makes an even number of vectors for find_maximum_sse128
-            std::cout << "AE window size currently unsupported by SSE128. Please use an even multiple of SSE128_REGISTER_SIZE_BYTES (default 16)." << std::endl;
-            exit(1);
-        }
-		sse_array = new __m128i[avg_block_size / SSE_REGISTER_SIZE_BYTES];
-		if (sse_array == nullptr) {
-			std::cout << "Error allocating memory for 128-bit vectors(__m128i)" << std::endl;
-			exit(1);
-		}
-	} 
-	#endif
-
-	#if defined(__AVX2__)
-	else if (simd_mode == SIMD_Mode::AVX256) {
-		if(window_size % AVX256_REGISTER_SIZE_BYTES != 0 || (window_size / AVX256_REGISTER_SIZE_BYTES % 2 != 0)) {
-			// Check if window size is a multiple of 32
-			// Check if window size makes an even number of vectors for find_maximum_AVX256
-			std::cout << "AE window size currently unsupported by AVX256. Please use an even multiple of AVX_REGISTER_SIZE_BYTES (default 32)." << std::endl;
+	switch (simd_mode) {
+		case SIMD_Mode::NONE:
+		#if defined(SIMD_SSE128_KERNELS)
+		case SIMD_Mode::SSE128:
+		case SIMD_Mode::SSE128_NOSLIDE:
+		#endif
+		#if defined(SIMD_AVX256_KERNELS)
+		case SIMD_Mode::AVX256:
+		case SIMD_Mode::AVX256_NOSLIDE:
+		#endif
+		#ifdef SIMD_AVX512_KERNELS
+		case SIMD_Mode::AVX512:
+		case SIMD_Mode::AVX512_NOSLIDE:
+		#endif
+		#ifdef SIMD_NEON_KERNELS
+		case SIMD_Mode::NEON:
+		#endif
+		#ifdef SIMD_ALTIVEC_KERNELS
+		case SIMD_Mode::ALTIVEC:
+		#endif
+			break;
+		default:
+			std::cerr << "Error: Unsupported SIMD mode" << std::endl;
 			exit(1);
-		}
-		avx256_array = new __m256i[avg_block_size / AVX256_REGISTER_SIZE_BYTES];
-		if (avx256_array == nullptr) {
-			std::cout << "Error allocating memory for 256-bit vectors(__m256i)" << std::endl;
-			exit(1);
-		}
 	}
-	#endif
+    
+    run_skip = config.get_run_skip();
+    technique_name = "AE Chunking";
+}
 
-	#ifdef __AVX512F__
-	else if (simd_mode == SIMD_Mode::AVX512) {
-		if(window_size % AVX512_REGISTER_SIZE_BYTES != 0 || (window_size / AVX512_REGISTER_SIZE_BYTES) % 2 != 0) {
-			// Check if window size is a multiple of 64
-			// Check if window size makes an even number of vectors for find_maximum_AVX512
-			std::cout << "AE window size currently unsupported by AVX512. Please use an even multiple of AVX_REGISTER_SIZE_BYTES (default 64)." << std::endl;
-			exit(1);
-		}
-		avx512_array = new __m512i[avg_block_size / AVX512_REGISTER_SIZE_BYTES];
-		if (avx512_array == nullptr) {
-			std::cout << "Error allocating memory for 512-bit vectors(__m512i)" << std::endl;
-			exit(1);
-		}
-	}
-	#endif
+bool AE_Chunking::supports_simd_mode(SIMD_Mode mode) const {
+	return mode == SIMD_Mode::NONE || simd_mode_supported(mode);
+}
 
-	#ifdef __ARM_NEON
-	else if (simd_mode == SIMD_Mode::NEON) {
-		if(window_size % NEON_REGISTER_SIZE_BYTES != 0 || (window_size / NEON_REGISTER_SIZE_BYTES) % 2 != 0) {
-			// Check if window size is a multiple of 16
-			// Check if window size makes an even number of vectors for find_maximum_neon
-			std::cout << "AE window size currently unsupported by NEON. Please use an even multiple of NEON_REGISTER_SIZE_BYTES (default 16)." << std::endl;
-			exit(1);
-		}
-		neon_array = new uint8x16_t[avg_block_size / NEON_REGISTER_SIZE_BYTES];
-		if (neon_array == nullptr) {
-			std::cout << "Error allocating memory for NEON vectors(uint8x16_t)" << std::endl;
-			exit(1);
-		}
-	}
-	#endif
+uint64_t AE_Chunking::find_cutpoint(char *buff, uint64_t size){
 
-	#ifdef __ALTIVEC__
-	else if (simd_mode == SIMD_Mode::ALTIVEC) {
-		if(window_size % ALTIVEC_REGISTER_SIZE_BYTES != 0 || (window_size / ALTIVEC_REGISTER_SIZE_BYTES) % 2 != 0) {
-			// Check if window size is a multiple of 16
-			// Check if window size makes an even number of vectors for find_maximum_altivec
-			std::cout << "AE window size currently unsupported by ALTIVEC. Please use an even multiple of ALTIVEC_REGISTER_SIZE_BYTES (default 16)." << std::endl;
-			exit(1);
-		}
-		altivec_array = new __vector unsigned char[avg_block_size / ALTIVEC_REGISTER_SIZE_BYTES];
-		if (altivec_array == nullptr) {
-			std::cout << "Error allocating memory for ALTIVEC vectors(__vector unsigned char)" << std::endl;
-			exit(1);
-		}
-	}
-	#endif
+	// chunk_counter++;
 
-	else {
-		std::cerr << "Error: Unsupported SIMD mode" << std::endl;
-		exit(1);
+	bool maximum = extreme_mode == MAX;
+	if(simd_mode == SIMD_Mode::NONE){
+		return maximum ? find_cutpoint_native<true>(buff, size) : find_cutpoint_native<false>(buff, size);
 	}
-    
-    technique_name = "AE Chunking";
-}
-
-AE_Chunking::~AE_Chunking() {
-	#ifdef __SSE3__
-	if (sse_array != nullptr) {
-		delete[] sse_array;
+	
+	#ifdef SIMD_SSE128_KERNELS
+	else if(simd_mode == SIMD_Mode::SSE128){
+		return maximum ? find_cutpoint_simd<SSE128_Vector, true>(buff, size) : find_cutpoint_simd<SSE128_Vector, false>(buff, size);
+	}
+	else if(simd_mode == SIMD_Mode::SSE128_NOSLIDE){
+		return maximum ? find_cutpoint_simd<No_Slide_Vector<SSE128_Vector>, true>(buff, size)
+		               : find_cutpoint_simd<No_Slide_Vector<SSE128_Vector>, false>(buff, size);
 	}
 	#endif
-
-	#ifdef __AVX2__
-	if (avx256_array != nullptr) {
-		delete[] avx256_array;
+	
+	#ifdef SIMD_AVX256_KERNELS
+	else if(simd_mode == SIMD_Mode::AVX256){
+		return maximum ? find_cutpoint_simd<AVX256_Vector, true>(buff, size) : find_cutpoint_simd<AVX256_Vector, false>(buff, size);
+	}
+	else if(simd_mode == SIMD_Mode::AVX256_NOSLIDE){
+		return maximum ? find_cutpoint_simd<No_Slide_Vector<AVX256_Vector>, true>(buff, size)
+		               : find_cutpoint_simd<No_Slide_Vector<AVX256_Vector>, false>(buff, size);
 	}
 	#endif
 
-	#ifdef __AVX512F__
-	if (avx512_array != nullptr) {
-		delete[] avx512_array;
+	#ifdef SIMD_AVX512_KERNELS
+	else if(simd_mode == SIMD_Mode::AVX512){
+		return maximum ? find_cutpoint_simd<AVX512_Vector, true>(buff, size) : find_cutpoint_simd<AVX512_Vector, false>(buff, size);
+	}
+	else if(simd_mode == SIMD_Mode::AVX512_NOSLIDE){
+		return maximum ? find_cutpoint_simd<No_Slide_Vector<AVX512_Vector>, true>(buff, size)
+		               : find_cutpoint_simd<No_Slide_Vector<AVX512_Vector>, false>(buff, size);
 	}
 	#endif
 
-	#ifdef __ARM_NEON
-	if (neon_array != nullptr) {
-		delete[] neon_array;
+	#ifdef SIMD_NEON_KERNELS
+	else if(simd_mode == SIMD_Mode::NEON){
+		return maximum ? find_cutpoint_simd<NEON_Vector, true>(buff, size) : find_cutpoint_simd<NEON_Vector, false>(buff, size);
 	}
 	#endif
 
-	#ifdef __ALTIVEC__
-	if (altivec_array != nullptr) {
-		delete[] altivec_array;	
+	#ifdef SIMD_ALTIVEC_KERNELS
+	else if(simd_mode == SIMD_Mode::ALTIVEC){
+		return maximum ? find_cutpoint_simd<ALTIVEC_Vector, true>(buff, size) : find_cutpoint_simd<ALTIVEC_Vector, false>(buff, size);
 	}
 	#endif
 
+	else{
+		std::cerr << "Error: Unsupported SIMD mode" << std::endl;
+		return 0;
+	}
 }
 
-uint64_t AE_Chunking::find_cutpoint(char *buff, uint64_t size){
-
-	// chunk_counter++;
+uint64_t AE_Chunking::find_cutpoints(char *buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts){
 
+	bool maximum = extreme_mode == MAX;
 	if(simd_mode == SIMD_Mode::NONE){
-		return find_cutpoint_native(buff, size);
+		return maximum ? find_cutpoints_for<void, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<void, false>(buff, size, end_of_data, cuts);
 	}
-	
-	#ifdef __SSE3__
+
+	#ifdef SIMD_SSE128_KERNELS
 	else if(simd_mode == SIMD_Mode::SSE128){
-		return find_cutpoint_sse128(buff, size);
+		return maximum ? find_cutpoints_for<SSE128_Vector, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<SSE128_Vector, false>(buff, size, end_of_data, cuts);
+	}
+	else if(simd_mode == SIMD_Mode::SSE128_NOSLIDE){
+		return maximum ? find_cutpoints_for<No_Slide_Vector<SSE128_Vector>, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<No_Slide_Vector<SSE128_Vector>, false>(buff, size, end_of_data, cuts);
 	}
 	#endif
-	
-	#ifdef __AVX2__
+
+	#ifdef SIMD_AVX256_KERNELS
 	else if(simd_mode == SIMD_Mode::AVX256){
-		return find_cutpoint_avx256(buff, size);
+		return maximum ? find_cutpoints_for<AVX256_Vector, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<AVX256_Vector, false>(buff, size, end_of_data, cuts);
+	}
+	else if(simd_mode == SIMD_Mode::AVX256_NOSLIDE){
+		return maximum ? find_cutpoints_for<No_Slide_Vector<AVX256_Vector>, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<No_Slide_Vector<AVX256_Vector>, false>(buff, size, end_of_data, cuts);
 	}
 	#endif
 
-	#ifdef __AVX512F__
+	#ifdef SIMD_AVX512_KERNELS
 	else if(simd_mode == SIMD_Mode::AVX512){
-		return find_cutpoint_avx512(buff, size);
+		return maximum ? find_cutpoints_for<AVX512_Vector, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<AVX512_Vector, false>(buff, size, end_of_data, cuts);
+	}
+	else if(simd_mode == SIMD_Mode::AVX512_NOSLIDE){
+		return maximum ? find_cutpoints_for<No_Slide_Vector<AVX512_Vector>, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<No_Slide_Vector<AVX512_Vector>, false>(buff, size, end_of_data, cuts);
 	}
 	#endif
 
-	#ifdef __ARM_NEON
+	#ifdef SIMD_NEON_KERNELS
 	else if(simd_mode == SIMD_Mode::NEON){
-		return find_cutpoint_neon(buff, size);
+		return maximum ? find_cutpoints_for<NEON_Vector, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<NEON_Vector, false>(buff, size, end_of_data, cuts);
 	}
 	#endif
 
-	#ifdef __ALTIVEC__
+	#ifdef SIMD_ALTIVEC_KERNELS
 	else if(simd_mode == SIMD_Mode::ALTIVEC){
-		return find_cutpoint_altivec(buff, size);
+		return maximum ? find_cutpoints_for<ALTIVEC_Vector, true>(buff, size, end_of_data, cuts)
+		               : find_cutpoints_for<ALTIVEC_Vector, false>(buff, size, end_of_data, cuts);
 	}
 	#endif
 
@@ -241,315 +182,168 @@ uint64_t AE_Chunking::find_cutpoint(char *buff, uint64_t size){
 	}
 }
 
-#ifdef __SSE3__
-uint64_t AE_Chunking::find_cutpoint_sse128(char* buff, uint64_t size) {
-	uint64_t target_pos = 0;
-	uint64_t return_pos_range_scan;
-	uint8_t find_max_result;
-
-	uint8_t target_value = (uint8_t) buff[target_pos];
-	if(extreme_mode == AE_Mode::MAX){
-		while(target_pos < (size - window_size - 1)){
-
-			return_pos_range_scan = range_scan_gt_sse128(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-			if(return_pos_range_scan != target_pos + 1 + window_size){
-				target_pos = return_pos_range_scan;
-				target_value = (uint8_t) buff[target_pos];
-
-				find_max_result = find_maximum_sse128(buff, target_pos + 1, target_pos + 1 + window_size, sse_array);
-
-				if(find_max_result < target_value)
-					return std::min(size, target_pos + window_size);
-			}
-			else {
-				return std::min(size, target_pos + window_size);
-			}
-		}
-
-		return size;
+template <class Vector, bool MAXIMUM>
+uint64_t AE_Chunking::find_cutpoints_for(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) {
+	if constexpr (std::is_void_v<Vector>) {
+		return cut_chunks(buff, size, end_of_data, cuts, [this](char* chunk, uint64_t chunk_size, bool complete) {
+			return resume_native<MAXIMUM>(chunk, chunk_size, complete);
+		});
 	}
-	else if(extreme_mode == AE_Mode::MIN){
-			uint64_t target_pos = 0;
-			uint64_t return_pos_range_scan;
-			uint8_t find_min_result;
-			uint8_t target_value = (uint8_t) buff[target_pos];
-
-			while(target_pos < (size - window_size - 1)){
-				return_pos_range_scan = range_scan_lt_sse128(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-				if(return_pos_range_scan != target_pos + 1 + window_size){
-					target_pos = return_pos_range_scan;
-					target_value = (uint8_t) buff[target_pos];
-
-					find_min_result = find_minimum_sse128(buff, target_pos + 1, target_pos + 1 + window_size, sse_array);
-
-					if(find_min_result > target_value)
-						return std::min(size, target_pos + window_size);
-				}
-				else {
-					return std::min(size, target_pos + window_size);
-				}
-			}
+	else {
+		return cut_whole_chunks(buff, size, end_of_data, cuts, [this](char* chunk, uint64_t chunk_size) {
+			return find_cutpoint_simd<Vector, MAXIMUM>(chunk, chunk_size);
+		});
 	}
-	
-	return size;
 }
-#endif
 
-#ifdef __AVX2__
-uint64_t AE_Chunking::find_cutpoint_avx256(char* buff, uint64_t size) {
-	uint64_t target_pos = 0;
-	uint64_t return_pos_range_scan;
-	uint8_t find_max_result;
+template <class Vector, bool MAXIMUM>
+uint64_t AE_Chunking::find_cutpoint_simd(char* buff, uint64_t size) {
+	if constexpr (is_no_slide_vector<Vector>)
+		return find_cutpoint_noslide<Vector, MAXIMUM>(buff, size);
 
+	// A byte beyond the extreme value in the window after it replaces it
+	constexpr Scan_Op BEYOND = MAXIMUM ? Scan_Op::GT : Scan_Op::LT;
+	reset_block_extrema(buff, size);
+	uint64_t target_pos = 0;
 	uint8_t target_value = (uint8_t) buff[target_pos];
-	if(extreme_mode == AE_Mode::MAX){
-		while(target_pos < (size - window_size - 1)){
 
-			return_pos_range_scan = range_scan_gt_avx256(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-			if(return_pos_range_scan != target_pos + 1 + window_size){
-				target_pos = return_pos_range_scan;
-				target_value = (uint8_t) buff[target_pos];
+	while(target_pos + window_size < size){
+		uint64_t return_pos_range_scan = Vector::template range_scan<BEYOND>(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
+		if(return_pos_range_scan == target_pos + 1 + window_size)
+			return target_pos + window_size;
 
-				find_max_result = find_maximum_avx256(buff, target_pos + 1, target_pos + 1 + window_size, avx256_array);
+		target_pos = return_pos_range_scan;
+		target_value = (uint8_t) buff[target_pos];
 
-				if(find_max_result < target_value)
-					return std::min(size, target_pos + window_size);
-			}
-			else {
-				return std::min(size, target_pos + window_size);
-			}
-		}
+		// As in the native loop, a cut-point needs a whole window after the extreme value
+		if(target_pos + window_size >= size)
+			return size;
 
-		return size;
-	}
-	else if(extreme_mode == AE_Mode::MIN){
-			uint64_t target_pos = 0;
-			uint64_t return_pos_range_scan;
-			uint8_t find_min_result;
-			uint8_t target_value = (uint8_t) buff[target_pos];
-
-			while(target_pos < (size - window_size - 1)){
-				return_pos_range_scan = range_scan_lt_avx256(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-				if(return_pos_range_scan != target_pos + 1 + window_size){
-					target_pos = return_pos_range_scan;
-					target_value = (uint8_t) buff[target_pos];
-
-					find_min_result = find_minimum_avx256(buff, target_pos + 1, target_pos + 1 + window_size, avx256_array);
-
-					if(find_min_result > target_value)
-						return std::min(size, target_pos + window_size);
-				}
-				else {
-					return std::min(size, target_pos + window_size);
-				}
-			}
+		// The new extreme value is a cut-point if no byte of its window reaches it
+		if(MAXIMUM ? range_maximum(target_pos + 1, target_pos + 1 + window_size) < target_value
+		           : range_minimum(target_pos + 1, target_pos + 1 + window_size) > target_value)
+			return target_pos + window_size;
 	}
-	
+
 	return size;
 }
-#endif
 
-#if defined(__AVX512F__)
-uint64_t AE_Chunking::find_cutpoint_avx512(char* buff, uint64_t size) {
+template <class Vector, bool MAXIMUM>
+uint64_t AE_Chunking::find_cutpoint_noslide(char* buff, uint64_t size) {
+	constexpr Scan_Op REACHES = MAXIMUM ? Scan_Op::GEQ : Scan_Op::LEQ;
 	uint64_t target_pos = 0;
-	uint64_t return_pos_range_scan;
-	uint8_t find_max_result;
-
 	uint8_t target_value = (uint8_t) buff[target_pos];
-	if(extreme_mode == AE_Mode::MAX){
-		while(target_pos < (size - window_size - 1)){
 
-			return_pos_range_scan = range_scan_gt_avx512(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-			if(return_pos_range_scan != target_pos + 1 + window_size){
-				target_pos = return_pos_range_scan;
-				target_value = (uint8_t) buff[target_pos];
+	while(target_pos + window_size < size){
+		uint8_t window_value = Vector::template find_extremum<MAXIMUM>(buff, target_pos + 1, target_pos + 1 + window_size);
+		if(MAXIMUM ? window_value <= target_value : window_value >= target_value)
+			return target_pos + window_size;
 
-				find_max_result = find_maximum_avx512(buff, target_pos + 1, target_pos + 1 + window_size, avx512_array);
-
-				if(find_max_result < target_value)
-					return std::min(size, target_pos + window_size);
-			}
-			else {
-				return std::min(size, target_pos + window_size);
-			}
-		}
-
-		return size;
+		// Each byte replacing the extreme value before the first one reaching window_value still has that
+		// one in its window, so none of them is a cut-point
+		target_pos = Vector::template range_scan<REACHES>(buff, target_pos + 1, target_pos + 1 + window_size, window_value);
+		target_value = window_value;
 	}
-	else if(extreme_mode == AE_Mode::MIN){
-			uint64_t target_pos = 0;
-			uint64_t return_pos_range_scan;
-			uint8_t find_min_result;
-			uint8_t target_value = (uint8_t) buff[target_pos];
-
-			while(target_pos < (size - window_size - 1)){
-				return_pos_range_scan = range_scan_lt_avx512(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-				if(return_pos_range_scan != target_pos + 1 + window_size){
-					target_pos = return_pos_range_scan;
-					target_value = (uint8_t) buff[target_pos];
-
-					find_min_result = find_minimum_avx512(buff, target_pos + 1, target_pos + 1 + window_size, avx512_array);
-
-					if(find_min_result > target_value)
-						return std::min(size, target_pos + window_size);
-				}
-				else {
-					return std::min(size, target_pos + window_size);
-				}
-			}
-	}
-	
+
 	return size;
 }
-#endif
-
-#ifdef __ARM_NEON
-uint64_t AE_Chunking::find_cutpoint_neon(char* buff, uint64_t size) {
-	uint64_t target_pos = 0;
-	uint64_t return_pos_range_scan;
-	uint8_t find_max_result;
 
-	uint8_t target_value = (uint8_t) buff[target_pos];
-	if(extreme_mode == AE_Mode::MAX){
-		while(target_pos < (size - window_size - 1)){
-
-			return_pos_range_scan = range_scan_gt_neon(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-			if(return_pos_range_scan != target_pos + 1 + window_size){
-				target_pos = return_pos_range_scan;
-				target_value = (uint8_t) buff[target_pos];
-
-				find_max_result = find_maximum_neon(buff, target_pos + 1, target_pos + 1 + window_size, neon_array);
-
-				if(find_max_result < target_value)
-					{
-						return std::min(size, target_pos + window_size);
-					}
-			}
-			else {
-				return std::min(size, target_pos + window_size);
-			}
-		}
-
-		return size;
-	}
-	else if(extreme_mode == AE_Mode::MIN){
-			uint64_t target_pos = 0;
-			uint64_t return_pos_range_scan;
-			uint8_t find_min_result;
-			uint8_t target_value = (uint8_t) buff[target_pos];
-
-			while(target_pos < (size - window_size - 1)){
-				return_pos_range_scan = range_scan_lt_neon(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-				if(return_pos_range_scan != target_pos + 1 + window_size){
-					target_pos = return_pos_range_scan;
-					target_value = (uint8_t) buff[target_pos];
-
-					find_min_result = find_minimum_neon(buff, target_pos + 1, target_pos + 1 + window_size, neon_array);
-
-					if(find_min_result > target_value)
-						return std::min(size, target_pos + window_size);
-				}
-				else {
-					return std::min(size, target_pos + window_size);
-				}
-			}
-	}
-	
-	return size;
+template <bool MAXIMUM>
+uint64_t AE_Chunking::find_cutpoint_native(char* buff, uint64_t size) {
+    scan_pos = 0;
+    uint64_t cut = scan_native<MAXIMUM>(buff, size);
+    scan_pos = 0;
+    return cut;
 }
-#endif
 
-#ifdef __ALTIVEC__
-uint64_t AE_Chunking::find_cutpoint_altivec(char* buff, uint64_t size) {
-	uint64_t target_pos = 0;
-	uint64_t return_pos_range_scan;
-	uint8_t find_max_result;
+uint64_t AE_Chunking::resume_cutpoint(char* buff, uint64_t size, bool end_of_data) {
+    if (simd_mode != SIMD_Mode::NONE)
+        return Chunking_Technique::resume_cutpoint(buff, size, end_of_data);
+    return extreme_mode == MAX ? resume_native<true>(buff, size, end_of_data)
+                               : resume_native<false>(buff, size, end_of_data);
+}
 
-	uint8_t target_value = (uint8_t) buff[target_pos];
-	if(extreme_mode == AE_Mode::MAX){
-		while(target_pos < (size - window_size - 1)){
-
-			return_pos_range_scan = range_scan_gt_altivec(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-			if(return_pos_range_scan != target_pos + 1 + window_size){
-				target_pos = return_pos_range_scan;
-				target_value = (uint8_t) buff[target_pos];
-
-				find_max_result = find_maximum_altivec(buff, target_pos + 1, target_pos + 1 + window_size, altivec_array);
-
-				if(find_max_result < target_value)
-				{
-					return std::min(size, target_pos + window_size);
-				}
-			}
-			else {
-				return std::min(size, target_pos + window_size);
-			}
-		}
-
-		return size;
-	}
-	else if(extreme_mode == AE_Mode::MIN){
-			uint64_t target_pos = 0;
-			uint64_t return_pos_range_scan;
-			uint8_t find_min_result;
-			uint8_t target_value = (uint8_t) buff[target_pos];
-
-			while(target_pos < (size - window_size - 1)){
-				return_pos_range_scan = range_scan_lt_altivec(buff, target_pos + 1, target_pos + 1 + window_size, target_value);
-				if(return_pos_range_scan != target_pos + 1 + window_size){
-					target_pos = return_pos_range_scan;
-					target_value = (uint8_t) buff[target_pos];
-
-					find_min_result = find_minimum_altivec(buff, target_pos + 1, target_pos + 1 + window_size, altivec_array);
-
-					if(find_min_result > target_value)
-						return std::min(size, target_pos + window_size);
-				}
-				else {
-					return std::min(size, target_pos + window_size);
-				}
-			}
-	}
-	
-	return size;
+template <bool MAXIMUM>
+uint64_t AE_Chunking::resume_native(char* buff, uint64_t size, bool end_of_data) {
+    uint64_t cut = scan_native<MAXIMUM>(buff, size);
+    if (cut < size || end_of_data) {
+        scan_pos = 0;
+        return cut;
+    }
+    return 0;
 }
-#endif
 
-uint64_t AE_Chunking::find_cutpoint_native(char* buff, uint64_t size) {
-    uint32_t i = 0;
-    uint64_t max_value = buff[i];
-    uint64_t max_pos = i;
-    i++;
-    if(extreme_mode == MAX){
-	    while (i < size) {
-        	    if (!((uint64_t)buff[i] > max_value)) {
-                	if (i == max_pos + window_size)
-	                    return i;
-            		} 
-	    
-	    		else {
-		                max_value = buff[i];
-		                max_pos = i;
-		            }
-	            i++;
-        	}
-	}
-    else if(extreme_mode == MIN){
-    		while (i < size) {
-        	    if (!((uint64_t)buff[i] < max_value)) {
-                	if (i == max_pos + window_size)
-	                    return i;
-            		} 
-	    
-	    		else {
-		                max_value = buff[i];
-		                max_pos = i;
-		            }
-	            i++;
-        	}
+void AE_Chunking::reset_scan() {
+    scan_pos = 0;
+}
 
+template <bool MAXIMUM>
+uint64_t AE_Chunking::scan_native(char* buff, uint64_t size) {
+    uint64_t i = scan_pos;
+    uint64_t max_value = scan_value;
+    uint64_t max_pos = scan_value_pos;
+    if (i == 0) {
+        max_value = buff[i];
+        max_pos = i;
+        i++;
+    }
+    // The position closing the window of the extreme value, kept in a register
+    const uint64_t window = window_size;
+    uint64_t window_end = max_pos + window;
+    while (i < size) {
+	    // Past its first byte, no byte of a run replaces the extreme value, so the
+	    // scan resumes after the run unless the cut-point falls inside it
+	    Byte_Run run = find_run(buff, i, size);
+	    uint64_t segment_end = std::min(size, run.start + 1);
+	    while (i < segment_end) {
+		    if (!(MAXIMUM ? (uint64_t)buff[i] > max_value : (uint64_t)buff[i] < max_value)) {
+			    if (i == window_end)
+				    return i;
+		    }
+		    else {
+			    max_value = buff[i];
+			    max_pos = i;
+			    window_end = i + window;
+		    }
+		    i++;
+	    }
+	    if (i < run.end) {
+		    uint64_t after_run = skip_run(buff, run, size);
+		    if (window_end < after_run)
+			    return window_end;
+		    i = after_run;
+	    }
     }
     
+    scan_pos = i;
+    scan_value = max_value;
+    scan_value_pos = max_pos;
     return size;
 }
 
+template <class Vector, bool MAXIMUM>
+uint64_t AE_Chunking_Specialized<Vector, MAXIMUM>::find_cutpoint(char* buff, uint64_t size) {
+	if constexpr (std::is_void_v<Vector>)
+		return find_cutpoint_native<MAXIMUM>(buff, size);
+	else
+		return find_cutpoint_simd<Vector, MAXIMUM>(buff, size);
+}
+
+template <class Vector, bool MAXIMUM>
+uint64_t AE_Chunking_Specialized<Vector, MAXIMUM>::find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) {
+	return find_cutpoints_for<Vector, MAXIMUM>(buff, size, end_of_data, cuts);
+}
+
+template <class Vector, bool MAXIMUM>
+uint64_t AE_Chunking_Specialized<Vector, MAXIMUM>::resume_cutpoint(char* buff, uint64_t size, bool end_of_data) {
+	if constexpr (std::is_void_v<Vector>)
+		return resume_native<MAXIMUM>(buff, size, end_of_data);
+	else
+		return Chunking_Technique::resume_cutpoint(buff, size, end_of_data);
+}
+
+#define AE_CHUNKING_SPECIALIZATIONS(VECTOR) \
+	template class AE_Chunking_Specialized<VECTOR, true>; \
+	template class AE_Chunking_Specialized<VECTOR, false>;
+AE_CHUNKING_SPECIALIZATIONS(void)
+FOR_EACH_SIMD_VECTOR(AE_CHUNKING_SPECIALIZATIONS)
@@ -0,0 +1,272 @@
+/**
+ * @file autotune.cpp
+ * @author WASL
+ * @brief Implementation of the startup calibration of the SIMD mode and buffer size
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "autotune.hpp"
+#include "simd_dispatch.hpp"
+#include "xxhash_hashing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+extern bool disable_hashing;
+
+// Candidates in the order simd_mode=auto prefers them. auto never picks the no-slide modes, so they are tried
+// after the modes it may pick
+static const SIMD_Mode AUTOTUNE_SIMD_MODES[] = {SIMD_Mode::AVX512, SIMD_Mode::AVX256,
+                                                SIMD_Mode::SSE128, SIMD_Mode::NEON,
+                                                SIMD_Mode::ALTIVEC, SIMD_Mode::AVX512_NOSLIDE,
+                                                SIMD_Mode::AVX256_NOSLIDE, SIMD_Mode::SSE128_NOSLIDE,
+                                                SIMD_Mode::NONE};
+
+static const uint64_t AUTOTUNE_BUFFER_SIZES[] = {16 * 1024, 32 * 1024, 64 * 1024, 128 * 1024,
+                                                 256 * 1024, 512 * 1024, 1024 * 1024};
+
+static std::string cpu_model_name() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            size_t idx = line.find(':');
+            if (idx != std::string::npos && idx + 2 <= line.length()) {
+                return line.substr(idx + 2);
+            }
+        }
+    }
+    return "unknown cpu";
+}
+
+static void append_file_sample(std::string& data, const std::string& file_path) {
+    std::ifstream file(file_path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    uint64_t bytes = std::min((uint64_t)AUTOTUNE_SAMPLE_BYTES_PER_FILE,
+                              AUTOTUNE_SAMPLE_BYTES - (data.length() - AUTOTUNE_RANDOM_BYTES - AUTOTUNE_ZERO_BYTES));
+    std::vector<char> buffer(bytes);
+    file.read(buffer.data(), bytes);
+    data.append(buffer.data(), file.gcount());
+}
+
+/**
+ * @brief Builds the calibration data: random bytes, zero bytes (long runs
+ * reach the maximum chunk size or the end of the buffer) and the first bytes
+ * of the input files
+ */
+static std::string calibration_data(const std::string& input_path, bool manifest_mode) {
+    std::string data;
+    data.reserve(AUTOTUNE_RANDOM_BYTES + AUTOTUNE_ZERO_BYTES + AUTOTUNE_SAMPLE_BYTES);
+    std::mt19937_64 generator(42);
+    for (uint64_t i = 0; i < AUTOTUNE_RANDOM_BYTES; i += sizeof(uint64_t)) {
+        uint64_t value = generator();
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    data.append(AUTOTUNE_ZERO_BYTES, '\0');
+
+    const uint64_t full_size = AUTOTUNE_RANDOM_BYTES + AUTOTUNE_ZERO_BYTES + AUTOTUNE_SAMPLE_BYTES;
+    std::error_code error;
+    if (manifest_mode) {
+        std::ifstream manifest(input_path);
+        std::string line;
+        while (data.length() < full_size && std::getline(manifest, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::string file_path = line.substr(0, line.find('\t'));
+            if (std::filesystem::is_regular_file(file_path, error)) {
+                append_file_sample(data, file_path);
+            }
+        }
+    } else if (std::filesystem::is_directory(input_path, error)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(
+                 input_path, std::filesystem::directory_options::skip_permission_denied, error)) {
+            if (data.length() >= full_size) {
+                break;
+            }
+            if (entry.is_regular_file(error)) {
+                append_file_sample(data, entry.path().string());
+            }
+        }
+    }
+    return data;
+}
+
+static bool load_profile(const std::string& profile_file, const std::string& key,
+                         SIMD_Mode& mode, uint64_t& buffer_size) {
+    std::ifstream in_file(profile_file);
+    std::string line;
+    while (std::getline(in_file, line)) {
+        size_t idx = line.rfind('\t');
+        if (idx == std::string::npos || line.substr(0, idx) != key) {
+            continue;
+        }
+        std::istringstream values(line.substr(idx + 1));
+        std::string mode_name;
+        if (!(values >> mode_name >> buffer_size)) {
+            return false;
+        }
+        for (SIMD_Mode candidate : AUTOTUNE_SIMD_MODES) {
+            if (mode_name == simd_mode_name(candidate)) {
+                mode = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+    return false;
+}
+
+static void save_profile(const std::string& profile_file, const std::string& key,
+                         SIMD_Mode mode, uint64_t buffer_size) {
+    // Keep the entries of other CPUs and chunkers, replace the one of this run
+    std::vector<std::string> lines;
+    std::ifstream in_file(profile_file);
+    std::string line;
+    while (std::getline(in_file, line)) {
+        size_t idx = line.rfind('\t');
+        if (idx != std::string::npos && line.substr(0, idx) != key) {
+            lines.push_back(line);
+        }
+    }
+    in_file.close();
+    std::ostringstream entry;
+    entry << key << '\t' << simd_mode_name(mode) << ' ' << buffer_size;
+    lines.push_back(entry.str());
+
+    // Write a temporary file and rename it, so concurrent runs never read a partial profile
+    std::string tmp_file = profile_file + ".tmp";
+    std::ofstream out_file(tmp_file, std::ios::out | std::ios::trunc);
+    for (const auto& profile_line : lines) {
+        out_file << profile_line << '\n';
+    }
+    out_file.close();
+    std::error_code error;
+    if (!out_file.fail()) {
+        std::filesystem::rename(tmp_file, profile_file, error);
+    }
+    if (out_file.fail() || error) {
+        std::cerr << "Failed to write autotune profile " << profile_file << std::endl;
+    }
+}
+
+/**
+ * @brief Chunks the calibration data AUTOTUNE_ROUNDS times
+ * @return: chunking time of the fastest round in milliseconds
+ */
+static double time_chunking(Chunking_Technique& chunk_method, const std::string& data,
+                            std::vector<std::string>& hashes) {
+    double best_time = 0;
+    for (int round = 0; round < AUTOTUNE_ROUNDS; round++) {
+        std::istringstream stream(data);
+        std::vector<std::string> round_hashes;
+        chunk_method.total_time_chunking = std::chrono::duration<double, std::milli>::zero();
+        chunk_method.chunk_stream(round_hashes, stream, data.length(), data.length());
+        double time = chunk_method.total_time_chunking.count();
+        if (round == 0 || time < best_time) {
+            best_time = time;
+        }
+        if (round == 0) {
+            hashes = std::move(round_hashes);
+        }
+    }
+    return best_time;
+}
+
+Autotune_Result autotune_chunking(Config& config, const std::string& input_path, bool manifest_mode,
+                                  const Chunking_Technique_Factory& create_chunking_technique) {
+    // A buffer size of 0 makes chunk_stream use 1 MiB buffers
+    uint64_t configured_buffer_size = config.get_buffer_size();
+    if (configured_buffer_size == 0) {
+        configured_buffer_size = 1024 * 1024;
+    }
+    const std::string profile_file = config.get_autotune_profile();
+    const std::string key = cpu_model_name() + '\t' + config.get_chunking_signature();
+
+    // Constructing a technique with a mode its kernels cannot run exits, so only supported modes are tried
+    config.set_simd_mode(SIMD_Mode::NONE);
+    std::unique_ptr<Chunking_Technique> probe = create_chunking_technique(config);
+    std::vector<SIMD_Mode> modes;
+    for (SIMD_Mode mode : AUTOTUNE_SIMD_MODES) {
+        if (probe->supports_simd_mode(mode)) {
+            modes.push_back(mode);
+        }
+    }
+    probe.reset();
+
+    Autotune_Result result = {modes.front(), configured_buffer_size, 0};
+    if (!profile_file.empty() &&
+        load_profile(profile_file, key, result.simd_mode, result.buffer_size) &&
+        std::find(modes.begin(), modes.end(), result.simd_mode) != modes.end()) {
+        std::cout << "Autotune: simd_mode=" << simd_mode_name(result.simd_mode)
+                  << " buffer_size=" << result.buffer_size << " (from " << profile_file << ")"
+                  << std::endl;
+        config.set_simd_mode(result.simd_mode);
+        config.set_buffer_size(result.buffer_size);
+        return result;
+    }
+
+    std::vector<uint64_t> buffer_sizes = {configured_buffer_size};
+    for (uint64_t buffer_size : AUTOTUNE_BUFFER_SIZES) {
+        if (buffer_size != configured_buffer_size) {
+            buffer_sizes.push_back(buffer_size);
+        }
+    }
+
+    // Boundaries are compared through the chunk hashes, also when only chunking
+    bool hashing_disabled = disable_hashing;
+    disable_hashing = false;
+    const std::string data = calibration_data(input_path, manifest_mode);
+    const double data_mb = (double)data.length() / (1024 * 1024);
+    std::cout << "Autotune: timing on " << data.length() << " bytes" << std::endl;
+
+    // The first combination is what simd_mode=auto runs, the others must give its chunks
+    std::vector<std::string> reference_hashes;
+    double best_time = 0;
+    for (SIMD_Mode mode : modes) {
+        for (uint64_t buffer_size : buffer_sizes) {
+            config.set_simd_mode(mode);
+            config.set_buffer_size(buffer_size);
+            std::unique_ptr<Chunking_Technique> chunk_method = create_chunking_technique(config);
+            chunk_method->hash_method = std::make_unique<XXHash_Hashing>();
+            chunk_method->stream_buffer_size = buffer_size;
+
+            std::vector<std::string> hashes;
+            double time = time_chunking(*chunk_method, data, hashes);
+            std::cout << "\t" << simd_mode_name(mode) << " buffer_size=" << buffer_size << ": ";
+            if (reference_hashes.empty()) {
+                reference_hashes = std::move(hashes);
+            } else if (hashes != reference_hashes) {
+                std::cout << "skipped, changes the chunk boundaries" << std::endl;
+                continue;
+            }
+            std::cout << data_mb / (time / 1000) << " MB/sec" << std::endl;
+            if (best_time == 0 || time < best_time) {
+                best_time = time;
+                result = {mode, buffer_size, data_mb / (time / 1000)};
+            }
+        }
+    }
+    disable_hashing = hashing_disabled;
+
+    std::cout << "Autotune: simd_mode=" << simd_mode_name(result.simd_mode)
+              << " buffer_size=" << result.buffer_size << " (" << result.throughput << " MB/sec)"
+              << std::endl;
+    if (!profile_file.empty()) {
+        save_profile(profile_file, key, result.simd_mode, result.buffer_size);
+    }
+    config.set_simd_mode(result.simd_mode);
+    config.set_buffer_size(result.buffer_size);
+    return result;
+}
@@ -14,6 +14,7 @@
 #include "chunking_common.hpp"
 #include "hashing_common.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <filesystem>
@@ -22,1387 +23,1236 @@
 #include <memory>
 #include <string>
 
+// Each kernel is compiled for its own instruction set (see simd_dispatch.hpp).
+
 /**
- * * @brief: Helper functions to find maximum value in a region of the data stream
- * * @param buff Data Stream
- * * @param start_pos Starting position of scanned region
- * * @param end_pos Ending position of scanned region
- * * @param xmm_array Array of XMM registers to store intermediate results
- * * @return uint8_t Maximum Value
+ * * @brief: Block summaries shared by the extreme-value chunkers. The kernel of simd_mode (see simd_kernels.hpp)
+ * * reduces the EXTREMA_BLOCK_SIZE bytes of a block to their maximum and minimum in one pass over the data.
+ * * Range queries then combine the summaries of the blocks they cover with the bytes of at most 2 partial blocks.
  */
 
-#if defined(__SSE3__)
-uint8_t AVX_Chunking_Technique::find_maximum_sse128(char *buff, uint64_t start_pos, uint64_t end_pos, __m128i *xmm_array){
-
-    // Assume window_size is a multiple of SSE_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / SSE_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into __m128i structures
-    // Could be optimized later as only 16 xmm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        xmm_array[i] = _mm_loadu_si128((__m128i const *)(buff + start_pos + (SSE_REGISTER_SIZE_BYTES * i)));
-    
-    // Repeat vmaxu until a single register is remaining with maximum values
-    // Each iteration calculates maximums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the maximum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            xmm_array[i] = _mm_max_epu8(xmm_array[i], xmm_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
-    }
-
-    // Move the final set of values from the xmm into local memory    
-    uint8_t result_store[SSE_REGISTER_SIZE_BYTES] = {0};
-
-    _mm_storeu_si128((__m128i *)&result_store, xmm_array[0]);
+template <bool MAXIMUM>
+static inline uint8_t reduce_bytes(const uint8_t *bytes, uint64_t start_pos, uint64_t end_pos, uint8_t value){
+    for(uint64_t i = start_pos; i < end_pos; i++)
+        value = MAXIMUM ? std::max(value, bytes[i]) : std::min(value, bytes[i]);
+    return value;
+}
 
-    // Sequentially scan the last remaining bytes (128 in this case) to find the max value
-    uint8_t max_val = 0;
-    for(uint64_t i = 0; i < SSE_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] > max_val)
-            max_val = result_store[i];
+void AVX_Chunking_Technique::reset_block_extrema(const char *buff, uint64_t size){
+    block_extrema.buff = buff;
+    block_extrema.num_blocks = size / EXTREMA_BLOCK_SIZE;
+    block_extrema.first = 0;
+    block_extrema.end = 0;
+    if(block_extrema.max.size() < block_extrema.num_blocks){
+        block_extrema.max.resize(block_extrema.num_blocks);
+        block_extrema.min.resize(block_extrema.num_blocks);
     }
-
-    // Return maximum value
-    return max_val;
 }
-#endif
 
-#if defined(__AVX2__)
-uint8_t AVX_Chunking_Technique::find_maximum_avx256(char *buff, uint64_t start_pos, uint64_t end_pos, __m256i *xmm_array){
-
-    // Assume window_size is a multiple of AVX256_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / AVX256_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into __m256i structures
-    // Could be optimized later as only 16 xmm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        xmm_array[i] = _mm256_loadu_si256((__m256i const *)(buff + start_pos + (AVX256_REGISTER_SIZE_BYTES * i)));
-    
-    // Repeat vmaxu until a single register is remaining with maximum values
-    // Each iteration calculates maximums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the maximum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            xmm_array[i] = _mm256_max_epu8(xmm_array[i], xmm_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+void AVX_Chunking_Technique::summarize_blocks(uint64_t first_block, uint64_t end_block){
+    // Queries move forward through the data: a region outside the summarized blocks starts them again
+    if(first_block < block_extrema.first || first_block > block_extrema.end){
+        block_extrema.first = first_block;
+        block_extrema.end = first_block;
     }
-
-    // Move the final set of values from the xmm into local memory    
-    uint8_t result_store[AVX256_REGISTER_SIZE_BYTES] = {0};
-
-    _mm256_storeu_si256((__m256i *)&result_store, xmm_array[0]);
-
-    // Sequentially scan the last remaining bytes (256 in this case) to find the max value
-    uint8_t max_val = 0;
-    for(uint64_t i = 0; i < AVX256_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] > max_val)
-            max_val = result_store[i];
+    if(end_block <= block_extrema.end){
+        return;
     }
-
-    // Return maximum value
-    return max_val;
-}
-#endif
-
-#if defined(__AVX512F__)
-uint8_t AVX_Chunking_Technique::find_maximum_avx512(char *buff, uint64_t start_pos, uint64_t end_pos, __m512i *xmm_array){
-
-    // Assume window_size is a multiple of AVX512_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    __mmask64 cmp_mask = UINT64_MAX;
-
-    uint64_t num_vectors = (end_pos - start_pos) / AVX512_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into __m512i structures
-    // Could be optimized later as only 16 xmm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        xmm_array[i] = _mm512_loadu_si512((__m512i const *)(buff + start_pos + (AVX512_REGISTER_SIZE_BYTES * i)));
-    
-    // Repeat vmaxu until a single register is remaining with maximum values
-    // Each iteration calculates maximums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the maximum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            xmm_array[i] = _mm512_maskz_max_epu8(cmp_mask, xmm_array[i], xmm_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+    const char *buff = block_extrema.buff;
+    uint64_t start = block_extrema.end;
+    uint8_t *max = block_extrema.max.data();
+    uint8_t *min = block_extrema.min.data();
+    switch(simd_mode){
+        #if defined(SIMD_SSE128_KERNELS)
+        case SIMD_Mode::SSE128:
+        case SIMD_Mode::SSE128_NOSLIDE:
+            SSE128_Vector::summarize_blocks(buff, start, end_block, max, min);
+            break;
+        #endif
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+        case SIMD_Mode::AVX256_NOSLIDE:
+            AVX256_Vector::summarize_blocks(buff, start, end_block, max, min);
+            break;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+        case SIMD_Mode::AVX512_NOSLIDE:
+            AVX512_Vector::summarize_blocks(buff, start, end_block, max, min);
+            break;
+        #endif
+        #if defined(SIMD_NEON_KERNELS)
+        case SIMD_Mode::NEON:
+            NEON_Vector::summarize_blocks(buff, start, end_block, max, min);
+            break;
+        #endif
+        #if defined(SIMD_ALTIVEC_KERNELS)
+        case SIMD_Mode::ALTIVEC:
+            ALTIVEC_Vector::summarize_blocks(buff, start, end_block, max, min);
+            break;
+        #endif
+        default:
+            for(uint64_t block = start; block < end_block; block++){
+                const uint8_t *data = (const uint8_t *)buff + block * EXTREMA_BLOCK_SIZE;
+                max[block] = *std::max_element(data, data + EXTREMA_BLOCK_SIZE);
+                min[block] = *std::min_element(data, data + EXTREMA_BLOCK_SIZE);
+            }
     }
+    block_extrema.end = end_block;
+}
 
-    // Move the final set of values from the xmm into local memory    
-    uint8_t result_store[AVX512_REGISTER_SIZE_BYTES] = {0};
+uint8_t AVX_Chunking_Technique::range_maximum(uint64_t start_pos, uint64_t end_pos){
+    const uint8_t *bytes = (const uint8_t *)block_extrema.buff;
+    uint64_t first_block = (start_pos + EXTREMA_BLOCK_SIZE - 1) / EXTREMA_BLOCK_SIZE;
+    uint64_t end_block = std::min(end_pos / EXTREMA_BLOCK_SIZE, block_extrema.num_blocks);
+    if(first_block >= end_block)
+        return reduce_bytes<true>(bytes, start_pos, end_pos, 0);
+
+    summarize_blocks(first_block, end_block);
+    uint8_t max_value = reduce_bytes<true>(bytes, start_pos, first_block * EXTREMA_BLOCK_SIZE, 0);
+    max_value = reduce_bytes<true>(block_extrema.max.data(), first_block, end_block, max_value);
+    return reduce_bytes<true>(bytes, end_block * EXTREMA_BLOCK_SIZE, end_pos, max_value);
+}
 
-    _mm512_storeu_si512((__m512i *)&result_store, xmm_array[0]);
+uint8_t AVX_Chunking_Technique::range_minimum(uint64_t start_pos, uint64_t end_pos){
+    const uint8_t *bytes = (const uint8_t *)block_extrema.buff;
+    uint64_t first_block = (start_pos + EXTREMA_BLOCK_SIZE - 1) / EXTREMA_BLOCK_SIZE;
+    uint64_t end_block = std::min(end_pos / EXTREMA_BLOCK_SIZE, block_extrema.num_blocks);
+    if(first_block >= end_block)
+        return reduce_bytes<false>(bytes, start_pos, end_pos, UINT8_MAX);
+
+    summarize_blocks(first_block, end_block);
+    uint8_t min_value = reduce_bytes<false>(bytes, start_pos, first_block * EXTREMA_BLOCK_SIZE, UINT8_MAX);
+    min_value = reduce_bytes<false>(block_extrema.min.data(), first_block, end_block, min_value);
+    return reduce_bytes<false>(bytes, end_block * EXTREMA_BLOCK_SIZE, end_pos, min_value);
+}
 
-    // Sequentially scan the last remaining bytes (512 in this case) to find the max value
-    uint8_t max_val = 0;
-    for(uint64_t i = 0; i < AVX512_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] > max_val)
-            max_val = result_store[i];
-    }
+/**
+ * * @brief: Run detection shared by the chunkers skipping runs of equal bytes. The kernel of simd_mode checks a
+ * * block of RUN_SKIP_BLOCK_SIZE bytes against its first byte in a few compares, without a kernel 8 bytes are
+ * * compared at a time.
+ */
 
-    // Return maximum value
-    return max_val;
+static inline uint64_t repeated_byte_word(uint8_t value){
+    return 0x0101010101010101ULL * value;
 }
-#endif
 
-#if defined(__ARM_NEON)
-uint8_t AVX_Chunking_Technique::find_maximum_neon(char *buff, uint64_t start_pos, uint64_t end_pos, uint8x16_t *neon_array){
-
-    // Assume window_size is a multiple of NEON_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / NEON_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into uint8x16_t structures
-    // Could be optimized later as only 16 mm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        neon_array[i] = vld1q_u8((uint8_t const *)(buff + start_pos + (NEON_REGISTER_SIZE_BYTES * i)));
-
-    // Repeat vmaxu until a single register is remaining with maximum values
-    // Each iteration calculates maximums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the maximum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            neon_array[i] = vmaxq_u8(neon_array[i], neon_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+static uint64_t find_uniform_block_native(const char *buff, uint64_t start, uint64_t end){
+    for(uint64_t block = start; block + RUN_SKIP_BLOCK_SIZE <= end; block += RUN_SKIP_BLOCK_SIZE){
+        uint64_t pattern = repeated_byte_word((uint8_t)buff[block]);
+        uint64_t differ = 0;
+        for(uint64_t i = 0; i < RUN_SKIP_BLOCK_SIZE; i += sizeof(uint64_t)){
+            uint64_t word;
+            std::memcpy(&word, buff + block + i, sizeof(uint64_t));
+            differ |= word ^ pattern;
+        }
+        if(!differ)
+            return block;
     }
+    return end;
+}
 
-    // Move the final set of values from the NEON into local memory
-    uint8_t result_store[NEON_REGISTER_SIZE_BYTES] = {0};
-    vst1q_u8((uint8_t *)&result_store, neon_array[0]);
-    
-    // Sequentially scan the last remaining bytes (16 in this case) to find the max value
-    uint8_t max_val = 0;
-    for(uint64_t i = 0; i < NEON_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] > max_val)
-            max_val = result_store[i];
+Byte_Run AVX_Chunking_Technique::find_run(const char *buff, uint64_t start, uint64_t end){
+    if(!run_skip)
+        return {end, end};
+
+    uint64_t stop = std::min(end, start + RUN_SKIP_LOOKAHEAD);
+    uint64_t block;
+    switch(simd_mode){
+        #if defined(SIMD_SSE128_KERNELS)
+        case SIMD_Mode::SSE128:
+        case SIMD_Mode::SSE128_NOSLIDE:
+            block = SSE128_Vector::find_uniform_block(buff, start, stop);
+            break;
+        #endif
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+        case SIMD_Mode::AVX256_NOSLIDE:
+            block = AVX256_Vector::find_uniform_block(buff, start, stop);
+            break;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+        case SIMD_Mode::AVX512_NOSLIDE:
+            block = AVX512_Vector::find_uniform_block(buff, start, stop);
+            break;
+        #endif
+        #if defined(SIMD_NEON_KERNELS)
+        case SIMD_Mode::NEON:
+            block = NEON_Vector::find_uniform_block(buff, start, stop);
+            break;
+        #endif
+        #if defined(SIMD_ALTIVEC_KERNELS)
+        case SIMD_Mode::ALTIVEC:
+            block = ALTIVEC_Vector::find_uniform_block(buff, start, stop);
+            break;
+        #endif
+        default:
+            block = find_uniform_block_native(buff, start, stop);
     }
-    // Return maximum value
-    return max_val;
+    if(block == stop)
+        return {stop, stop};
+
+    uint8_t value = (uint8_t)buff[block];
+    uint64_t run_start = block;
+    while(run_start > start && (uint8_t)buff[run_start - 1] == value)
+        run_start--;
+    return {run_start, block + RUN_SKIP_BLOCK_SIZE};
+}
 
+uint64_t AVX_Chunking_Technique::skip_run(const char *buff, const Byte_Run &run, uint64_t end){
+    if(run.start == run.end)
+        return run.end;
+    return run_end(buff, run.end, end, (uint8_t)buff[run.start]);
 }
-#endif
 
-#if defined(__ALTIVEC__)
-uint8_t AVX_Chunking_Technique::find_maximum_altivec(char *buff, uint64_t start_pos, uint64_t end_pos, __vector unsigned char *vec_array){
-
-    // Assume window_size is a multiple of ALTIVEC_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / ALTIVEC_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into vector unsigned char structures
-    // Could be optimized later as only 32 vec registers are available per CPU
-    for(uint64_t i = 0; i < num_vectors; i++)
-        vec_array[i] = vec_xl(0, (unsigned char const *)(buff + start_pos + (ALTIVEC_REGISTER_SIZE_BYTES * i)));
-
-    // Repeat vmaxu until a single register is remaining with maximum values
-    // Each iteration calculates maximums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the maximum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            vec_array[i] = vec_max(vec_array[i], vec_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+uint64_t AVX_Chunking_Technique::run_end(const char *buff, uint64_t start, uint64_t end, uint8_t value){
+    switch(simd_mode){
+        #if defined(SIMD_SSE128_KERNELS)
+        case SIMD_Mode::SSE128:
+        case SIMD_Mode::SSE128_NOSLIDE:
+            return SSE128_Vector::range_scan<Scan_Op::NEQ>(buff, start, end, value);
+        #endif
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+        case SIMD_Mode::AVX256_NOSLIDE:
+            return AVX256_Vector::range_scan<Scan_Op::NEQ>(buff, start, end, value);
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+        case SIMD_Mode::AVX512_NOSLIDE:
+            return AVX512_Vector::range_scan<Scan_Op::NEQ>(buff, start, end, value);
+        #endif
+        #if defined(SIMD_NEON_KERNELS)
+        case SIMD_Mode::NEON:
+            return NEON_Vector::range_scan<Scan_Op::NEQ>(buff, start, end, value);
+        #endif
+        #if defined(SIMD_ALTIVEC_KERNELS)
+        case SIMD_Mode::ALTIVEC:
+            return ALTIVEC_Vector::range_scan<Scan_Op::NEQ>(buff, start, end, value);
+        #endif
+        default:
+            break;
     }
 
-    // Move the final set of values from the vec into local memory    
-    unsigned char result_store[ALTIVEC_REGISTER_SIZE_BYTES] = {0};
-
-    vec_st(vec_array[0], 0, (unsigned char *)&result_store);
-
-    // Sequentially scan the last remaining bytes (16 in this case) to find the max value
-    uint8_t max_val = 0;
-    for(uint64_t i = 0; i < ALTIVEC_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] > max_val)
-            max_val = result_store[i];
+    // The word holding the first different byte is then searched byte by byte
+    uint64_t pattern = repeated_byte_word(value);
+    uint64_t pos = start;
+    for(; pos + sizeof(uint64_t) <= end; pos += sizeof(uint64_t)){
+        uint64_t word;
+        std::memcpy(&word, buff + pos, sizeof(uint64_t));
+        if(word != pattern)
+            break;
     }
-
-    // Return maximum value
-    return max_val;
+    while(pos < end && (uint8_t)buff[pos] == value)
+        pos++;
+    return pos;
 }
-#endif
 
 /**
- * @brief: Helper functions to find minimum value in data stream
- * * @param buff Data Stream
- * * @param start_pos Starting position of scanned region
- * * @param end_pos Ending position of scanned region
- * * @param xmm_array Array of SIMD registers to store intermediate results
- * * @return uint8_t Minimum Value
+ * * @brief: Gear hash kernels. Lane j hashes the positions [start + j * lane_span, start + (j + 1) * lane_span),
+ * * 8 bytes are gathered per lane at a time and each byte indexes the gear table with a second gather.
+ * * The hash shifts out the bytes older than GEAR_HASH_WINDOW_SIZE, so each lane first hashes the
+ * * GEAR_HASH_WINDOW_SIZE bytes preceding its span and then gives the hash of the full window at every position.
  */
 
- #if defined(__SSE3__)
- uint8_t AVX_Chunking_Technique::find_minimum_sse128(char *buff, uint64_t start_pos, uint64_t end_pos, __m128i *xmm_array){
-
-    // Assume window_size is a multiple of SSE_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / SSE_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into __m128i structures
-    // Could be optimized later as only 16 xmm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        xmm_array[i] = _mm_loadu_si128((__m128i const *)(buff + start_pos + (SSE_REGISTER_SIZE_BYTES * i)));
-    
-    // Repeat vminu until a single register is remaining with minimum values
-    // Each iteration calculates minimums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the minimum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            xmm_array[i] = _mm_min_epu8(xmm_array[i], xmm_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
-    }
-
-    // Move the final set of values from the xmm into local memory    
-    uint8_t result_store[SSE_REGISTER_SIZE_BYTES] = {0};
-
-    _mm_storeu_si128((__m128i *)&result_store, xmm_array[0]);
-
-    // Sequentially scan the last remaining bytes (128 in this case) to find the min value
-    uint8_t min_val = UINT8_MAX;
-    for(uint64_t i = 0; i < SSE_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] < min_val)
-            min_val = result_store[i];
-    }
-
-    // Return minimum value
-    return min_val;
+#if defined(SIMD_AVX256_KERNELS)
+SIMD_TARGET_AVX256 static inline __m256i gear_step_avx256(__m256i hash, __m256i bytes, const long long *gear_table){
+    __m256i entry = _mm256_i64gather_epi64(gear_table, _mm256_and_si256(bytes, _mm256_set1_epi64x(0xFF)), 8);
+    return _mm256_add_epi64(_mm256_slli_epi64(hash, 1), entry);
 }
-#endif
 
-#if defined(__AVX2__)
-uint8_t AVX_Chunking_Technique::find_minimum_avx256(char *buff, uint64_t start_pos, uint64_t end_pos, __m256i *xmm_array){
-
-    // Assume window_size is a multiple of AVX256_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / AVX256_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into __m256i structures
-    // Could be optimized later as only 16 xmm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        xmm_array[i] = _mm256_loadu_si256((__m256i const *)(buff + start_pos + (AVX256_REGISTER_SIZE_BYTES * i)));
-    
-    // Repeat vminu until a single register is remaining with minimum values
-    // Each iteration calculates minimums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the minimum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            xmm_array[i] = _mm256_min_epu8(xmm_array[i], xmm_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+// NUM_MASKS is a template parameter so the single mask kernel does not test a second mask
+template <int NUM_MASKS>
+SIMD_TARGET_AVX256 static void mark_gear_candidates_avx256_impl(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                const uint64_t *gear_table, const uint64_t *masks, uint64_t **words){
+    const long long *table = (const long long *)gear_table;
+    const long long *data = (const long long *)buff;
+    const uint64_t words_per_lane = lane_span / 64;
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i mask_vec[NUM_MASKS];
+    for(int m = 0; m < NUM_MASKS; m++){
+        mask_vec[m] = _mm256_set1_epi64x(masks[m]);
     }
-
-    // Move the final set of values from the xmm into local memory    
-    uint8_t result_store[AVX256_REGISTER_SIZE_BYTES] = {0};
-
-    _mm256_storeu_si256((__m256i *)&result_store, xmm_array[0]);
-
-    // Sequentially scan the last remaining bytes (256 in this case) to find the min value
-    uint8_t min_val = UINT8_MAX;
-    for(uint64_t i = 0; i < AVX256_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] < min_val)
-            min_val = result_store[i];
+    alignas(32) uint64_t lane_words[AVX256_REGISTER_SIZE_INT64];
+
+    // Position of the next 8 bytes of each lane
+    __m256i pos = _mm256_set_epi64x(3 * lane_span, 2 * lane_span, lane_span, 0);
+    pos = _mm256_add_epi64(pos, _mm256_set1_epi64x(start - GEAR_HASH_WINDOW_SIZE));
+    const __m256i group_step = _mm256_set1_epi64x(8);
+    __m256i hash = zero;
+
+    for(uint64_t i = 0; i < GEAR_HASH_WINDOW_SIZE / 8; i++){
+        __m256i bytes = _mm256_i64gather_epi64(data, pos, 1);
+        pos = _mm256_add_epi64(pos, group_step);
+        for(int k = 0; k < 8; k++){
+            hash = gear_step_avx256(hash, bytes, table);
+            bytes = _mm256_srli_epi64(bytes, 8);
+        }
     }
 
-    // Return minimum value
-    return min_val;
-}
-#endif
-
-#if defined(__AVX512F__)
-uint8_t AVX_Chunking_Technique::find_minimum_avx512(char *buff, uint64_t start_pos, uint64_t end_pos, __m512i *xmm_array){
-
-    // Assume window_size is a multiple of AVX512_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / AVX512_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into __m512i structures
-    // Could be optimized later as only 16 xmm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        xmm_array[i] = _mm512_loadu_si512((__m512i const *)(buff + start_pos + (AVX512_REGISTER_SIZE_BYTES * i)));
-    
-    // Repeat vminu until a single register is remaining with minimum values
-    // Each iteration calculates minimums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the minimum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            xmm_array[i] = _mm512_maskz_min_epu8(UINT64_MAX, xmm_array[i], xmm_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+    for(uint64_t w = 0; w < words_per_lane; w++){
+        __m256i word[NUM_MASKS];
+        for(int m = 0; m < NUM_MASKS; m++){
+            word[m] = zero;
+        }
+        __m256i bit = _mm256_set1_epi64x(1);
+        for(int group = 0; group < 8; group++){
+            __m256i bytes = _mm256_i64gather_epi64(data, pos, 1);
+            pos = _mm256_add_epi64(pos, group_step);
+            for(int k = 0; k < 8; k++){
+                hash = gear_step_avx256(hash, bytes, table);
+                bytes = _mm256_srli_epi64(bytes, 8);
+                for(int m = 0; m < NUM_MASKS; m++){
+                    // All ones in the lanes where (hash & mask) == 0
+                    __m256i match = _mm256_cmpeq_epi64(_mm256_and_si256(hash, mask_vec[m]), zero);
+                    word[m] = _mm256_or_si256(word[m], _mm256_and_si256(match, bit));
+                }
+                bit = _mm256_slli_epi64(bit, 1);
+            }
+        }
+        for(int m = 0; m < NUM_MASKS; m++){
+            _mm256_store_si256((__m256i *)lane_words, word[m]);
+            for(uint64_t lane = 0; lane < AVX256_REGISTER_SIZE_INT64; lane++){
+                words[m][lane * words_per_lane + w] = lane_words[lane];
+            }
+        }
     }
+}
 
-    // Move the final set of values from the xmm into local memory    
-    uint8_t result_store[AVX512_REGISTER_SIZE_BYTES] = {0};
-
-    _mm512_storeu_si512((__m512i *)&result_store, xmm_array[0]);
-
-    // Sequentially scan the last remaining bytes (512 in this case) to find the min value
-    uint8_t min_val = UINT8_MAX;
-    for(uint64_t i = 0; i < AVX512_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] < min_val)
-            min_val = result_store[i];
+SIMD_TARGET_AVX256 void AVX_Chunking_Technique::mark_gear_candidates_avx256(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *gear_table,
+                                                                            const uint64_t *masks, uint64_t num_masks, uint64_t **words){
+    if(num_masks == 1){
+        mark_gear_candidates_avx256_impl<1>(buff, start, lane_span, gear_table, masks, words);
+    } else {
+        mark_gear_candidates_avx256_impl<2>(buff, start, lane_span, gear_table, masks, words);
     }
-
-    // Return minimum value
-    return min_val;
 }
 #endif
 
-#if defined(__ARM_NEON)
-uint8_t AVX_Chunking_Technique::find_minimum_neon(char *buff, uint64_t start_pos, uint64_t end_pos, uint8x16_t *neon_array){
-
-    // Assume window_size is a multiple of NEON_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / NEON_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into uint8x16_t structures
-    // Could be optimized later as only 16 mm registers are avaiable per CPU in 64-bit
-    for(uint64_t i = 0; i < num_vectors; i++)
-        neon_array[i] = vld1q_u8((uint8_t const *)(buff + start_pos + (NEON_REGISTER_SIZE_BYTES * i)));
-
-    // Repeat vminu until a single register is remaining with minimum values
-    // Each iteration calculates minimums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the minimum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            neon_array[i] = vminq_u8(neon_array[i], neon_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+#if defined(SIMD_AVX512_KERNELS)
+// The masked intrinsics are used with an explicit source: GCC warns about the undefined source of the unmasked ones
+SIMD_TARGET_AVX512 static inline __m512i gear_step_avx512(__m512i hash, __m512i bytes, const long long *gear_table){
+    __m512i index = _mm512_and_si512(bytes, _mm512_set1_epi64(0xFF));
+    __m512i entry = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xFF, index, gear_table, 8);
+    // (hash << 1) + entry
+    return _mm512_add_epi64(_mm512_add_epi64(hash, hash), entry);
+}
+
+template <int NUM_MASKS>
+SIMD_TARGET_AVX512 static void mark_gear_candidates_avx512_impl(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                const uint64_t *gear_table, const uint64_t *masks, uint64_t **words){
+    const long long *table = (const long long *)gear_table;
+    const uint64_t words_per_lane = lane_span / 64;
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i mask_vec[NUM_MASKS];
+    for(int m = 0; m < NUM_MASKS; m++){
+        mask_vec[m] = _mm512_set1_epi64(masks[m]);
+    }
+    alignas(64) uint64_t lane_words[AVX512_REGISTER_SIZE_INT64];
+
+    // Position of the next 8 bytes of each lane
+    __m512i pos = _mm512_set_epi64(7 * lane_span, 6 * lane_span, 5 * lane_span, 4 * lane_span,
+                                   3 * lane_span, 2 * lane_span, lane_span, 0);
+    pos = _mm512_add_epi64(pos, _mm512_set1_epi64(start - GEAR_HASH_WINDOW_SIZE));
+    const __m512i group_step = _mm512_set1_epi64(8);
+    __m512i hash = zero;
+
+    for(uint64_t i = 0; i < GEAR_HASH_WINDOW_SIZE / 8; i++){
+        __m512i bytes = _mm512_mask_i64gather_epi64(zero, 0xFF, pos, buff, 1);
+        pos = _mm512_add_epi64(pos, group_step);
+        for(int k = 0; k < 8; k++){
+            hash = gear_step_avx512(hash, bytes, table);
+            bytes = _mm512_maskz_srli_epi64(0xFF, bytes, 8);
+        }
     }
 
-    // Move the final set of values from the NEON into local memory
-    uint8_t result_store[NEON_REGISTER_SIZE_BYTES] = {0};
-    vst1q_u8((uint8_t *)&result_store, neon_array[0]);
-    
-    // Sequentially scan the last remaining bytes (16 in this case) to find the min value
-    uint8_t min_val = UINT8_MAX;
-    for(uint64_t i = 0; i < NEON_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] < min_val)
-            min_val = result_store[i];
+    for(uint64_t w = 0; w < words_per_lane; w++){
+        __m512i word[NUM_MASKS];
+        for(int m = 0; m < NUM_MASKS; m++){
+            word[m] = zero;
+        }
+        __m512i bit = _mm512_set1_epi64(1);
+        for(int group = 0; group < 8; group++){
+            __m512i bytes = _mm512_mask_i64gather_epi64(zero, 0xFF, pos, buff, 1);
+            pos = _mm512_add_epi64(pos, group_step);
+            for(int k = 0; k < 8; k++){
+                hash = gear_step_avx512(hash, bytes, table);
+                bytes = _mm512_maskz_srli_epi64(0xFF, bytes, 8);
+                for(int m = 0; m < NUM_MASKS; m++){
+                    // Bit j is set if (hash & mask) == 0 in lane j
+                    __mmask8 match = _mm512_testn_epi64_mask(hash, mask_vec[m]);
+                    word[m] = _mm512_mask_or_epi64(word[m], match, word[m], bit);
+                }
+                bit = _mm512_add_epi64(bit, bit);
+            }
+        }
+        for(int m = 0; m < NUM_MASKS; m++){
+            _mm512_store_si512((__m512i *)lane_words, word[m]);
+            for(uint64_t lane = 0; lane < AVX512_REGISTER_SIZE_INT64; lane++){
+                words[m][lane * words_per_lane + w] = lane_words[lane];
+            }
+        }
     }
-    
-    // Return minimum value
-    return min_val;
+}
 
+SIMD_TARGET_AVX512 void AVX_Chunking_Technique::mark_gear_candidates_avx512(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *gear_table,
+                                                                            const uint64_t *masks, uint64_t num_masks, uint64_t **words){
+    if(num_masks == 1){
+        mark_gear_candidates_avx512_impl<1>(buff, start, lane_span, gear_table, masks, words);
+    } else {
+        mark_gear_candidates_avx512_impl<2>(buff, start, lane_span, gear_table, masks, words);
+    }
 }
 #endif
 
-#if defined(__ALTIVEC__)
-uint8_t AVX_Chunking_Technique::find_minimum_altivec(char *buff, uint64_t start_pos, uint64_t end_pos, __vector unsigned char *vec_array){
-    // Assume window_size is a multiple of ALTIVEC_REGISTER_SIZE_BYTES for now
-    // Assume num_vectors is even for now - True for most common window sizes. Can fix later via specific check
-
-    uint64_t num_vectors = (end_pos - start_pos) / ALTIVEC_REGISTER_SIZE_BYTES;
-
-    uint64_t step = 2;
-    uint64_t half_step = 1;
-
-    // Load contents into vector unsigned char structures
-    // Could be optimized later as only 32 vec registers are available per CPU
-    for(uint64_t i = 0; i < num_vectors; i++)
-        vec_array[i] = vec_xl(0, (unsigned char const *)(buff + start_pos + (ALTIVEC_REGISTER_SIZE_BYTES * i)));
-
-    // Repeat vminu until a single register is remaining with minimum values
-    // Each iteration calculates minimums between a pair of registers and moves it into the first register in the pair
-    // Finally, only one will be left with the minimum values from all pairs
-    while(step <= num_vectors){
-        
-        for(uint64_t i = 0; i < num_vectors; i+=step)
-            vec_array[i] = vec_min(vec_array[i], vec_array[i+half_step]);
-        
-        // Multiply step by 2
-        half_step = step;
-        step = step << 1;
-    
+uint64_t AVX_Chunking_Technique::gear_lanes() const{
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return AVX256_REGISTER_SIZE_INT64;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return AVX512_REGISTER_SIZE_INT64;
+        #endif
+        default:
+            return 0;
     }
+}
 
-    // Move the final set of values from the vec into local memory    
-    unsigned char result_store[ALTIVEC_REGISTER_SIZE_BYTES] = {0};
-
-    vec_st(vec_array[0], 0, (unsigned char *)&result_store);
-
-    // Sequentially scan the last remaining bytes (16 in this case) to find the min value
-    uint8_t min_val = UINT8_MAX;
-    for(uint64_t i = 0; i < ALTIVEC_REGISTER_SIZE_BYTES; i++){
-        if(result_store[i] < min_val)
-            min_val = result_store[i];
+void AVX_Chunking_Technique::mark_gear_candidates(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *gear_table,
+                                                  const uint64_t *masks, uint64_t num_masks, uint64_t **words){
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            mark_gear_candidates_avx256(buff, start, lane_span, gear_table, masks, num_masks, words);
+            break;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            mark_gear_candidates_avx512(buff, start, lane_span, gear_table, masks, num_masks, words);
+            break;
+        #endif
+        default:
+            std::cerr << "Error: No gear kernel for the chosen SIMD mode" << std::endl;
+            exit(1);
     }
-
-    // Return minimum value
-    return min_val;
 }
-#endif
 
 /**
- * Range scan functions for greater-than-or-equal-to (geq) comparisons
- * These functions are used to find the first position in the data stream matching a target comparison
- * The functions have been implemented for SSE, AVX, AVX512, NEON and AltiVec instruction sets
+ * * @brief: Rabin kernels. Lane j fingerprints the positions [start + j * lane_span, start + (j + 1) * lane_span).
+ * * 8 bytes entering and 8 bytes leaving the window are gathered per lane at a time. Each step slides the
+ * * leaving byte out with out_table and reduces the appended byte with mod_table, both gathered.
  */
 
-#if defined(__SSE3__)
-uint64_t AVX_Chunking_Technique::range_scan_geq_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / SSE_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit SSE format
-    __m128i xmm_array, cmp_array;
-    int cmp_mask;
-
-    // Load max_value into xmm-format
-    __m128i max_val_xmm = _mm_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * SSE_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm_loadu_si128((__m128i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is geq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        #if defined(__AVX512F__)
-            cmp_mask = _mm_cmpge_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = GreaterOrEqual8uSSE(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm_movemask_epi8(cmp_array);
-        #endif
-        
-
+#if defined(SIMD_AVX256_KERNELS)
+template <int NUM_MASKS>
+SIMD_TARGET_AVX256 static void mark_rabin_candidates_avx256_impl(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                 const uint64_t *mod_table, const uint64_t *out_table,
+                                                                 uint64_t window_size, uint64_t pol_shift,
+                                                                 const uint64_t *masks, uint64_t **words){
+    const long long *mod = (const long long *)mod_table;
+    const long long *out = (const long long *)out_table;
+    const long long *data = (const long long *)buff;
+    const uint64_t words_per_lane = lane_span / 64;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i byte_mask = _mm256_set1_epi64x(0xFF);
+    const __m128i shift = _mm_cvtsi64_si128(pol_shift);
+    __m256i mask_vec[NUM_MASKS];
+    for(int m = 0; m < NUM_MASKS; m++){
+        mask_vec[m] = _mm256_set1_epi64x(masks[m]);
+    }
+    alignas(32) uint64_t lane_words[AVX256_REGISTER_SIZE_INT64];
+
+    // Append the window preceding each span, 8 bytes gathered at a time
+    __m256i pos = _mm256_set_epi64x(3 * lane_span, 2 * lane_span, lane_span, 0);
+    pos = _mm256_add_epi64(pos, _mm256_set1_epi64x(start - window_size));
+    __m256i hash = zero;
+    for(uint64_t i = 0; i < window_size; i += 8){
+        __m256i bytes = _mm256_i64gather_epi64(data, pos, 1);
+        pos = _mm256_add_epi64(pos, _mm256_set1_epi64x(8));
+        for(uint64_t k = 0; k < 8 && i + k < window_size; k++){
+            __m256i index = _mm256_and_si256(_mm256_srl_epi64(hash, shift), byte_mask);
+            hash = _mm256_or_si256(_mm256_slli_epi64(hash, 8), _mm256_and_si256(bytes, byte_mask));
+            hash = _mm256_xor_si256(hash, _mm256_i64gather_epi64(mod, index, 8));
+            bytes = _mm256_srli_epi64(bytes, 8);
+        }
+    }
+    pos = _mm256_add_epi64(pos, _mm256_set1_epi64x(window_size - (window_size + 7) / 8 * 8));
 
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffs(cmp_mask) - 1);
-            return return_pos;            
+    const __m256i window_vec = _mm256_set1_epi64x(window_size);
+    for(uint64_t w = 0; w < words_per_lane; w++){
+        __m256i word[NUM_MASKS];
+        for(int m = 0; m < NUM_MASKS; m++){
+            word[m] = zero;
+        }
+        __m256i bit = _mm256_set1_epi64x(1);
+        for(int group = 0; group < 8; group++){
+            __m256i bytes = _mm256_i64gather_epi64(data, pos, 1);
+            __m256i out_bytes = _mm256_i64gather_epi64(data, _mm256_sub_epi64(pos, window_vec), 1);
+            pos = _mm256_add_epi64(pos, _mm256_set1_epi64x(8));
+            for(int k = 0; k < 8; k++){
+                // Slide the oldest byte out, then append the next one and reduce modulo the polynomial
+                hash = _mm256_xor_si256(hash, _mm256_i64gather_epi64(out, _mm256_and_si256(out_bytes, byte_mask), 8));
+                __m256i index = _mm256_and_si256(_mm256_srl_epi64(hash, shift), byte_mask);
+                hash = _mm256_or_si256(_mm256_slli_epi64(hash, 8), _mm256_and_si256(bytes, byte_mask));
+                hash = _mm256_xor_si256(hash, _mm256_i64gather_epi64(mod, index, 8));
+                bytes = _mm256_srli_epi64(bytes, 8);
+                out_bytes = _mm256_srli_epi64(out_bytes, 8);
+                for(int m = 0; m < NUM_MASKS; m++){
+                    // All ones in the lanes where (hash & mask) == 0
+                    __m256i match = _mm256_cmpeq_epi64(_mm256_and_si256(hash, mask_vec[m]), zero);
+                    word[m] = _mm256_or_si256(word[m], _mm256_and_si256(match, bit));
+                }
+                bit = _mm256_slli_epi64(bit, 1);
+            }
+        }
+        for(int m = 0; m < NUM_MASKS; m++){
+            _mm256_store_si256((__m256i *)lane_words, word[m]);
+            for(uint64_t lane = 0; lane < AVX256_REGISTER_SIZE_INT64; lane++){
+                words[m][lane * words_per_lane + w] = lane_words[lane];
+            }
         }
     }
-    
-    return end_position;
+}
+
+SIMD_TARGET_AVX256 void AVX_Chunking_Technique::mark_rabin_candidates_avx256(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                             const uint64_t *mod_table, const uint64_t *out_table,
+                                                                             uint64_t window_size, uint64_t pol_shift,
+                                                                             const uint64_t *masks, uint64_t num_masks, uint64_t **words){
+    if(num_masks == 1){
+        mark_rabin_candidates_avx256_impl<1>(buff, start, lane_span, mod_table, out_table, window_size, pol_shift, masks, words);
+    } else {
+        mark_rabin_candidates_avx256_impl<2>(buff, start, lane_span, mod_table, out_table, window_size, pol_shift, masks, words);
+    }
 }
 #endif
 
-#if defined(__AVX2__)
-uint64_t AVX_Chunking_Technique::range_scan_geq_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX256_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 256-bit AVX format
-    __m256i xmm_array, cmp_array;
-    uint32_t cmp_mask;
-
-    // Load max_value into xmm-format
-    __m256i max_val_xmm = _mm256_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX256_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm256_loadu_si256((__m256i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is geq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-      
-        #if defined(__AVX512F__)
-            cmp_mask = _mm256_cmpge_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = GreaterOrEqual8uAVX256(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm256_movemask_epi8(cmp_array);
-        #endif
+#if defined(SIMD_AVX512_KERNELS)
+template <int NUM_MASKS>
+SIMD_TARGET_AVX512 static void mark_rabin_candidates_avx512_impl(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                 const uint64_t *mod_table, const uint64_t *out_table,
+                                                                 uint64_t window_size, uint64_t pol_shift,
+                                                                 const uint64_t *masks, uint64_t **words){
+    const long long *mod = (const long long *)mod_table;
+    const long long *out = (const long long *)out_table;
+    const uint64_t words_per_lane = lane_span / 64;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i byte_mask = _mm512_set1_epi64(0xFF);
+    const __m512i shift = _mm512_set1_epi64(pol_shift);
+    __m512i mask_vec[NUM_MASKS];
+    for(int m = 0; m < NUM_MASKS; m++){
+        mask_vec[m] = _mm512_set1_epi64(masks[m]);
+    }
+    alignas(64) uint64_t lane_words[AVX512_REGISTER_SIZE_INT64];
+
+    // Append the window preceding each span, 8 bytes gathered at a time
+    __m512i pos = _mm512_set_epi64(7 * lane_span, 6 * lane_span, 5 * lane_span, 4 * lane_span,
+                                   3 * lane_span, 2 * lane_span, lane_span, 0);
+    pos = _mm512_add_epi64(pos, _mm512_set1_epi64(start - window_size));
+    __m512i hash = zero;
+    for(uint64_t i = 0; i < window_size; i += 8){
+        __m512i bytes = _mm512_mask_i64gather_epi64(zero, 0xFF, pos, buff, 1);
+        pos = _mm512_add_epi64(pos, _mm512_set1_epi64(8));
+        for(uint64_t k = 0; k < 8 && i + k < window_size; k++){
+            __m512i index = _mm512_and_si512(_mm512_maskz_srlv_epi64(0xFF, hash, shift), byte_mask);
+            hash = _mm512_or_si512(_mm512_maskz_slli_epi64(0xFF, hash, 8), _mm512_and_si512(bytes, byte_mask));
+            hash = _mm512_xor_si512(hash, _mm512_mask_i64gather_epi64(zero, 0xFF, index, mod, 8));
+            bytes = _mm512_maskz_srli_epi64(0xFF, bytes, 8);
+        }
+    }
+    pos = _mm512_add_epi64(pos, _mm512_set1_epi64(window_size - (window_size + 7) / 8 * 8));
 
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + (__builtin_ffs(cmp_mask) - 1);            
+    const __m512i window_vec = _mm512_set1_epi64(window_size);
+    for(uint64_t w = 0; w < words_per_lane; w++){
+        __m512i word[NUM_MASKS];
+        for(int m = 0; m < NUM_MASKS; m++){
+            word[m] = zero;
+        }
+        __m512i bit = _mm512_set1_epi64(1);
+        for(int group = 0; group < 8; group++){
+            __m512i bytes = _mm512_mask_i64gather_epi64(zero, 0xFF, pos, buff, 1);
+            __m512i out_bytes = _mm512_mask_i64gather_epi64(zero, 0xFF, _mm512_sub_epi64(pos, window_vec), buff, 1);
+            pos = _mm512_add_epi64(pos, _mm512_set1_epi64(8));
+            for(int k = 0; k < 8; k++){
+                // Slide the oldest byte out, then append the next one and reduce modulo the polynomial
+                __m512i removal = _mm512_mask_i64gather_epi64(zero, 0xFF, _mm512_and_si512(out_bytes, byte_mask), out, 8);
+                hash = _mm512_xor_si512(hash, removal);
+                __m512i index = _mm512_and_si512(_mm512_maskz_srlv_epi64(0xFF, hash, shift), byte_mask);
+                hash = _mm512_or_si512(_mm512_maskz_slli_epi64(0xFF, hash, 8), _mm512_and_si512(bytes, byte_mask));
+                hash = _mm512_xor_si512(hash, _mm512_mask_i64gather_epi64(zero, 0xFF, index, mod, 8));
+                bytes = _mm512_maskz_srli_epi64(0xFF, bytes, 8);
+                out_bytes = _mm512_maskz_srli_epi64(0xFF, out_bytes, 8);
+                for(int m = 0; m < NUM_MASKS; m++){
+                    // Bit j is set if (hash & mask) == 0 in lane j
+                    __mmask8 match = _mm512_testn_epi64_mask(hash, mask_vec[m]);
+                    word[m] = _mm512_mask_or_epi64(word[m], match, word[m], bit);
+                }
+                bit = _mm512_add_epi64(bit, bit);
+            }
+        }
+        for(int m = 0; m < NUM_MASKS; m++){
+            _mm512_store_si512((__m512i *)lane_words, word[m]);
+            for(uint64_t lane = 0; lane < AVX512_REGISTER_SIZE_INT64; lane++){
+                words[m][lane * words_per_lane + w] = lane_words[lane];
+            }
         }
     }
-    
-    return end_position;
 }
-#endif
 
-#if defined(__AVX512F__)
-uint64_t AVX_Chunking_Technique::range_scan_geq_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX512_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 512-bit AVX format
-    __m512i xmm_array;
-    __mmask64 cmp_mask;
-
-    // Load max_value into xmm-format
-    __m512i max_val_xmm = _mm512_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX512_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm512_loadu_si512((__m512i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is geq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_mask = _mm512_cmpge_epu8_mask(xmm_array, max_val_xmm);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffsll(cmp_mask) - 1);
-            return return_pos;            
-        }
+SIMD_TARGET_AVX512 void AVX_Chunking_Technique::mark_rabin_candidates_avx512(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                             const uint64_t *mod_table, const uint64_t *out_table,
+                                                                             uint64_t window_size, uint64_t pol_shift,
+                                                                             const uint64_t *masks, uint64_t num_masks, uint64_t **words){
+    if(num_masks == 1){
+        mark_rabin_candidates_avx512_impl<1>(buff, start, lane_span, mod_table, out_table, window_size, pol_shift, masks, words);
+    } else {
+        mark_rabin_candidates_avx512_impl<2>(buff, start, lane_span, mod_table, out_table, window_size, pol_shift, masks, words);
     }
-    
-    return end_position;
 }
 #endif
 
-#if defined(__ARM_NEON)
-uint64_t AVX_Chunking_Technique::range_scan_geq_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / NEON_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit NEON format
-    uint8x16_t xmm_array, cmp_array;
-    uint8x16_t max_val_xmm = vdupq_n_u8((uint8_t)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * NEON_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = vld1q_u8((uint8_t const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is geq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vcgeq_u8(xmm_array, max_val_xmm);
-
-        // ARM doesn't have native MOVEMASK instructions like x86 does.
-        // Following advice from an ARM community blog post to implement mask creation instead
-        // https://community.arm.com/arm-community-blogs/b/servers-and-cloud-computing-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
-        
-        // Create a mask using the most-significant bit of each byte value in cmp_array
-        
-        uint64_t cmp_mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp_array), 4)), 0);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + ((__builtin_ffsll(cmp_mask) - 1) >> 2); // Shift right by 2 to account for 4 bits per byte            
-        }
+uint64_t AVX_Chunking_Technique::rabin_lanes() const{
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return AVX256_REGISTER_SIZE_INT64;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return AVX512_REGISTER_SIZE_INT64;
+        #endif
+        default:
+            return 0;
     }
-    
-    return end_position;
 }
-#endif
 
-#ifdef __ALTIVEC__
-uint64_t AVX_Chunking_Technique::range_scan_geq_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){ 
-    
-    uint64_t num_vectors = (end_position - start_position) / ALTIVEC_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit AltiVec format
-    __vector unsigned char vec_array;
-    __vector unsigned char perm_array;
-    __vector __bool char cmp_array;
-    __vector unsigned char max_val_vec = vec_splats((unsigned char)target_value);
-    __vector unsigned char bit_selector = {0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120}; // select most significant bit from each byte                    
-
-    uint8_t cond_mask_1, cond_mask_2;    
-
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * ALTIVEC_REGISTER_SIZE_BYTES);
-        
-        // Load data into vec register
-        // Use vec_xl instead of vec_ld because vec_ld truncates the load address to a 16 byte boundary
-        // vec_xl allows loading from any address, which is necessary for unaligned data
-        vec_array = vec_xl(0, (unsigned char const *)(buff + curr_scan_start));
-                
-        /* 
-         Compare values with max_value. If a byte in vec_array is geq max_val_vec,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vec_cmpge(vec_array, max_val_vec);
-        
-        // Create masks using the most-significant bit of each byte value in cmp_array
-        perm_array = vec_bperm((__vector unsigned char)cmp_array, bit_selector);
-        
-        // bperm stores masks in elements 8 and 9 of the vector
-        // Extract the masks from the perm_array
-        // cond_mask_2 corresponds to the first 8 bytes, cond_mask_1 corresponds to the next 8 bytes
-        // This is because vec_bperm rearranges the bits in little endian order
-        cond_mask_1 = vec_extract(perm_array, 8);
-        cond_mask_2 = vec_extract(perm_array, 9);
- 
-       // If cond_mask is not 0, it means at least one byte in cmp_array is non-zero
-       // Subtract 24 because clz implicitly converts to int with a 4-byte size
-       if (cond_mask_2){
-            return curr_scan_start + __builtin_clz(cond_mask_2) - 24 ; 
-        } 
-       else if(cond_mask_1){
-            return curr_scan_start + __builtin_clz(cond_mask_1) - 16; // Add 8 to the index to account for the first 8 bytes in the vector
-        }
-        
+void AVX_Chunking_Technique::mark_rabin_candidates(const char *buff, uint64_t start, uint64_t lane_span, const uint64_t *mod_table,
+                                                   const uint64_t *out_table, uint64_t window_size, uint64_t pol_shift,
+                                                   const uint64_t *masks, uint64_t num_masks, uint64_t **words){
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            mark_rabin_candidates_avx256(buff, start, lane_span, mod_table, out_table, window_size, pol_shift,
+                                         masks, num_masks, words);
+            break;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            mark_rabin_candidates_avx512(buff, start, lane_span, mod_table, out_table, window_size, pol_shift,
+                                         masks, num_masks, words);
+            break;
+        #endif
+        default:
+            std::cerr << "Error: No Rabin kernel for the chosen SIMD mode" << std::endl;
+            exit(1);
     }
-    
-    return end_position;
 }
-#endif
 
 /**
- * @brief: Range scan functions for strictly greater than comparison
- * These functions are used to find the first position in the data stream matching a target comparison
- * The functions are imlemented for SSE, AVX2, AVX512, ARM NEON and AltiVec instruction sets.
+ * * @brief: SS-CDC CRC kernels. Lane j hashes the positions [start + j * lane_span, start + (j + 1) * lane_span)
+ * * with a 32-bit CRC. 4 bytes entering and 4 bytes leaving the window are gathered per lane at a time, and each
+ * * byte indexes its table with a second gather. Each lane first hashes the CRC_HASH_WINDOW_SIZE bytes preceding
+ * * its span, from then on the CRC at every position is the CRC of the window ending there.
  */
 
+#if defined(SIMD_AVX256_KERNELS)
+SIMD_TARGET_AVX256 static inline __m256i crc_step_avx256(__m256i hash, __m256i bytes, const int *crct){
+    __m256i index = _mm256_and_si256(_mm256_xor_si256(hash, bytes), _mm256_set1_epi32(0xFF));
+    return _mm256_xor_si256(_mm256_srli_epi32(hash, 8), _mm256_i32gather_epi32(crct, index, 4));
+}
 
-#if defined(__SSE3__)
-uint64_t AVX_Chunking_Technique::range_scan_gt_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / SSE_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit SSE format
-    __m128i xmm_array, cmp_array;
-    int cmp_mask;
-
-    // Load max_value into xmm-format
-    __m128i max_val_xmm = _mm_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * SSE_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm_loadu_si128((__m128i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is gt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        #if defined(__AVX512F__)
-            cmp_mask = _mm_cmpgt_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = Greater8uSSE(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm_movemask_epi8(cmp_array);
-        #endif
-        
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffs(cmp_mask) - 1);
-            return return_pos;            
+SIMD_TARGET_AVX256 void AVX_Chunking_Technique::mark_crc_candidates_avx256(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                           const uint32_t *crct, const uint32_t *crcu, uint32_t break_mask,
+                                                                           uint32_t magic_number, uint64_t *words){
+    const int *append_table = (const int *)crct;
+    const int *remove_table = (const int *)crcu;
+    const uint64_t words_per_lane = lane_span / 64;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m256i mask_vec = _mm256_set1_epi32(break_mask);
+    const __m256i magic_vec = _mm256_set1_epi32(magic_number);
+    alignas(32) uint32_t lane_low[AVX256_REGISTER_SIZE_INT32];
+    alignas(32) uint32_t lane_high[AVX256_REGISTER_SIZE_INT32];
+
+    // Bytes leaving the window are read CRC_HASH_WINDOW_SIZE bytes before the bytes entering it
+    const int *entering = (const int *)(buff + start);
+    const int *leaving = (const int *)(buff + start - CRC_HASH_WINDOW_SIZE);
+    // Offset of the next 4 bytes of each lane
+    __m256i pos = _mm256_mullo_epi32(_mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0), _mm256_set1_epi32(lane_span));
+    const __m256i group_step = _mm256_set1_epi32(4);
+    __m256i hash = zero;
+
+    for(uint64_t i = 0; i < CRC_HASH_WINDOW_SIZE / 4; i++){
+        __m256i bytes = _mm256_i32gather_epi32(leaving, pos, 1);
+        pos = _mm256_add_epi32(pos, group_step);
+        for(int k = 0; k < 4; k++){
+            hash = crc_step_avx256(hash, bytes, append_table);
+            bytes = _mm256_srli_epi32(bytes, 8);
+        }
+    }
+    pos = _mm256_sub_epi32(pos, _mm256_set1_epi32(CRC_HASH_WINDOW_SIZE));
+
+    for(uint64_t w = 0; w < words_per_lane; w++){
+        // Bits of the positions 0-31 and 32-63 of the word
+        __m256i word[2] = {zero, zero};
+        for(int half = 0; half < 2; half++){
+            __m256i bit = _mm256_set1_epi32(1);
+            for(int group = 0; group < 8; group++){
+                __m256i bytes_in = _mm256_i32gather_epi32(entering, pos, 1);
+                __m256i bytes_out = _mm256_i32gather_epi32(leaving, pos, 1);
+                pos = _mm256_add_epi32(pos, group_step);
+                for(int k = 0; k < 4; k++){
+                    hash = _mm256_xor_si256(hash, _mm256_i32gather_epi32(remove_table, _mm256_and_si256(bytes_out, byte_mask), 4));
+                    hash = crc_step_avx256(hash, bytes_in, append_table);
+                    bytes_in = _mm256_srli_epi32(bytes_in, 8);
+                    bytes_out = _mm256_srli_epi32(bytes_out, 8);
+                    __m256i match = _mm256_cmpeq_epi32(_mm256_and_si256(hash, mask_vec), magic_vec);
+                    word[half] = _mm256_or_si256(word[half], _mm256_and_si256(match, bit));
+                    bit = _mm256_slli_epi32(bit, 1);
+                }
+            }
+        }
+        _mm256_store_si256((__m256i *)lane_low, word[0]);
+        _mm256_store_si256((__m256i *)lane_high, word[1]);
+        for(uint64_t lane = 0; lane < AVX256_REGISTER_SIZE_INT32; lane++){
+            words[lane * words_per_lane + w] = (uint64_t)lane_low[lane] | ((uint64_t)lane_high[lane] << 32);
         }
     }
-    
-    return end_position;
 }
 #endif
 
-#if defined(__AVX2__)
-uint64_t AVX_Chunking_Technique::range_scan_gt_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX256_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 256-bit AVX format
-    __m256i xmm_array, cmp_array;
-    uint32_t cmp_mask;
-
-    // Load max_value into xmm-format
-    __m256i max_val_xmm = _mm256_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX256_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm256_loadu_si256((__m256i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is gt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        #if defined(__AVX512F__)
-            cmp_mask = _mm256_cmpgt_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = Greater8uAVX256(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm256_movemask_epi8(cmp_array);
-        #endif
+#if defined(SIMD_AVX512_KERNELS)
+SIMD_TARGET_AVX512 static inline __m512i crc_step_avx512(__m512i hash, __m512i bytes, const int *crct){
+    __m512i index = _mm512_and_si512(_mm512_xor_si512(hash, bytes), _mm512_set1_epi32(0xFF));
+    __m512i entry = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, index, crct, 4);
+    return _mm512_xor_si512(_mm512_maskz_srli_epi32(0xFFFF, hash, 8), entry);
+}
 
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + (__builtin_ffs(cmp_mask) - 1);            
+SIMD_TARGET_AVX512 void AVX_Chunking_Technique::mark_crc_candidates_avx512(const char *buff, uint64_t start, uint64_t lane_span,
+                                                                           const uint32_t *crct, const uint32_t *crcu, uint32_t break_mask,
+                                                                           uint32_t magic_number, uint64_t *words){
+    const int *append_table = (const int *)crct;
+    const int *remove_table = (const int *)crcu;
+    const uint64_t words_per_lane = lane_span / 64;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i byte_mask = _mm512_set1_epi32(0xFF);
+    const __m512i mask_vec = _mm512_set1_epi32(break_mask);
+    const __m512i magic_vec = _mm512_set1_epi32(magic_number);
+    alignas(64) uint32_t lane_low[AVX512_REGISTER_SIZE_INT32];
+    alignas(64) uint32_t lane_high[AVX512_REGISTER_SIZE_INT32];
+
+    // Bytes leaving the window are read CRC_HASH_WINDOW_SIZE bytes before the bytes entering it
+    const char *entering = buff + start;
+    const char *leaving = buff + start - CRC_HASH_WINDOW_SIZE;
+    // Offset of the next 4 bytes of each lane
+    __m512i pos = _mm512_mullo_epi32(_mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0),
+                                     _mm512_set1_epi32(lane_span));
+    const __m512i group_step = _mm512_set1_epi32(4);
+    __m512i hash = zero;
+
+    for(uint64_t i = 0; i < CRC_HASH_WINDOW_SIZE / 4; i++){
+        __m512i bytes = _mm512_mask_i32gather_epi32(zero, 0xFFFF, pos, leaving, 1);
+        pos = _mm512_add_epi32(pos, group_step);
+        for(int k = 0; k < 4; k++){
+            hash = crc_step_avx512(hash, bytes, append_table);
+            bytes = _mm512_maskz_srli_epi32(0xFFFF, bytes, 8);
         }
     }
-    
-    return end_position;
-}
-#endif
-
-#if defined(__AVX512F__)
-uint64_t AVX_Chunking_Technique::range_scan_gt_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX512_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 512-bit AVX format
-    __m512i xmm_array;
-    __mmask64 cmp_mask;
-
-    // Load max_value into xmm-format
-    __m512i max_val_xmm = _mm512_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX512_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm512_loadu_si512((__m512i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is gt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_mask = _mm512_cmpgt_epu8_mask(xmm_array, max_val_xmm);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffsll(cmp_mask) - 1);
-            return return_pos;            
+    pos = _mm512_sub_epi32(pos, _mm512_set1_epi32(CRC_HASH_WINDOW_SIZE));
+
+    for(uint64_t w = 0; w < words_per_lane; w++){
+        // Bits of the positions 0-31 and 32-63 of the word
+        __m512i word[2] = {zero, zero};
+        for(int half = 0; half < 2; half++){
+            __m512i bit = _mm512_set1_epi32(1);
+            for(int group = 0; group < 8; group++){
+                __m512i bytes_in = _mm512_mask_i32gather_epi32(zero, 0xFFFF, pos, entering, 1);
+                __m512i bytes_out = _mm512_mask_i32gather_epi32(zero, 0xFFFF, pos, leaving, 1);
+                pos = _mm512_add_epi32(pos, group_step);
+                for(int k = 0; k < 4; k++){
+                    __m512i removal = _mm512_mask_i32gather_epi32(zero, 0xFFFF, _mm512_and_si512(bytes_out, byte_mask),
+                                                                  remove_table, 4);
+                    hash = crc_step_avx512(_mm512_xor_si512(hash, removal), bytes_in, append_table);
+                    bytes_in = _mm512_maskz_srli_epi32(0xFFFF, bytes_in, 8);
+                    bytes_out = _mm512_maskz_srli_epi32(0xFFFF, bytes_out, 8);
+                    __mmask16 match = _mm512_cmpeq_epi32_mask(_mm512_and_si512(hash, mask_vec), magic_vec);
+                    word[half] = _mm512_mask_or_epi32(word[half], match, word[half], bit);
+                    bit = _mm512_add_epi32(bit, bit);
+                }
+            }
+        }
+        _mm512_store_si512((__m512i *)lane_low, word[0]);
+        _mm512_store_si512((__m512i *)lane_high, word[1]);
+        for(uint64_t lane = 0; lane < AVX512_REGISTER_SIZE_INT32; lane++){
+            words[lane * words_per_lane + w] = (uint64_t)lane_low[lane] | ((uint64_t)lane_high[lane] << 32);
         }
     }
-    
-    return end_position;
 }
 #endif
 
-#if defined(__ARM_NEON)
-uint64_t AVX_Chunking_Technique::range_scan_gt_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / NEON_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit NEON format
-    uint8x16_t xmm_array, cmp_array;
-    uint8x16_t max_val_xmm = vdupq_n_u8((uint8_t)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * NEON_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = vld1q_u8((uint8_t const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is gt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vcgtq_u8(xmm_array, max_val_xmm);
-
-        // ARM doesn't have native MOVEMASK instructions like x86 does.
-        // Following advice from an ARM community blog post to implement mask creation instead
-        // https://community.arm.com/arm-community-blogs/b/servers-and-cloud-computing-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
-        
-        // Create a mask using the most-significant bit of each byte value in cmp_array
-        
-        uint64_t cmp_mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp_array), 4)), 0);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + ((__builtin_ffsll(cmp_mask) - 1) >> 2); // Shift right by 2 to account for 4 bits per byte            
-        }
+uint64_t AVX_Chunking_Technique::crc_lanes() const{
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return AVX256_REGISTER_SIZE_INT32;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return AVX512_REGISTER_SIZE_INT32;
+        #endif
+        default:
+            return 0;
     }
-    
-    return end_position;
 }
-#endif
 
-#ifdef __ALTIVEC__
-uint64_t AVX_Chunking_Technique::range_scan_gt_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){ 
-    
-    uint64_t num_vectors = (end_position - start_position) / ALTIVEC_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit AltiVec format
-    __vector unsigned char vec_array;
-    __vector unsigned char perm_array;
-    __vector __bool char cmp_array;
-    __vector unsigned char max_val_vec = vec_splats((unsigned char)target_value);
-    __vector unsigned char bit_selector = {0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120}; // select most significant bit from each byte                    
-
-    uint8_t cond_mask_1, cond_mask_2;    
-
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * ALTIVEC_REGISTER_SIZE_BYTES);
-        
-        // Load data into vec register
-        // Use vec_xl instead of vec_ld because vec_ld truncates the load address to a 16 byte boundary
-        // vec_xl allows loading from any address, which is necessary for unaligned data
-        vec_array = vec_xl(0, (unsigned char const *)(buff + curr_scan_start));
-                
-        /* 
-         Compare values with max_value. If a byte in vec_array is gt max_val_vec,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vec_cmpgt(vec_array, max_val_vec);
-        
-        // Create masks using the most-significant bit of each byte value in cmp_array
-        perm_array = vec_bperm((__vector unsigned char)cmp_array, bit_selector);
-        cond_mask_1 = vec_extract(perm_array, 8);
-        cond_mask_2 = vec_extract(perm_array, 9);
- 
-       // If cond_mask is not 0, it means at least one byte in cmp_array is non-zero
-       if (cond_mask_2){
-            return curr_scan_start + __builtin_clz(cond_mask_2) - 24 ; 
-        } 
-       else if(cond_mask_1){
-            return curr_scan_start + __builtin_clz(cond_mask_1) - 16; // Add 8
-       }
+void AVX_Chunking_Technique::mark_crc_candidates(const char *buff, uint64_t start, uint64_t lane_span, const uint32_t *crct,
+                                                 const uint32_t *crcu, uint32_t break_mask, uint32_t magic_number, uint64_t *words){
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            mark_crc_candidates_avx256(buff, start, lane_span, crct, crcu, break_mask, magic_number, words);
+            break;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            mark_crc_candidates_avx512(buff, start, lane_span, crct, crcu, break_mask, magic_number, words);
+            break;
+        #endif
+        default:
+            std::cerr << "Error: No CRC kernel for the chosen SIMD mode" << std::endl;
+            exit(1);
     }
-    return end_position;
 }
-#endif
-
 
 /**
- * @brief: Range scan functions for less than or equal to comparison
- * These functions are used to find the first position in the data stream matching a target comparison
- * The functions are implemented for SSE, AVX2, AVX512, NEON and AltiVec instruction sets.
+ * * @brief: Multi-stream kernels. Each lane chunks its own stream, all lanes move forward by one byte per step.
+ * * 8 bytes are gathered per lane at a time. The hashes are updated in every lane without branching, the step
+ * * of the first match of each lane is kept aside, so the matches do not slow down the hash chain. The kernels
+ * * return after the first group of 8 steps in which a lane finds its cut-point, so the caller can start the
+ * * next chunk of the lanes that stopped. The other lanes are left at the end of the group.
  */
 
-#if defined(__SSE3__)
-uint64_t AVX_Chunking_Technique::range_scan_leq_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / SSE_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit SSE format
-    __m128i xmm_array, cmp_array;
-    int cmp_mask;
-
-    // Load max_value into xmm-format
-    __m128i max_val_xmm = _mm_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * SSE_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm_loadu_si128((__m128i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is leq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        #if defined(__AVX512F__)
-            cmp_mask = _mm_cmple_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = LesserOrEqual8uSSE(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm_movemask_epi8(cmp_array);
+uint64_t AVX_Chunking_Technique::stream_lanes() const{
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return AVX256_REGISTER_SIZE_INT64;
         #endif
-        
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffs(cmp_mask) - 1);
-            return return_pos;            
-        }
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return AVX512_REGISTER_SIZE_INT64;
+        #endif
+        default:
+            return 0;
     }
-    
-    return end_position;
 }
-#endif
 
-#if defined(__AVX2__)
-uint64_t AVX_Chunking_Technique::range_scan_leq_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX256_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 256-bit AVX format
-    __m256i xmm_array, cmp_array;
-    uint32_t cmp_mask;
-
-    // Load max_value into xmm-format
-    __m256i max_val_xmm = _mm256_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX256_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm256_loadu_si256((__m256i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is leq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        #if defined(__AVX512F__)
-            cmp_mask = _mm256_cmple_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = LesserOrEqual8uAVX256(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm256_movemask_epi8(cmp_array);
-        #endif
+#if defined(SIMD_AVX256_KERNELS)
+// All ones in the lanes whose bit is set in active
+SIMD_TARGET_AVX256 static inline __m256i lane_mask_avx256(uint64_t active){
+    const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+    return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(active), lane_bits), lane_bits);
+}
 
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + (__builtin_ffs(cmp_mask) - 1);            
+SIMD_TARGET_AVX256 uint64_t AVX_Chunking_Technique::advance_gear_lanes_avx256(Stream_Lanes &lanes, uint64_t active, const uint64_t *gear_table,
+                                                                             uint64_t mask_0, uint64_t mask_1){
+    const long long *table = (const long long *)gear_table;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i group_size = _mm256_set1_epi64x(8);
+    const __m256i mask_0_vec = _mm256_set1_epi64x(mask_0);
+    const __m256i mask_1_vec = _mm256_set1_epi64x(mask_1);
+    const __m256i data = _mm256_loadu_si256((const __m256i *)lanes.data);
+    const __m256i end = _mm256_loadu_si256((const __m256i *)lanes.end);
+    const __m256i phase = _mm256_loadu_si256((const __m256i *)lanes.phase);
+    // All ones in the active lanes. Positions are below 2^63, so signed compares work
+    const __m256i live = lane_mask_avx256(active);
+    __m256i pos = _mm256_loadu_si256((const __m256i *)lanes.pos);
+    __m256i hash = _mm256_loadu_si256((const __m256i *)lanes.hash);
+
+    while(true){
+        __m256i bytes = _mm256_mask_i64gather_epi64(zero, (const long long *)0, _mm256_add_epi64(data, pos), live, 1);
+        // Steps of the group left before each lane reaches end, and phase
+        __m256i end_steps = _mm256_sub_epi64(end, pos);
+        __m256i phase_steps = _mm256_sub_epi64(phase, pos);
+        __m256i first = zero;
+        __m256i hit = zero;
+        for(int k = 0; k < 8; k++){
+            const __m256i step = _mm256_set1_epi64x(k);
+            hash = gear_step_avx256(hash, bytes, table);
+            bytes = _mm256_srli_epi64(bytes, 8);
+            __m256i mask = _mm256_blendv_epi8(mask_1_vec, mask_0_vec, _mm256_cmpgt_epi64(phase_steps, step));
+            __m256i match = _mm256_cmpeq_epi64(_mm256_and_si256(hash, mask), zero);
+            match = _mm256_and_si256(match, _mm256_and_si256(_mm256_cmpgt_epi64(end_steps, step), live));
+            match = _mm256_andnot_si256(hit, match);
+            first = _mm256_blendv_epi8(first, step, match);
+            hit = _mm256_or_si256(hit, match);
+        }
+        // Lanes reaching end without a match cut there
+        __m256i ended = _mm256_andnot_si256(_mm256_or_si256(hit, _mm256_cmpgt_epi64(end_steps, group_size)), live);
+        __m256i found = _mm256_or_si256(hit, ended);
+        pos = _mm256_add_epi64(pos, _mm256_and_si256(group_size, live));
+        if(!_mm256_testz_si256(found, found)){
+            __m256i cut = _mm256_blendv_epi8(end, _mm256_sub_epi64(_mm256_add_epi64(pos, first), group_size), hit);
+            _mm256_storeu_si256((__m256i *)lanes.pos, pos);
+            _mm256_storeu_si256((__m256i *)lanes.hash, hash);
+            _mm256_storeu_si256((__m256i *)lanes.cut, cut);
+            return _mm256_movemask_pd(_mm256_castsi256_pd(found));
         }
     }
-    
-    return end_position;
 }
-#endif
 
-#if defined(__AVX512F__)
-uint64_t AVX_Chunking_Technique::range_scan_leq_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX512_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 512-bit AVX format
-    __m512i xmm_array;
-    __mmask64 cmp_mask;
-
-    // Load max_value into xmm-format
-    __m512i max_val_xmm = _mm512_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX512_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm512_loadu_si512((__m512i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is leq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_mask = _mm512_cmple_epu8_mask(xmm_array, max_val_xmm);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffsll(cmp_mask) - 1);
-            return return_pos;            
+SIMD_TARGET_AVX256 uint64_t AVX_Chunking_Technique::advance_rabin_lanes_avx256(Stream_Lanes &lanes, uint64_t active, const uint64_t *mod_table,
+                                                                              const uint64_t *out_table, uint64_t mask, uint64_t window_size,
+                                                                              uint64_t pol_shift){
+    const long long *mod = (const long long *)mod_table;
+    const long long *out = (const long long *)out_table;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i group_size = _mm256_set1_epi64x(8);
+    const __m256i byte_mask = _mm256_set1_epi64x(0xFF);
+    const __m256i mask_vec = _mm256_set1_epi64x(mask);
+    const __m128i shift = _mm_cvtsi64_si128(pol_shift);
+    const __m256i data = _mm256_loadu_si256((const __m256i *)lanes.data);
+    const __m256i end = _mm256_loadu_si256((const __m256i *)lanes.end);
+    const __m256i phase = _mm256_loadu_si256((const __m256i *)lanes.phase);
+    const __m256i live = lane_mask_avx256(active);
+    __m256i pos = _mm256_loadu_si256((const __m256i *)lanes.pos);
+    __m256i hash = _mm256_loadu_si256((const __m256i *)lanes.hash);
+
+    while(true){
+        __m256i address = _mm256_add_epi64(data, pos);
+        __m256i bytes = _mm256_mask_i64gather_epi64(zero, (const long long *)0, address, live, 1);
+        __m256i out_bytes = _mm256_mask_i64gather_epi64(zero, (const long long *)0,
+                                                        _mm256_sub_epi64(address, _mm256_set1_epi64x(window_size)), live, 1);
+        __m256i end_steps = _mm256_sub_epi64(end, pos);
+        __m256i phase_steps = _mm256_sub_epi64(phase, pos);
+        __m256i first = zero;
+        __m256i hit = zero;
+        for(int k = 0; k < 8; k++){
+            const __m256i step = _mm256_set1_epi64x(k);
+            // Slide the oldest byte out, then append the next one and reduce modulo the polynomial
+            hash = _mm256_xor_si256(hash, _mm256_i64gather_epi64(out, _mm256_and_si256(out_bytes, byte_mask), 8));
+            __m256i index = _mm256_and_si256(_mm256_srl_epi64(hash, shift), byte_mask);
+            hash = _mm256_or_si256(_mm256_slli_epi64(hash, 8), _mm256_and_si256(bytes, byte_mask));
+            hash = _mm256_xor_si256(hash, _mm256_i64gather_epi64(mod, index, 8));
+            bytes = _mm256_srli_epi64(bytes, 8);
+            out_bytes = _mm256_srli_epi64(out_bytes, 8);
+
+            __m256i match = _mm256_cmpeq_epi64(_mm256_and_si256(hash, mask_vec), zero);
+            match = _mm256_and_si256(match, _mm256_and_si256(_mm256_cmpgt_epi64(end_steps, step), live));
+            match = _mm256_andnot_si256(_mm256_or_si256(hit, _mm256_cmpgt_epi64(phase_steps, step)), match);
+            first = _mm256_blendv_epi8(first, step, match);
+            hit = _mm256_or_si256(hit, match);
+        }
+        __m256i ended = _mm256_andnot_si256(_mm256_or_si256(hit, _mm256_cmpgt_epi64(end_steps, group_size)), live);
+        __m256i found = _mm256_or_si256(hit, ended);
+        pos = _mm256_add_epi64(pos, _mm256_and_si256(group_size, live));
+        if(!_mm256_testz_si256(found, found)){
+            // The chunk ends after the matching position
+            __m256i after_match = _mm256_add_epi64(_mm256_sub_epi64(pos, group_size), _mm256_add_epi64(first, _mm256_set1_epi64x(1)));
+            __m256i cut = _mm256_blendv_epi8(end, after_match, hit);
+            _mm256_storeu_si256((__m256i *)lanes.pos, pos);
+            _mm256_storeu_si256((__m256i *)lanes.hash, hash);
+            _mm256_storeu_si256((__m256i *)lanes.cut, cut);
+            return _mm256_movemask_pd(_mm256_castsi256_pd(found));
         }
     }
-    
-    return end_position;
 }
 #endif
 
-#if defined(__ARM_NEON)
-uint64_t AVX_Chunking_Technique::range_scan_leq_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / NEON_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit NEON format
-    uint8x16_t xmm_array, cmp_array;
-    uint8x16_t max_val_xmm = vdupq_n_u8((uint8_t)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * NEON_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = vld1q_u8((uint8_t const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is leq max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vcleq_u8(xmm_array, max_val_xmm);
-
-        // ARM doesn't have native MOVEMASK instructions like x86 does.
-        // Following advice from an ARM community blog post to implement mask creation instead
-        // https://community.arm.com/arm-community-blogs/b/servers-and-cloud-computing-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
-        
-        // Create a mask using the most-significant bit of each byte value in cmp_array
-        
-        uint64_t cmp_mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp_array), 4)), 0);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + ((__builtin_ffsll(cmp_mask) - 1) >> 2); // Shift right by 2 to account for 4 bits per byte            
+#if defined(SIMD_AVX512_KERNELS)
+SIMD_TARGET_AVX512 uint64_t AVX_Chunking_Technique::advance_gear_lanes_avx512(Stream_Lanes &lanes, uint64_t active, const uint64_t *gear_table,
+                                                                             uint64_t mask_0, uint64_t mask_1){
+    const long long *table = (const long long *)gear_table;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i group_size = _mm512_set1_epi64(8);
+    const __m512i mask_0_vec = _mm512_set1_epi64(mask_0);
+    const __m512i mask_1_vec = _mm512_set1_epi64(mask_1);
+    const __m512i data = _mm512_loadu_si512(lanes.data);
+    const __m512i end = _mm512_loadu_si512(lanes.end);
+    const __m512i phase = _mm512_loadu_si512(lanes.phase);
+    const __mmask8 live = (__mmask8)active;
+    __m512i pos = _mm512_loadu_si512(lanes.pos);
+    __m512i hash = _mm512_loadu_si512(lanes.hash);
+
+    while(true){
+        __m512i bytes = _mm512_mask_i64gather_epi64(zero, live, _mm512_add_epi64(data, pos), (const void *)0, 1);
+        // Steps of the group left before each lane reaches end, and phase
+        __m512i end_steps = _mm512_sub_epi64(end, pos);
+        __m512i phase_steps = _mm512_sub_epi64(phase, pos);
+        __m512i first = zero;
+        __mmask8 hit = 0;
+        for(int k = 0; k < 8; k++){
+            const __m512i step = _mm512_set1_epi64(k);
+            hash = gear_step_avx512(hash, bytes, table);
+            bytes = _mm512_maskz_srli_epi64(0xFF, bytes, 8);
+            __m512i mask = _mm512_mask_blend_epi64(_mm512_cmpgt_epi64_mask(phase_steps, step), mask_1_vec, mask_0_vec);
+            __mmask8 match = _mm512_mask_testn_epi64_mask(live & _mm512_cmpgt_epi64_mask(end_steps, step), hash, mask) & ~hit;
+            first = _mm512_mask_mov_epi64(first, match, step);
+            hit |= match;
         }
+        // Lanes reaching end without a match cut there
+        __mmask8 ended = _mm512_mask_cmple_epi64_mask(live & ~hit, end_steps, group_size);
+        if(hit | ended){
+            __m512i cut = _mm512_mask_add_epi64(end, hit, pos, first);
+            pos = _mm512_mask_add_epi64(pos, live, pos, group_size);
+            _mm512_storeu_si512(lanes.pos, pos);
+            _mm512_storeu_si512(lanes.hash, hash);
+            _mm512_storeu_si512(lanes.cut, cut);
+            return hit | ended;
+        }
+        pos = _mm512_mask_add_epi64(pos, live, pos, group_size);
     }
-    
-    return end_position;
 }
-#endif
 
-#ifdef __ALTIVEC__
-uint64_t AVX_Chunking_Technique::range_scan_leq_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / ALTIVEC_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit AltiVec format
-    __vector unsigned char vec_array;
-    __vector unsigned char perm_array;
-    __vector __bool char cmp_array;
-    __vector unsigned char max_val_vec = vec_splats((unsigned char)target_value);
-    __vector unsigned char bit_selector = {0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120}; // select most significant bit from each byte                    
-
-    uint8_t cond_mask_1, cond_mask_2;    
-
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * ALTIVEC_REGISTER_SIZE_BYTES);
-        
-        // Load data into vec register
-        // Use vec_xl instead of vec_ld because vec_ld truncates the load address to a 16 byte boundary
-        // vec_xl allows loading from any address, which is necessary for unaligned data
-        vec_array = vec_xl(0, (unsigned char const *)(buff + curr_scan_start));
-                
-        /* 
-         Compare values with max_value. If a byte in vec_array is leq max_val_vec,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vec_cmple(vec_array, max_val_vec);
-        
-        // Create masks using the most-significant bit of each byte value in cmp_array
-        perm_array = vec_bperm((__vector unsigned char)cmp_array, bit_selector);
-        cond_mask_1 = vec_extract(perm_array, 8);
-        cond_mask_2 = vec_extract(perm_array, 9);
- 
-       // If cond_mask is not 0, it means at least one byte in cmp_array is non-zero
-       if (cond_mask_2){
-            return curr_scan_start + __builtin_clz(cond_mask_2) - 24 ; 
-        } 
-       else if(cond_mask_1){
-            return curr_scan_start + __builtin_clz(cond_mask_1) - 16; // Add 8
+SIMD_TARGET_AVX512 uint64_t AVX_Chunking_Technique::advance_rabin_lanes_avx512(Stream_Lanes &lanes, uint64_t active, const uint64_t *mod_table,
+                                                                              const uint64_t *out_table, uint64_t mask, uint64_t window_size,
+                                                                              uint64_t pol_shift){
+    const long long *mod = (const long long *)mod_table;
+    const long long *out = (const long long *)out_table;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i group_size = _mm512_set1_epi64(8);
+    const __m512i byte_mask = _mm512_set1_epi64(0xFF);
+    const __m512i mask_vec = _mm512_set1_epi64(mask);
+    const __m512i shift = _mm512_set1_epi64(pol_shift);
+    const __m512i data = _mm512_loadu_si512(lanes.data);
+    const __m512i end = _mm512_loadu_si512(lanes.end);
+    const __m512i phase = _mm512_loadu_si512(lanes.phase);
+    const __mmask8 live = (__mmask8)active;
+    __m512i pos = _mm512_loadu_si512(lanes.pos);
+    __m512i hash = _mm512_loadu_si512(lanes.hash);
+
+    while(true){
+        __m512i address = _mm512_add_epi64(data, pos);
+        __m512i bytes = _mm512_mask_i64gather_epi64(zero, live, address, (const void *)0, 1);
+        __m512i out_bytes = _mm512_mask_i64gather_epi64(zero, live, _mm512_sub_epi64(address, _mm512_set1_epi64(window_size)),
+                                                        (const void *)0, 1);
+        __m512i end_steps = _mm512_sub_epi64(end, pos);
+        __m512i phase_steps = _mm512_sub_epi64(phase, pos);
+        __m512i first = zero;
+        __mmask8 hit = 0;
+        for(int k = 0; k < 8; k++){
+            const __m512i step = _mm512_set1_epi64(k);
+            // Slide the oldest byte out, then append the next one and reduce modulo the polynomial
+            __m512i out_entry = _mm512_mask_i64gather_epi64(zero, 0xFF, _mm512_and_si512(out_bytes, byte_mask), out, 8);
+            hash = _mm512_xor_si512(hash, out_entry);
+            __m512i index = _mm512_and_si512(_mm512_maskz_srlv_epi64(0xFF, hash, shift), byte_mask);
+            hash = _mm512_or_si512(_mm512_maskz_slli_epi64(0xFF, hash, 8), _mm512_and_si512(bytes, byte_mask));
+            hash = _mm512_xor_si512(hash, _mm512_mask_i64gather_epi64(zero, 0xFF, index, mod, 8));
+            bytes = _mm512_maskz_srli_epi64(0xFF, bytes, 8);
+            out_bytes = _mm512_maskz_srli_epi64(0xFF, out_bytes, 8);
+
+            __mmask8 valid = live & _mm512_cmpgt_epi64_mask(end_steps, step) & _mm512_cmple_epi64_mask(phase_steps, step);
+            __mmask8 match = _mm512_mask_testn_epi64_mask(valid, hash, mask_vec) & ~hit;
+            first = _mm512_mask_mov_epi64(first, match, step);
+            hit |= match;
+        }
+        __mmask8 ended = _mm512_mask_cmple_epi64_mask(live & ~hit, end_steps, group_size);
+        if(hit | ended){
+            // The chunk ends after the matching position
+            __m512i cut = _mm512_mask_add_epi64(end, hit, pos, _mm512_add_epi64(first, one));
+            pos = _mm512_mask_add_epi64(pos, live, pos, group_size);
+            _mm512_storeu_si512(lanes.pos, pos);
+            _mm512_storeu_si512(lanes.hash, hash);
+            _mm512_storeu_si512(lanes.cut, cut);
+            return hit | ended;
         }
+        pos = _mm512_mask_add_epi64(pos, live, pos, group_size);
     }
-    return end_position;
 }
 #endif
 
-/**
- * @brief: Range scan functions for strictly less than comparison
- * These functions are used to find the first position in the data stream matching a target comparison
- * The functions are implemented for SSE, AVX2, AVX512, NEON and AltiVec instruction sets.
- */
-
-#if defined(__SSE3__)
-uint64_t AVX_Chunking_Technique::range_scan_lt_sse128(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / SSE_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit SSE format
-    __m128i xmm_array, cmp_array;
-    int cmp_mask;
-
-    // Load max_value into xmm-format
-    __m128i max_val_xmm = _mm_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * SSE_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm_loadu_si128((__m128i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is lt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        #if defined(__AVX512F__)
-            cmp_mask = _mm_cmplt_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = Lesser8uSSE(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm_movemask_epi8(cmp_array);
+uint64_t AVX_Chunking_Technique::advance_gear_lanes(Stream_Lanes &lanes, uint64_t active, const uint64_t *gear_table,
+                                                    uint64_t mask_0, uint64_t mask_1){
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return advance_gear_lanes_avx256(lanes, active, gear_table, mask_0, mask_1);
         #endif
-        
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffs(cmp_mask) - 1);
-            return return_pos;            
-        }
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return advance_gear_lanes_avx512(lanes, active, gear_table, mask_0, mask_1);
+        #endif
+        default:
+            std::cerr << "Error: No multi-stream kernel for the chosen SIMD mode" << std::endl;
+            exit(1);
     }
-    
-    return end_position;
 }
-#endif
 
-#if defined(__AVX2__)
-uint64_t AVX_Chunking_Technique::range_scan_lt_avx256(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX256_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 256-bit AVX format
-    __m256i xmm_array, cmp_array;
-    uint32_t cmp_mask;
-
-    // Load max_value into xmm-format
-    __m256i max_val_xmm = _mm256_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX256_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm256_loadu_si256((__m256i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is lt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        #if defined(__AVX512F__)
-            cmp_mask = _mm256_cmplt_epu8_mask(xmm_array, max_val_xmm);
-        #else
-            cmp_array = Lesser8uAVX256(xmm_array, max_val_xmm);
-        
-            // Create a mask using the most-significant bit of each byte value in cmp_array
-            cmp_mask = _mm256_movemask_epi8(cmp_array);
+uint64_t AVX_Chunking_Technique::advance_rabin_lanes(Stream_Lanes &lanes, uint64_t active, const uint64_t *mod_table,
+                                                     const uint64_t *out_table, uint64_t mask, uint64_t window_size,
+                                                     uint64_t pol_shift){
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return advance_rabin_lanes_avx256(lanes, active, mod_table, out_table, mask, window_size, pol_shift);
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return advance_rabin_lanes_avx512(lanes, active, mod_table, out_table, mask, window_size, pol_shift);
         #endif
+        default:
+            std::cerr << "Error: No multi-stream kernel for the chosen SIMD mode" << std::endl;
+            exit(1);
+    }
+}
 
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + (__builtin_ffs(cmp_mask) - 1);            
-        }
+/**
+ * * @brief: SeqCDC kernels. The comparisons of a block are turned into bit masks and the
+ * sequences and jumps are found in the masks with BMI2.
+ */
+
+#if defined(SIMD_AVX256_KERNELS)
+// Bit i is set if the run of ones in packed ending at bit i is at least length long
+SIMD_TARGET_BMI2 static inline uint64_t seq_run_ends(uint64_t packed, uint64_t length){
+    if(length > SEQ_SIMD_BLOCK_SIZE)
+        return 0;
+    uint64_t ends = packed;
+    for(uint64_t run = 1; run < length;){
+        uint64_t step = std::min(run, length - run);
+        ends &= ends << step;
+        run += step;
     }
-    
-    return end_position;
+    return ends;
 }
-#endif
 
-#if defined(__AVX512F__)
-uint64_t AVX_Chunking_Technique::range_scan_lt_avx512(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / AVX512_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-    uint64_t return_pos;
-
-    // Structures to store bytes from data stream and comparison results in 512-bit AVX format
-    __m512i xmm_array;
-    __mmask64 cmp_mask;
-
-    // Load max_value into xmm-format
-    __m512i max_val_xmm = _mm512_set1_epi8((char)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * AVX512_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = _mm512_loadu_si512((__m512i const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is lt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_mask = _mm512_cmplt_epu8_mask(xmm_array, max_val_xmm);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return_pos = curr_scan_start + (__builtin_ffsll(cmp_mask) - 1);
-            return return_pos;            
+/**
+ * @brief: Applies the slopes of the block at state.pos to the search state
+ * @param continuing: Slopes continuing the sequence
+ * @param opposing: Slopes opposing it
+ * @return: true if state.pos is the cut-point
+*/
+SIMD_TARGET_BMI2 static inline bool seq_scan_block(uint64_t continuing, uint64_t opposing, uint64_t seq_length_threshold,
+                                                   uint64_t jump_trigger, uint64_t jump_size, Seq_Scan_State &state){
+    // Equal bytes are skipped, so the sequence is searched in the slopes packed without them
+    uint64_t slopes = continuing | opposing;
+    bool all_slopes = (slopes == ~0ULL);
+
+    uint64_t cut = SEQ_SIMD_BLOCK_SIZE;
+    if(continuing){
+        uint64_t packed = all_slopes ? continuing : _pext_u64(continuing, slopes);
+        uint64_t first_run = _tzcnt_u64(~packed);
+        uint64_t slope = SEQ_SIMD_BLOCK_SIZE;
+        if(state.seq_length + first_run >= seq_length_threshold){
+            slope = seq_length_threshold - state.seq_length - 1;
+        } else {
+            uint64_t ends = seq_run_ends(packed, seq_length_threshold);
+            if(ends)
+                slope = _tzcnt_u64(ends);
         }
+        if(slope < SEQ_SIMD_BLOCK_SIZE)
+            cut = all_slopes ? slope : _tzcnt_u64(_pdep_u64(1ULL << slope, slopes));
+    }
+
+    uint64_t jump = SEQ_SIMD_BLOCK_SIZE;
+    uint64_t remaining = jump_trigger - state.opposing_slope_count;
+    if(remaining <= (uint64_t)_mm_popcnt_u64(opposing))
+        jump = _tzcnt_u64(_pdep_u64(1ULL << (remaining - 1), opposing));
+
+    if(cut < jump){
+        state.pos += cut;
+        return true;
+    }
+    if(jump < SEQ_SIMD_BLOCK_SIZE){
+        state.pos += jump + 1 + jump_size;
+        state.opposing_slope_count = 0;
+        state.seq_length = 0;
+        return false;
     }
-    
-    return end_position;
+
+    state.opposing_slope_count += _mm_popcnt_u64(opposing);
+    if(opposing){
+        uint64_t last = 63 - __builtin_clzll(opposing);
+        state.seq_length = _mm_popcnt_u64(continuing & ~((2ULL << last) - 1));
+    } else {
+        state.seq_length += _mm_popcnt_u64(continuing);
+    }
+    state.pos += SEQ_SIMD_BLOCK_SIZE;
+    return false;
 }
-#endif
 
-#if defined(__ARM_NEON)
-uint64_t AVX_Chunking_Technique::range_scan_lt_neon(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    
-    uint64_t num_vectors = (end_position - start_position) / NEON_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit NEON format
-    uint8x16_t xmm_array, cmp_array;
-    uint8x16_t max_val_xmm = vdupq_n_u8((uint8_t)target_value);
-    
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * NEON_REGISTER_SIZE_BYTES);
-        // Load data into xmm register
-        xmm_array = vld1q_u8((uint8_t const *)(buff + curr_scan_start));
-        
-        /* 
-         Compare values with max_value. If a byte in xmm_array is lt max_val_xmm,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vcltq_u8(xmm_array, max_val_xmm);
-
-        // ARM doesn't have native MOVEMASK instructions like x86 does.
-        // Following advice from an ARM community blog post to implement mask creation instead
-        // https://community.arm.com/arm-community-blogs/b/servers-and-cloud-computing-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
-        
-        // Create a mask using the most-significant bit of each byte value in cmp_array
-        
-        uint64_t cmp_mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp_array), 4)), 0);
-
-        // Return index of first non-zero bit in mask
-        // This corresponds to the first non-zero byte in cmp_array 
-        if(cmp_mask){
-            return curr_scan_start + ((__builtin_ffsll(cmp_mask) - 1) >> 2); // Shift right by 2 to account for 4 bits per byte            
-        }
+SIMD_TARGET_AVX256_BMI2
+bool AVX_Chunking_Technique::find_seq_cutpoint_avx256(const char *buff, uint64_t size, bool decreasing,
+                                                      uint64_t seq_length_threshold, uint64_t jump_trigger,
+                                                      uint64_t jump_size, Seq_Scan_State &state){
+    // AVX2 only compares signed bytes, flipping the sign bits compares them unsigned
+    const __m256i sign_bits = _mm256_set1_epi8((char)0x80);
+    while(state.pos + SEQ_SIMD_BLOCK_SIZE <= size){
+        const char *block = buff + state.pos;
+        __m256i curr_lo = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)block), sign_bits);
+        __m256i prev_lo = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(block - 1)), sign_bits);
+        __m256i curr_hi = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(block + AVX256_REGISTER_SIZE_BYTES)), sign_bits);
+        __m256i prev_hi = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(block + AVX256_REGISTER_SIZE_BYTES - 1)), sign_bits);
+
+        uint64_t increasing = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(curr_lo, prev_lo)) |
+                              ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(curr_hi, prev_hi)) << 32);
+        uint64_t decreasing_slopes = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(prev_lo, curr_lo)) |
+                                     ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(prev_hi, curr_hi)) << 32);
+
+        bool found = decreasing ?
+            seq_scan_block(decreasing_slopes, increasing, seq_length_threshold, jump_trigger, jump_size, state) :
+            seq_scan_block(increasing, decreasing_slopes, seq_length_threshold, jump_trigger, jump_size, state);
+        if(found)
+            return true;
     }
-    
-    return end_position;
+    return false;
 }
 #endif
 
-#ifdef __ALTIVEC__
-uint64_t AVX_Chunking_Technique::range_scan_lt_altivec(char *buff, uint64_t start_position, uint64_t end_position, uint8_t target_value){
-    uint64_t num_vectors = (end_position - start_position) / ALTIVEC_REGISTER_SIZE_BYTES;
-    uint64_t curr_scan_start;
-
-    // Structures to store bytes from data stream and comparison results in 128-bit AltiVec format
-    __vector unsigned char vec_array;
-    __vector unsigned char perm_array;
-    __vector __bool char cmp_array;
-    __vector unsigned char max_val_vec = vec_splats((unsigned char)target_value);
-    __vector unsigned char bit_selector = {0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120}; // select most significant bit from each byte                    
-
-    uint8_t cond_mask_1, cond_mask_2;    
-
-    for(uint64_t i = 0; i < num_vectors; i++){
-        curr_scan_start = start_position + (i * ALTIVEC_REGISTER_SIZE_BYTES);
-        
-        // Load data into vec register
-        // Use vec_xl instead of vec_ld because vec_ld truncates the load address to a 16 byte boundary
-        // vec_xl allows loading from any address, which is necessary for unaligned data
-        vec_array = vec_xl(0, (unsigned char const *)(buff + curr_scan_start));
-                
-        /* 
-         Compare values with max_value. If a byte in vec_array is lt max_val_vec,  
-         ALL the corresponding bits of the corresponding byte in cmp_array are set to 1.
-        */
-        
-        cmp_array = vec_cmplt(vec_array, max_val_vec);
-        
-        // Create masks using the most-significant bit of each byte value in cmp_array
-        perm_array = vec_bperm((__vector unsigned char)cmp_array, bit_selector);
-        
-        // bperm stores masks in elements 8 and 9 of the vector
-        // Extract the masks from the perm_array
-        // cond_mask_2 corresponds to the first 8 bytes, cond_mask_1 corresponds to the next 8 bytes
-        // This is because vec_bperm rearranges the bits in little endian order
-        cond_mask_1 = vec_extract(perm_array, 8);
-        cond_mask_2 = vec_extract(perm_array, 9);
- 
-       // If cond_mask is not 0, it means at least one byte in cmp_array is non-zero
-       // Subtract 24 because clz implicitly converts to int with a 4-byte size
-       if (cond_mask_2){
-            return curr_scan_start + __builtin_clz(cond_mask_2) - 24 ; 
-        } 
-       else if(cond_mask_1){
-            return curr_scan_start + __builtin_clz(cond_mask_1) - 16; // Add 8 to the index to account for the first 8 bytes in the vector
-        }
+#if defined(SIMD_AVX512_KERNELS)
+SIMD_TARGET_AVX512_BMI2
+bool AVX_Chunking_Technique::find_seq_cutpoint_avx512(const char *buff, uint64_t size, bool decreasing,
+                                                      uint64_t seq_length_threshold, uint64_t jump_trigger,
+                                                      uint64_t jump_size, Seq_Scan_State &state){
+    while(state.pos + SEQ_SIMD_BLOCK_SIZE <= size){
+        const char *block = buff + state.pos;
+        __m512i curr = _mm512_loadu_si512((const void *)block);
+        __m512i prev = _mm512_loadu_si512((const void *)(block - 1));
+
+        uint64_t increasing = _mm512_cmpgt_epu8_mask(curr, prev);
+        uint64_t decreasing_slopes = _mm512_cmplt_epu8_mask(curr, prev);
+
+        bool found = decreasing ?
+            seq_scan_block(decreasing_slopes, increasing, seq_length_threshold, jump_trigger, jump_size, state) :
+            seq_scan_block(increasing, decreasing_slopes, seq_length_threshold, jump_trigger, jump_size, state);
+        if(found)
+            return true;
     }
-    return end_position;
+    return false;
 }
 #endif
+
+uint64_t AVX_Chunking_Technique::seq_lanes() const{
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return AVX256_REGISTER_SIZE_BYTES;
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return AVX512_REGISTER_SIZE_BYTES;
+        #endif
+        default:
+            return 0;
+    }
+}
+
+bool AVX_Chunking_Technique::find_seq_cutpoint(const char *buff, uint64_t size, bool decreasing,
+                                               uint64_t seq_length_threshold, uint64_t jump_trigger,
+                                               uint64_t jump_size, Seq_Scan_State &state){
+    switch(simd_mode){
+        #if defined(SIMD_AVX256_KERNELS)
+        case SIMD_Mode::AVX256:
+            return find_seq_cutpoint_avx256(buff, size, decreasing, seq_length_threshold, jump_trigger, jump_size, state);
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+            return find_seq_cutpoint_avx512(buff, size, decreasing, seq_length_threshold, jump_trigger, jump_size, state);
+        #endif
+        default:
+            std::cerr << "Error: No SeqCDC kernel for the chosen SIMD mode" << std::endl;
+            exit(1);
+    }
+}
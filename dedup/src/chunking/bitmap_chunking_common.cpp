@@ -0,0 +1,167 @@
+/**
+ * @file bitmap_chunking_common.cpp
+ * @author WASL
+ * @brief Implementations of the two-phase candidate bitmap framework
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "bitmap_chunking_common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+void Bitmap_Chunking_Technique::init_candidate_bitmap(const Config& config,
+                                                      uint64_t levels) {
+    candidate_bitmap_enabled = config.get_candidate_bitmap();
+    candidate_bitmap_threads = config.get_candidate_bitmap_threads();
+    candidate_bitmap_region_size = config.get_candidate_bitmap_region_size();
+    candidate_levels = levels;
+}
+
+uint64_t Bitmap_Chunking_Technique::next_candidate(uint64_t level,
+                                                   uint64_t from,
+                                                   uint64_t to) const {
+    if (from >= to) {
+        return to;
+    }
+    const uint64_t* bitmap = candidate_bitmaps[level].data();
+    uint64_t idx = from / BITMAP_WORD_BITS;
+    uint64_t last_idx = (to - 1) / BITMAP_WORD_BITS;
+    uint64_t word = bitmap[idx] & (~0ULL << (from % BITMAP_WORD_BITS));
+
+    while (true) {
+        if (word) {
+            uint64_t pos = idx * BITMAP_WORD_BITS + __builtin_ctzll(word);
+            return (pos < to) ? pos : to;
+        }
+        if (++idx > last_idx) {
+            return to;
+        }
+        word = bitmap[idx];
+    }
+}
+
+uint64_t Bitmap_Chunking_Technique::last_candidate(uint64_t level,
+                                                   uint64_t from,
+                                                   uint64_t to) const {
+    if (from >= to) {
+        return to;
+    }
+    const uint64_t* bitmap = candidate_bitmaps[level].data();
+    uint64_t first_idx = from / BITMAP_WORD_BITS;
+    uint64_t idx = (to - 1) / BITMAP_WORD_BITS;
+    uint64_t word = bitmap[idx] &
+                    (~0ULL >> (BITMAP_WORD_BITS - 1 - (to - 1) % BITMAP_WORD_BITS));
+
+    while (true) {
+        if (idx == first_idx) {
+            word &= ~0ULL << (from % BITMAP_WORD_BITS);
+        }
+        if (word) {
+            return idx * BITMAP_WORD_BITS + (BITMAP_WORD_BITS - 1) - __builtin_clzll(word);
+        }
+        if (idx == first_idx) {
+            return to;
+        }
+        word = bitmap[--idx];
+    }
+}
+
+void Bitmap_Chunking_Technique::build_candidate_bitmaps(const char* buff,
+                                                        uint64_t size) {
+    uint64_t words = (size + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+    uint64_t* bitmaps[BITMAP_MAX_LEVELS] = {nullptr};
+    for (uint64_t level = 0; level < candidate_levels; level++) {
+        if (candidate_bitmaps[level].size() < words) {
+            candidate_bitmaps[level].resize(words);
+        }
+        bitmaps[level] = candidate_bitmaps[level].data();
+    }
+
+    uint64_t num_threads = std::min(candidate_bitmap_threads, words);
+    if (num_threads <= 1) {
+        mark_candidates(buff, 0, size, bitmaps);
+        return;
+    }
+
+    // Segments are aligned to bitmap words so no two threads write the same word
+    uint64_t words_per_thread = (words + num_threads - 1) / num_threads;
+    uint64_t segment_size = words_per_thread * BITMAP_WORD_BITS;
+    std::vector<std::thread> workers;
+    for (uint64_t start = segment_size; start < size; start += segment_size) {
+        uint64_t end = std::min(size, start + segment_size);
+        workers.emplace_back([this, buff, start, end, &bitmaps]() {
+            mark_candidates(buff, start, end, bitmaps);
+        });
+    }
+    mark_candidates(buff, 0, std::min(size, segment_size), bitmaps);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+uint64_t Bitmap_Chunking_Technique::chunk_stream(std::vector<std::string>& hashes,
+                                                 std::istream& stream, uint64_t length,
+                                                 uint64_t chunk_limit) {
+    if (!candidate_bitmap_enabled) {
+        return Chunking_Technique::chunk_stream(hashes, stream, length, chunk_limit);
+    }
+
+    // A region must hold at least one largest chunk past any leftover bytes so
+    // every chunk sees the same data find_cutpoint would have seen
+    uint64_t size_limit = chunk_size_limit();
+    uint64_t region_capacity =
+        std::max(candidate_bitmap_region_size, 2 * size_limit);
+    std::vector<char> region(region_capacity);
+    uint64_t bytes_left = length;
+    // logical region end
+    uint64_t region_end = 0;
+    // offset of the region from the start of the stream
+    uint64_t region_offset = 0;
+
+    while (region_offset < chunk_limit) {
+        uint64_t bytes_to_read = std::min(region_capacity - region_end, bytes_left);
+        stream.read(region.data() + region_end, bytes_to_read);
+        uint64_t bytes_read = stream.gcount();
+        region_end += bytes_read;
+        bytes_left = (bytes_read == bytes_to_read) ? bytes_left - bytes_read : 0;
+        if (region_end == 0) {
+            break;
+        }
+
+        auto begin_chunking = std::chrono::high_resolution_clock::now();
+        build_candidate_bitmaps(region.data(), region_end);
+        auto end_chunking = std::chrono::high_resolution_clock::now();
+        total_time_chunking += (end_chunking - begin_chunking);
+
+        uint64_t chunk_start = 0;
+        while (chunk_start < region_end && region_offset + chunk_start < chunk_limit) {
+            uint64_t bytes_available = region_end - chunk_start;
+            // Refill before the chunk would see less than its largest size
+            if (bytes_available < size_limit && bytes_left > 0) {
+                break;
+            }
+            begin_chunking = std::chrono::high_resolution_clock::now();
+            uint64_t chunk_size = find_cutpoint_bitmap(
+                region.data(), chunk_start, std::min(bytes_available, size_limit));
+            end_chunking = std::chrono::high_resolution_clock::now();
+            total_time_chunking += (end_chunking - begin_chunking);
+
+            emit_chunk(hashes, region.data() + chunk_start, chunk_size);
+            chunk_start += chunk_size;
+        }
+
+        region_offset += chunk_start;
+        region_end -= chunk_start;
+        memmove(region.data(), region.data() + chunk_start, region_end);
+        if (bytes_left == 0 && region_end == 0) {
+            break;
+        }
+    }
+    return region_offset;
+}
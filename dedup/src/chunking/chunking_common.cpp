@@ -11,6 +11,7 @@
 #include "chunking_common.hpp"
 #include "hashing_common.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <filesystem>
@@ -53,6 +54,13 @@ BYTE* File_Chunk::get_hash() const {
     return nullptr;
 }
 
+unsigned int File_Chunk::get_hash_size() const {
+    if (chunk_hash) {
+        return chunk_hash->getSize();
+    }
+    return 0;
+}
+
 void File_Chunk::init_hash(HashingTech hashing_tech, uint64_t size) {
     chunk_hash = std::make_unique<Hash>(hashing_tech, size);
 }
@@ -120,66 +128,173 @@ std::vector<std::string> Chunking_Technique::chunk_file(std::string file_path) {
     std::vector<std::string> hashes;
     std::ifstream file_ptr;
     file_ptr.open(file_path, std::ios::in);
-    chunk_stream(hashes, file_ptr);
+    uint64_t file_size = get_file_size(&file_ptr);
+    emitted_bytes = 0;
+    index_limit = UINT64_MAX;
+    chunk_stream(hashes, file_ptr, file_size, file_size);
+    return hashes;
+}
+
+std::vector<std::vector<std::string>> Chunking_Technique::chunk_files(
+    const std::vector<std::string>& file_paths) {
+    std::vector<std::vector<std::string>> hashes;
+    for (const auto& file_path : file_paths) {
+        hashes.push_back(chunk_file(file_path));
+    }
+    return hashes;
+}
+
+std::vector<std::string> Chunking_Technique::chunk_file_range(std::string file_path,
+                                                              uint64_t start, uint64_t end,
+                                                              uint64_t overlap) {
+    std::vector<std::string> hashes;
+    std::ifstream file_ptr;
+    file_ptr.open(file_path, std::ios::in | std::ios::binary);
+    uint64_t file_size = get_file_size(&file_ptr);
+    start = std::min(start, file_size);
+    end = std::max(start, std::min(end, file_size));
+    file_ptr.seekg(start, std::ios_base::beg);
+    emitted_bytes = 0;
+    index_limit = end - start;
+    chunk_stream(hashes, file_ptr, file_size - start, end - start + overlap);
     return hashes;
 }
 
-int64_t Chunking_Technique::create_chunk(std::vector<std::string>& hashes,
-                                         char* buffer, uint64_t buffer_end) {
+uint64_t Chunking_Technique::chunk_file_segment(std::string file_path, uint64_t start,
+                                                uint64_t limit, std::vector<std::string>& hashes) {
+    std::ifstream file_ptr;
+    file_ptr.open(file_path, std::ios::in | std::ios::binary);
+    uint64_t file_size = get_file_size(&file_ptr);
+    start = std::min(start, file_size);
+    file_ptr.seekg(start, std::ios_base::beg);
+    emitted_bytes = 0;
+    index_limit = UINT64_MAX;
+    return start + chunk_stream(hashes, file_ptr, file_size - start, limit);
+}
+
+uint64_t Chunking_Technique::chunk_size_limit() const {
+    uint64_t buffer_size = (stream_buffer_size == 0) ? 1024 * 1024 : stream_buffer_size;
+    return std::max(buffer_size, get_max_block_size());
+}
+
+uint64_t Chunking_Technique::resume_cutpoint(char* buff, uint64_t size, bool end_of_data) {
+    if (!end_of_data) {
+        return 0;
+    }
+    return find_cutpoint(buff, size);
+}
+
+uint64_t Chunking_Technique::find_cutpoints(char* buff, uint64_t size, bool end_of_data,
+                                            std::vector<uint64_t>& cuts) {
+    return cut_chunks(buff, size, end_of_data, cuts, [this](char* chunk, uint64_t chunk_size, bool complete) {
+        return resume_cutpoint(chunk, chunk_size, complete);
+    });
+}
+
+uint64_t Chunking_Technique::next_cutpoints(char* buff, uint64_t size, bool end_of_stream,
+                                            std::vector<uint64_t>& cuts) {
     //start timing chunking
     auto begin_chunking = std::chrono::high_resolution_clock::now();
-    uint64_t chunk_size = find_cutpoint(buffer, buffer_end);
+    uint64_t chunk_start = find_cutpoints(buff, size, end_of_stream, cuts);
     // finish timing chunking
     auto end_chunking = std::chrono::high_resolution_clock::now();
     total_time_chunking += (end_chunking - begin_chunking);
+    return chunk_start;
+}
+
+void Chunking_Technique::begin_feed() {
+    reset_scan();
+    feed_buffer.clear();
+    feed_offset = 0;
+}
+
+std::vector<uint64_t> Chunking_Technique::feed(const char* data, uint64_t length) {
+    std::vector<uint64_t> boundaries;
+    feed_buffer.insert(feed_buffer.end(), data, data + length);
+    uint64_t chunk_start = next_cutpoints(feed_buffer.data(), feed_buffer.size(), false, boundaries);
+    for (uint64_t& boundary : boundaries) {
+        boundary += feed_offset;
+    }
+    feed_buffer.erase(feed_buffer.begin(), feed_buffer.begin() + chunk_start);
+    feed_offset += chunk_start;
+    return boundaries;
+}
+
+std::vector<uint64_t> Chunking_Technique::end_feed() {
+    std::vector<uint64_t> boundaries;
+    next_cutpoints(feed_buffer.data(), feed_buffer.size(), true, boundaries);
+    for (uint64_t& boundary : boundaries) {
+        boundary += feed_offset;
+    }
+    begin_feed();
+    return boundaries;
+}
+
+void Chunking_Technique::emit_chunk(std::vector<std::string>& hashes,
+                                    char* data, uint64_t chunk_size) {
     // create chunk
     File_Chunk new_chunk{chunk_size};
-    memcpy(new_chunk.get_data(), buffer, chunk_size);
+    memcpy(new_chunk.get_data(), data, chunk_size);
     if(!disable_hashing){
         auto begin_hashing = std::chrono::high_resolution_clock::now();
         hash_method->hash_chunk(new_chunk);
         auto end_hashing = std::chrono::high_resolution_clock::now();
         total_time_hashing += (end_hashing - begin_hashing);
+        if (fingerprint_index && emitted_bytes < index_limit) {
+            fingerprint_index->insert(new_chunk.get_hash(), new_chunk.get_hash_size(), chunk_size);
+        }
     }
+    emitted_bytes += chunk_size;
     hashes.emplace_back(new_chunk.to_string());
-    return chunk_size;
 }
 
-void Chunking_Technique::chunk_stream(std::vector<std::string>& hashes,
-                                      std::istream& stream) {
-    std::vector<char> buffer;
-    int64_t buffer_size;
+uint64_t Chunking_Technique::chunk_stream(std::vector<std::string>& hashes,
+                                          std::istream& stream, uint64_t length,
+                                          uint64_t chunk_limit) {
+    uint64_t buffer_size;
     if(this->stream_buffer_size == 0){
         buffer_size = 1024 * 1024; // 1 Mib
     } else{
         buffer_size = this->stream_buffer_size;
     }
-    int64_t bytes_left = get_file_size(&stream);
-    buffer.reserve(buffer_size);
-    // initial chunk_size to allow the read of full buffer size
-    int64_t chunk_size = buffer_size;
+    // The buffer is refilled with reads of buffer_size bytes and holds two largest chunks, so one
+    // call of find_cutpoints cuts every chunk but the last, which grows until its cut-point is found
+    uint64_t buffer_capacity = 2 * chunk_size_limit();
+    std::vector<char> buffer(buffer_capacity);
+    uint64_t bytes_left = length;
     // logical buffer end
-    int64_t buffer_end = 0;
+    uint64_t buffer_end = 0;
+    // offset of the next chunk from the start of the stream
+    uint64_t chunk_start = 0;
+    // ends of the chunks found in the buffer
+    std::vector<uint64_t> cuts;
+    reset_scan();
 
-    while (true) {
-        uint32_t bytes_to_read =
-            std::min((int64_t)(buffer_size), std::min(bytes_left, chunk_size));
-        stream.read(buffer.data() + buffer_end, bytes_to_read);
-        if (stream.gcount() == 0) {
+    while (chunk_start < chunk_limit) {
+        while (buffer_end < buffer_capacity && bytes_left > 0) {
+            uint64_t bytes_to_read = std::min(std::min(buffer_size, buffer_capacity - buffer_end), bytes_left);
+            stream.read(buffer.data() + buffer_end, bytes_to_read);
+            uint64_t bytes_read = stream.gcount();
+            buffer_end += bytes_read;
+            bytes_left = (bytes_read == bytes_to_read) ? bytes_left - bytes_read : 0;
+        }
+        if (buffer_end == 0) {
             break;
         }
 
-        buffer_end += bytes_to_read;
-        chunk_size = create_chunk(hashes, buffer.data(), buffer_end);
-        buffer_end -= chunk_size;
-        memmove(&buffer[0], &buffer[chunk_size], buffer_end);
-        bytes_left -= bytes_to_read;
-    }
-    // finalize
-    while (buffer_end > 0) {
-        chunk_size = create_chunk(hashes, buffer.data(), buffer_end);
-        buffer_end -= chunk_size;
-        memmove(&buffer[0], &buffer[chunk_size], buffer_end);
+        cuts.clear();
+        next_cutpoints(buffer.data(), buffer_end, bytes_left == 0, cuts);
+        uint64_t cut_start = 0;
+        for (uint64_t cut : cuts) {
+            if (chunk_start >= chunk_limit) {
+                break;
+            }
+            emit_chunk(hashes, buffer.data() + cut_start, cut - cut_start);
+            chunk_start += cut - cut_start;
+            cut_start = cut;
+        }
+        buffer_end -= cut_start;
+        memmove(&buffer[0], &buffer[cut_start], buffer_end);
     }
-    return;
+    return chunk_start;
 }
@@ -12,6 +12,45 @@
 #include <crc_chunking.hpp>
 #include <fstream>
 
+#if defined(SIMD_CRC32C_KERNELS)
+    #if defined(SIMD_X86_KERNELS)
+        #define crc32c_byte(hash, byte) _mm_crc32_u8(hash, byte)
+    #else
+        #define crc32c_byte(hash, byte) __crc32cb(hash, byte)
+    #endif
+
+/**
+ * @brief: Extends a CRC32C hash by the bytes of [start, end) with the CRC32C
+ * instruction, which takes and returns the hash without conditioning
+*/
+SIMD_TARGET_CRC32C
+static uint32_t crc32c_extend_hardware(uint32_t hash, const char* buff, uint64_t start, uint64_t end){
+    for(uint64_t i = start; i < end; i++)
+        hash = crc32c_byte(hash, (uint8_t)buff[i]);
+    return hash;
+}
+
+/**
+ * @brief: Rolls a CRC32C window over [start, end) with the CRC32C instruction,
+ * see SS_CRC_Chunking::roll_hash
+*/
+SIMD_TARGET_CRC32C
+static uint64_t crc32c_roll_hardware(const char* buff, uint64_t start, uint64_t end, uint64_t window_size,
+                                     const uint32_t* out_table, uint32_t break_mask, uint32_t& hash){
+    uint32_t h = hash;
+    for(uint64_t i = start; i < end; i++){
+        h ^= out_table[(uint8_t)buff[i - window_size]];
+        h = crc32c_byte(h, (uint8_t)buff[i]);
+        if((h & break_mask) == ss_crc_magic_number){
+            hash = h;
+            return i;
+        }
+    }
+    hash = h;
+    return end;
+}
+#endif
+
 /**
  * @brief: Default Constructor
 */
@@ -24,8 +63,12 @@ SS_CRC_Chunking::SS_CRC_Chunking(){
     window_size = 256;
     hash_bits = 14;
     simd_mode = SIMD_Mode::NONE;
+    window_hash = true;
+    polynomial = CRC_Polynomial::CRC32;
+    crc32c_hardware = false;
+    hash_table = crct;
+    out_table = crcu;
 
-    boundary_candidates_bitmask = nullptr;
     total_size_chunked = 0;
 }
 
@@ -42,9 +85,100 @@ SS_CRC_Chunking::SS_CRC_Chunking(const Config &config){
     technique_name = "SS CRC Chunking";
  
     simd_mode = config.get_simd_mode();
+    if(simd_mode != SIMD_Mode::NONE && crc_lanes() == 0){
+        std::cout << "SIMD mode unsupported for CRC chunking. Please use avx256 or avx512." << std::endl;
+        exit(1);
+    }
+    polynomial = config.get_crc_polynomial();
+    crc32c_hardware = false;
+    hash_table = crct;
+    out_table = crcu;
+    if(polynomial == CRC_Polynomial::CRC32C){
+        hash_table = CRC32C_HASH_TABLE.table;
+        out_table = crc32c_out_table(window_size);
+        crc32c_hardware = crc32c_hardware_supported();
+        technique_name = "SS CRC32C Chunking";
+    }
+    // crcu only removes the byte leaving a window of SS_CRC_TABLE_WINDOW_SIZE bytes,
+    // other CRC32 windows are only chunked by find_cutpoint_native
+    window_hash = ((polynomial == CRC_Polynomial::CRC32C || window_size == SS_CRC_TABLE_WINDOW_SIZE) &&
+                   min_block_size >= window_size);
 
-    boundary_candidates_bitmask = nullptr;
     total_size_chunked = 0;
+    init_candidate_bitmap(config, 1);
+    run_skip = config.get_run_skip();
+    // As in SS-CDC, the SIMD kernels mark the candidates of whole regions and
+    // the cut-points are then selected from the bitmap
+    if(simd_mode != SIMD_Mode::NONE && window_hash && window_size == CRC_HASH_WINDOW_SIZE)
+        candidate_bitmap_enabled = true;
+}
+
+/**
+ * @brief: Builds the CRC32C table of a window size. A byte b leaving the window adds the CRC of
+ * b followed by window_size - 1 zero bytes to the hash, as CRC is linear
+*/
+const uint32_t* SS_CRC_Chunking::crc32c_out_table(uint64_t window_size){
+    return shared_table<CRC32C_Table>(window_size, [window_size](CRC32C_Table& out_table){
+        const uint32_t* hash_table = CRC32C_HASH_TABLE.table;
+        for(uint32_t b = 0; b < 256; b++){
+            uint32_t hash = hash_table[b];
+            for(uint64_t i = 1; i < window_size; i++)
+                hash = hash_table[hash & 0xff] ^ (hash >> 8);
+            out_table.table[b] = hash;
+        }
+    })->table;
+}
+
+/**
+ * @brief: Extends the hash by the bytes of [start, end)
+*/
+uint32_t SS_CRC_Chunking::extend_hash(uint32_t hash, const char* buff, uint64_t start, uint64_t end) const{
+    #if defined(SIMD_CRC32C_KERNELS)
+        if(crc32c_hardware)
+            return crc32c_extend_hardware(hash, buff, start, end);
+    #endif
+    const uint32_t* table = hash_table;
+    for(uint64_t i = start; i < end; i++)
+        hash = (hash >> 8) ^ table[(hash ^ buff[i]) & 0xff];
+    return hash;
+}
+
+/**
+ * @brief: Rolls the window over [start, end) until the hash matches the magic number
+*/
+uint64_t SS_CRC_Chunking::roll_hash(const char* buff, uint64_t start, uint64_t end, uint32_t& hash) const{
+    // Break mask is decided using hash bits - Influences avg chunk size
+    // Was set to 12, 13, 14 by SS-CDC for avg sizes of 4K, 8K and 16K
+    uint32_t break_mask = (1u << hash_bits) - 1;
+    #if defined(SIMD_CRC32C_KERNELS)
+        if(crc32c_hardware)
+            return crc32c_roll_hardware(buff, start, end, window_size, out_table, break_mask, hash);
+    #endif
+    const uint32_t* table = hash_table;
+    const uint32_t* out = out_table;
+    uint32_t h = hash;
+    for(uint64_t i = start; i < end; i++){
+
+        // Core CRC routine
+        h ^= out[(uint8_t)buff[i - window_size]];
+        h = (h >> 8) ^ table[(h ^ buff[i]) & 0xff];
+
+        if((h & break_mask) == ss_crc_magic_number){
+            hash = h;
+            return i;
+        }
+    }
+    hash = h;
+    return end;
+}
+
+bool SS_CRC_Chunking::supports_simd_mode(SIMD_Mode mode) const{
+    return mode == SIMD_Mode::NONE ||
+           ((mode == SIMD_Mode::AVX256 || mode == SIMD_Mode::AVX512) && simd_mode_supported(mode));
+}
+
+uint64_t SS_CRC_Chunking::get_max_block_size() const {
+    return max_block_size;
 }
 
 /**
@@ -54,14 +188,15 @@ SS_CRC_Chunking::SS_CRC_Chunking(const Config &config){
 */
 
 uint64_t SS_CRC_Chunking::find_cutpoint(char* buff, uint64_t size){
-    if(simd_mode == SIMD_Mode::NONE)
-        return find_cutpoint_native(buff, size);
-    
-    else{
-        std::cout << "SIMD mode unsupported for chosen chunking technique" << std::endl;
-        exit(1);
-    }
-        
+    // The SIMD kernels hash whole regions in the candidate bitmap mode, a single
+    // cut-point is found faster serially
+    return find_cutpoint_native(buff, size);
+}
+
+uint64_t SS_CRC_Chunking::find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts){
+    return cut_whole_chunks(buff, size, end_of_data, cuts, [this](char* chunk, uint64_t chunk_size){
+        return find_cutpoint_native(chunk, chunk_size);
+    });
 }
 
 /**
@@ -75,36 +210,111 @@ uint64_t SS_CRC_Chunking::find_cutpoint_native(char* buff, uint64_t size){
     if(size < min_block_size){
         return size;
     }
-    
-    uint32_t hash = 0;
 
-    // Break mask is decided using hash bits - Influences avg chunk size
-    // Was set to 12, 13, 14 by SS-CDC for avg sizes of 4K, 8K and 16K
+    // Without a candidate the chunk is cut at the maximum block size
+    size = std::min(size, max_block_size);
+    uint32_t hash = extend_hash(0, buff, min_block_size - window_size, min_block_size);
+    uint64_t cutpoint = min_block_size;
+    while(cutpoint < size){
+        // Once the window of a position lies in a run, the hash is the same at every position until
+        // the run ends and it does not match. Without window_hash, it also depends on the bytes before.
+        Byte_Run run = window_hash ? find_run(buff, cutpoint, size) : Byte_Run{size, size};
+        uint64_t serial_end = std::min(size, run.start + window_size);
+        cutpoint = roll_hash(buff, cutpoint, serial_end, hash);
+        if(cutpoint < serial_end)
+            break;
+        cutpoint = std::max(cutpoint, skip_run(buff, run, size));
+    }
+
+    total_size_chunked += cutpoint;
+    return cutpoint;
+}
+
+/**
+ * @brief: Marks the candidates of [start, end), with the CRC kernel of
+ * simd_mode where a lane can hash a full window and span whole bitmap words
+ * @param buff: Char * array of bytes
+ * @param start: First position to evaluate
+ * @param end: One past the last position to evaluate
+*/
+
+void SS_CRC_Chunking::mark_candidates(const char* buff, uint64_t start, uint64_t end, uint64_t** bitmaps){
+    if(simd_mode == SIMD_Mode::NONE || !window_hash || window_size != CRC_HASH_WINDOW_SIZE){
+        mark_candidates_native(buff, start, end, bitmaps);
+        return;
+    }
+
+    const uint64_t lanes = crc_lanes();
+    uint64_t vector_start = std::max(start, (uint64_t)CRC_HASH_WINDOW_SIZE);
+    uint64_t lane_span = (end > vector_start) ?
+        (end - vector_start) / (lanes * BITMAP_WORD_BITS) * BITMAP_WORD_BITS : 0;
+    if(lane_span == 0){
+        mark_candidates_native(buff, start, end, bitmaps);
+        return;
+    }
+    uint64_t vector_end = vector_start + lanes * lane_span;
+
+    if(start < vector_start)
+        mark_candidates_native(buff, start, vector_start, bitmaps);
     uint32_t break_mask = (1u << hash_bits) - 1;
+    mark_crc_candidates(buff, vector_start, lane_span, hash_table, out_table, break_mask, ss_crc_magic_number,
+                        bitmaps[0] + vector_start / BITMAP_WORD_BITS);
+    if(vector_end < end)
+        mark_candidates_native(buff, vector_end, end, bitmaps);
+}
 
-    for(uint64_t i = min_block_size - window_size; i < min_block_size; i++)
-        hash = (hash >> 8) ^ crct[(hash ^ buff[i]) & 0xff];
-    
-    
-    for(uint64_t i = min_block_size; i < size; i++){
+/**
+ * @brief: Marks the positions whose CRC over the preceding window matches
+ * the magic number
+ * @param buff: Char * array of bytes
+ * @param start: First position to evaluate
+ * @param end: One past the last position to evaluate
+*/
 
-        // Core CRC routine
-        hash ^= crcu[(uint8_t)buff[i - window_size]];
-        hash = (hash >> 8) ^ crct[(hash ^ buff[i]) & 0xff];
+void SS_CRC_Chunking::mark_candidates_native(const char* buff, uint64_t start, uint64_t end, uint64_t** bitmaps){
 
-        if((hash & break_mask) == ss_crc_magic_number){
-            total_size_chunked += i;
-            return i;
-        }
+    uint32_t break_mask = (1u << hash_bits) - 1;
+    std::fill(bitmaps[0] + start / BITMAP_WORD_BITS,
+              bitmaps[0] + (end + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS, 0);
+
+    // Warm up over the window preceding the segment, as find_cutpoint_native does
+    uint64_t window_start = (start >= window_size) ? start - window_size : 0;
+    uint32_t hash = extend_hash(0, buff, window_start, start);
+
+    // No byte leaves the window before the first window_size bytes of the region
+    uint64_t i = start;
+    for(; i < end && i < window_start + window_size; i++){
+        hash = extend_hash(hash, buff, i, i + 1);
+        if((hash & break_mask) == ss_crc_magic_number)
+            bitmaps[0][i / BITMAP_WORD_BITS] |= 1ULL << (i % BITMAP_WORD_BITS);
     }
 
-    total_size_chunked += size;
-    return size;
+    // Candidates are sparse, so each one is set as the rolling hash reaches it
+    while((i = roll_hash(buff, i, end, hash)) < end){
+        bitmaps[0][i / BITMAP_WORD_BITS] |= 1ULL << (i % BITMAP_WORD_BITS);
+        i++;
+    }
 }
 
-static inline int is_breakpoint(uint8_t* bitmask, uint64_t idx){
-	uint8_t b = bitmask[idx/8];
-	return ((b>>(idx%8)) & 0x1);
+/**
+ * @brief: Returns a single chunk boundary using the candidate bitmap
+ * @param buff: Char * array of bytes
+ * @param start: Position of the chunk in buff
+ * @param size: Size of the chunk's buffer
+*/
+
+uint64_t SS_CRC_Chunking::find_cutpoint_bitmap(char* buff, uint64_t start, uint64_t size){
+    // A CRC32 rolling hash only depends on the window when crcu matches the window size
+    if(!window_hash)
+        return find_cutpoint_native(buff + start, size);
+
+    if(size < min_block_size){
+        return size;
+    }
+
+    uint64_t cutpoint = next_candidate(0, start + min_block_size, start + std::min(size, max_block_size)) - start;
+    total_size_chunked += cutpoint;
+    return cutpoint;
 }
 
 
@@ -11,6 +11,7 @@
 
 #include "fastcdc.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -32,9 +33,99 @@ FastCDC::FastCDC(const Config& config) {
     int mask_bits = int(round(log2(avg_block_size)));
     small_mask = (1 << (mask_bits + normalization_level)) - 1 ;
     large_mask = (1 << (mask_bits - normalization_level)) - 1 ;
+
+    simd_mode = config.get_simd_mode();
+    if (simd_mode != SIMD_Mode::NONE && gear_lanes() == 0) {
+        std::cout << "SIMD mode unsupported for FastCDC. Please use avx256 or avx512." << std::endl;
+        exit(1);
+    }
+
+    init_candidate_bitmap(config, 2);
+    run_skip = config.get_run_skip();
+}
+
+bool FastCDC::supports_simd_mode(SIMD_Mode mode) const {
+    return mode == SIMD_Mode::NONE ||
+           ((mode == SIMD_Mode::AVX256 || mode == SIMD_Mode::AVX512) && simd_mode_supported(mode));
+}
+
+uint64_t FastCDC::get_max_block_size() const {
+    return max_block_size;
 }
 
 uint64_t FastCDC::find_cutpoint(char* data, uint64_t len) {
+    if (simd_mode == SIMD_Mode::NONE) {
+        return find_cutpoint_native(data, len);
+    }
+    return find_cutpoint_simd(data, len);
+}
+
+uint64_t FastCDC::find_cutpoints(char* data, uint64_t len, bool end_of_data, std::vector<uint64_t>& cuts) {
+    if (simd_mode == SIMD_Mode::NONE) {
+        return cut_whole_chunks(data, len, end_of_data, cuts, [this](char* chunk, uint64_t chunk_len) {
+            return find_cutpoint_native(chunk, chunk_len);
+        });
+    }
+    return cut_whole_chunks(data, len, end_of_data, cuts, [this](char* chunk, uint64_t chunk_len) {
+        return find_cutpoint_simd(chunk, chunk_len);
+    });
+}
+
+uint64_t FastCDC::find_cutpoint_native(char* data, uint64_t len) {
+    return find_cutpoint_native(data, len, avg_block_size, small_mask, large_mask);
+}
+
+template <class Avg_Size, class Small_Mask, class Large_Mask>
+uint64_t FastCDC::find_cutpoint_native(char* data, uint64_t len, Avg_Size avg_size,
+                                       Small_Mask small, Large_Mask large) {
+    uint64_t fp = 0;
+    uint64_t i = min_block_size;  // skip min block size
+    if (len < min_block_size) {
+        return len;
+    }
+    uint64_t length = std::min(len, max_block_size);
+    uint64_t first_phase = std::min<uint64_t>(length, avg_size);
+
+    return hash_until_cutpoint(data, i, length, first_phase, fp, small, large);
+}
+
+template <class Small_Mask, class Large_Mask>
+uint64_t FastCDC::hash_until_cutpoint(const char* data, uint64_t i, uint64_t length,
+                                      uint64_t first_phase, uint64_t fp,
+                                      Small_Mask small, Large_Mask large) {
+    while (i < length) {
+        // Once the window of a position lies in a run, the hash is the same
+        // at every position until the run ends. It does not match the mask
+        // of the phase the run started in, the large mask is still tested
+        // at first_phase.
+        Byte_Run run = find_run(data, i, length);
+        uint64_t serial_end = std::min(length, run.start + FASTCDC_WINDOW_SIZE);
+        for (; i < std::min(serial_end, first_phase); i++) {
+            fp = (fp << 1) + GEAR_TABLE[(uint8_t)data[i]];
+            if ((fp & small) == 0) {
+                return i ;
+            }
+        }
+
+        for (; i < serial_end; i++) {
+            fp = (fp << 1) + GEAR_TABLE[(uint8_t)data[i]];
+            if ((fp & large) == 0) {
+                return i;
+            }
+        }
+
+        uint64_t after_run = skip_run(data, run, length);
+        if (i < first_phase && after_run > first_phase) {
+            i = first_phase;
+        } else {
+            i = std::max(i, after_run);
+        }
+    }
+
+    return length; //Double check that this is safe to return length here
+}
+
+uint64_t FastCDC::find_cutpoint_simd(char* data, uint64_t len) {
     uint64_t fp = 0;
     uint64_t i = min_block_size;  // skip min block size
     if (len < min_block_size) {
@@ -43,21 +134,200 @@ uint64_t FastCDC::find_cutpoint(char* data, uint64_t len) {
     uint64_t length = std::min(len, max_block_size);
     uint64_t first_phase = std::min(length, avg_block_size);
 
-    for (; i < first_phase; i++) {
-        fp = (fp << 1) + GEAR_TABLE[(int)data[i]];
-        if ((fp & small_mask) == 0) {
-            return i ;
+    // Hashing starts at the minimum chunk size, so the first positions only
+    // see part of a window. The kernel hashes full windows, hash them serially.
+    uint64_t serial_end = std::min(length, std::max(min_block_size + FASTCDC_WINDOW_SIZE - 1,
+                                                    (uint64_t)FASTCDC_WINDOW_SIZE));
+    for (; i < serial_end; i++) {
+        fp = (fp << 1) + GEAR_TABLE[(uint8_t)data[i]];
+        if ((fp & (i < first_phase ? small_mask : large_mask)) == 0) {
+            return i;
         }
     }
 
-    for (; i < length; i++) {
-        fp = (fp << 1) + GEAR_TABLE[(int)data[i]];
-        if ((fp & large_mask) == 0) {
+    const uint64_t lanes = gear_lanes();
+    const uint64_t block_size = lanes * GEAR_SIMD_LANE_SPAN;
+    uint64_t small_words[AVX512_REGISTER_SIZE_INT64 * GEAR_SIMD_LANE_SPAN / BITMAP_WORD_BITS];
+    uint64_t large_words[AVX512_REGISTER_SIZE_INT64 * GEAR_SIMD_LANE_SPAN / BITMAP_WORD_BITS];
+    for (; i + block_size <= length; i += block_size) {
+        // Runs are skipped by the serial loop, which finishes the chunk
+        Byte_Run run = find_run(data, i, length);
+        if (run.start < run.end && run.start < i + block_size) {
+            break;
+        }
+
+        // Only evaluate the masks of the phases the block overlaps
+        uint64_t masks[2] = {small_mask, large_mask};
+        uint64_t* words[2] = {small_words, large_words};
+        if (i + block_size <= first_phase) {
+            mark_gear_candidates(data, i, GEAR_SIMD_LANE_SPAN, GEAR_TABLE, masks, 1, words);
+        } else if (i >= first_phase) {
+            mark_gear_candidates(data, i, GEAR_SIMD_LANE_SPAN, GEAR_TABLE, masks + 1, 1, words + 1);
+        } else {
+            mark_gear_candidates(data, i, GEAR_SIMD_LANE_SPAN, GEAR_TABLE, masks, 2, words);
+        }
+
+        for (uint64_t w = 0; w < block_size / BITMAP_WORD_BITS; w++) {
+            uint64_t pos = i + w * BITMAP_WORD_BITS;
+            uint64_t word;
+            if (pos + BITMAP_WORD_BITS <= first_phase) {
+                word = small_words[w];
+            } else if (pos >= first_phase) {
+                word = large_words[w];
+            } else {
+                uint64_t small_bits = (1ULL << (first_phase - pos)) - 1;
+                word = (small_words[w] & small_bits) | (large_words[w] & ~small_bits);
+            }
+            if (word) {
+                return pos + __builtin_ctzll(word);
+            }
+        }
+    }
+
+    // Hash the window preceding the remaining positions and finish serially
+    if (i > serial_end) {
+        fp = 0;
+        for (uint64_t j = i - (FASTCDC_WINDOW_SIZE - 1); j < i; j++) {
+            fp = (fp << 1) + GEAR_TABLE[(uint8_t)data[j]];
+        }
+    }
+    return hash_until_cutpoint(data, i, length, first_phase, fp, small_mask, large_mask);
+}
+
+void FastCDC::mark_candidates(const char* buff, uint64_t start, uint64_t end,
+                              uint64_t** bitmaps) {
+    if (simd_mode == SIMD_Mode::NONE) {
+        mark_candidates_native(buff, start, end, bitmaps);
+        return;
+    }
+
+    // The kernel needs a full window before its first position and lanes
+    // spanning whole bitmap words, the rest is marked by the native code
+    const uint64_t lanes = gear_lanes();
+    uint64_t vector_start = std::max(start, (uint64_t)FASTCDC_WINDOW_SIZE);
+    uint64_t lane_span = (end > vector_start) ?
+        (end - vector_start) / (lanes * BITMAP_WORD_BITS) * BITMAP_WORD_BITS : 0;
+    if (lane_span == 0) {
+        mark_candidates_native(buff, start, end, bitmaps);
+        return;
+    }
+    uint64_t vector_end = vector_start + lanes * lane_span;
+
+    if (start < vector_start) {
+        mark_candidates_native(buff, start, vector_start, bitmaps);
+    }
+    uint64_t masks[2] = {small_mask, large_mask};
+    uint64_t* words[2] = {bitmaps[FASTCDC_SMALL_MASK_LEVEL] + vector_start / BITMAP_WORD_BITS,
+                          bitmaps[FASTCDC_LARGE_MASK_LEVEL] + vector_start / BITMAP_WORD_BITS};
+    mark_gear_candidates(buff, vector_start, lane_span, GEAR_TABLE, masks, 2, words);
+    if (vector_end < end) {
+        mark_candidates_native(buff, vector_end, end, bitmaps);
+    }
+}
+
+void FastCDC::mark_candidates_native(const char* buff, uint64_t start, uint64_t end,
+                                     uint64_t** bitmaps) {
+    uint64_t fp = 0;
+    uint64_t small_word = 0;
+    uint64_t large_word = 0;
+
+    // Warm up with the bytes preceding the segment so that every position
+    // in [start, end) is hashed over its full window
+    uint64_t i = (start >= FASTCDC_WINDOW_SIZE - 1) ? start - (FASTCDC_WINDOW_SIZE - 1) : 0;
+    for (; i < start; i++) {
+        fp = (fp << 1) + GEAR_TABLE[(uint8_t)buff[i]];
+    }
+
+    for (; i < end; i++) {
+        fp = (fp << 1) + GEAR_TABLE[(uint8_t)buff[i]];
+        small_word |= (uint64_t)((fp & small_mask) == 0) << (i % BITMAP_WORD_BITS);
+        large_word |= (uint64_t)((fp & large_mask) == 0) << (i % BITMAP_WORD_BITS);
+        if (i % BITMAP_WORD_BITS == BITMAP_WORD_BITS - 1) {
+            bitmaps[FASTCDC_SMALL_MASK_LEVEL][i / BITMAP_WORD_BITS] = small_word;
+            bitmaps[FASTCDC_LARGE_MASK_LEVEL][i / BITMAP_WORD_BITS] = large_word;
+            small_word = 0;
+            large_word = 0;
+        }
+    }
+    if (end % BITMAP_WORD_BITS) {
+        bitmaps[FASTCDC_SMALL_MASK_LEVEL][end / BITMAP_WORD_BITS] = small_word;
+        bitmaps[FASTCDC_LARGE_MASK_LEVEL][end / BITMAP_WORD_BITS] = large_word;
+    }
+}
+
+uint64_t FastCDC::find_cutpoint_bitmap(char* buff, uint64_t start, uint64_t len) {
+    char* data = buff + start;
+    uint64_t fp = 0;
+    uint64_t i = min_block_size;  // skip min block size
+    if (len < min_block_size) {
+        return len;
+    }
+    uint64_t length = std::min(len, max_block_size);
+    uint64_t first_phase = std::min(length, avg_block_size);
+
+    // find_cutpoint starts hashing at the minimum chunk size, so the first
+    // positions after it only see part of a window. Hash them the same way.
+    uint64_t warmup_end = std::min(length, min_block_size + FASTCDC_WINDOW_SIZE - 1);
+    for (; i < warmup_end; i++) {
+        fp = (fp << 1) + GEAR_TABLE[(uint8_t)data[i]];
+        if ((fp & (i < first_phase ? small_mask : large_mask)) == 0) {
             return i;
         }
     }
+    if (i >= length) {
+        return length;
+    }
 
-    return length; //Double check that this is safe to return length here
+    if (i < first_phase) {
+        uint64_t cut = next_candidate(FASTCDC_SMALL_MASK_LEVEL, start + i, start + first_phase);
+        if (cut < start + first_phase) {
+            return cut - start;
+        }
+        i = first_phase;
+    }
+
+    return next_candidate(FASTCDC_LARGE_MASK_LEVEL, start + i, start + length) - start;
 }
 
 FastCDC::~FastCDC() {}
+
+bool FastCDC::begin_lane(uint64_t lane, const char* data, uint64_t chunk_start, uint64_t len,
+                         uint64_t& cut) {
+    (void)data;
+    // Same bounds as find_cutpoint_native
+    if (len < min_block_size) {
+        cut = chunk_start + len;
+        return false;
+    }
+    uint64_t length = std::min(len, max_block_size);
+    if (min_block_size >= length) {
+        cut = chunk_start + length;
+        return false;
+    }
+    stream_state.pos[lane] = chunk_start + min_block_size;
+    stream_state.end[lane] = chunk_start + length;
+    stream_state.phase[lane] = chunk_start + std::min(length, avg_block_size);
+    stream_state.hash[lane] = 0;
+    return true;
+}
+
+uint64_t FastCDC::advance_lanes(uint64_t active) {
+    return advance_gear_lanes(stream_state, active, GEAR_TABLE, small_mask, large_mask);
+}
+
+template <uint64_t AVG_BLOCK_SIZE, uint64_t NORMALIZATION_LEVEL>
+uint64_t FastCDC_Specialized<AVG_BLOCK_SIZE, NORMALIZATION_LEVEL>::find_cutpoint(char* data, uint64_t len) {
+    return find_cutpoint_native(data, len, Avg_Size{}, Small_Mask{}, Large_Mask{});
+}
+
+template <uint64_t AVG_BLOCK_SIZE, uint64_t NORMALIZATION_LEVEL>
+uint64_t FastCDC_Specialized<AVG_BLOCK_SIZE, NORMALIZATION_LEVEL>::find_cutpoints(char* data, uint64_t len, bool end_of_data,
+                                                                                std::vector<uint64_t>& cuts) {
+    return cut_whole_chunks(data, len, end_of_data, cuts, [this](char* chunk, uint64_t chunk_len) {
+        return find_cutpoint_native(chunk, chunk_len, Avg_Size{}, Small_Mask{}, Large_Mask{});
+    });
+}
+
+#define FASTCDC_SPECIALIZATION(AVG_BLOCK_SIZE, NORMALIZATION_LEVEL) \
+    template class FastCDC_Specialized<AVG_BLOCK_SIZE, NORMALIZATION_LEVEL>;
+FOR_EACH_FASTCDC_SPECIALIZATION(FASTCDC_SPECIALIZATION)
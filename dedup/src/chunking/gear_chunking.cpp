@@ -11,6 +11,7 @@
 
 #include "gear_chunking.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <fstream>
@@ -34,6 +35,24 @@ Gear_Chunking::Gear_Chunking(const Config& config) {
         }
         mask = mask << 1;
     }
+
+    simd_mode = config.get_simd_mode();
+    if (simd_mode != SIMD_Mode::NONE && gear_lanes() == 0) {
+        std::cout << "SIMD mode unsupported for Gear chunking. Please use avx256 or avx512." << std::endl;
+        exit(1);
+    }
+
+    init_candidate_bitmap(config, 1);
+    run_skip = config.get_run_skip();
+}
+
+bool Gear_Chunking::supports_simd_mode(SIMD_Mode mode) const {
+    return mode == SIMD_Mode::NONE ||
+           ((mode == SIMD_Mode::AVX256 || mode == SIMD_Mode::AVX512) && simd_mode_supported(mode));
+}
+
+uint64_t Gear_Chunking::get_max_block_size() const {
+    return max_block_size;
 }
 
 uint64_t Gear_Chunking::ghash(uint64_t h, unsigned char ch) {
@@ -41,6 +60,181 @@ uint64_t Gear_Chunking::ghash(uint64_t h, unsigned char ch) {
 }
 
 uint64_t Gear_Chunking::find_cutpoint(char* data, uint64_t size) {
+    // If given data is lower than the minimum chunk size, return data length.
+    if (size <= min_block_size) {
+        return size;
+    }
+    uint64_t idx = min_block_size;
+    return search_cutpoint(data, idx, std::min(size, max_block_size), true);
+}
+
+uint64_t Gear_Chunking::resume_cutpoint(char* data, uint64_t size, bool end_of_data) {
+    if (size <= min_block_size) {
+        return end_of_data ? size : 0;
+    }
+    uint64_t end = std::min(size, max_block_size);
+    bool finish = end_of_data || end == max_block_size;
+    uint64_t idx = (scan_pos == 0) ? min_block_size : scan_pos;
+    uint64_t cut = search_cutpoint(data, idx, end, finish);
+    if (cut < end || finish) {
+        scan_pos = 0;
+        return cut;
+    }
+    scan_pos = idx;
+    return 0;
+}
+
+void Gear_Chunking::reset_scan() {
+    scan_pos = 0;
+}
+
+uint64_t Gear_Chunking::find_cutpoints(char* data, uint64_t size, bool end_of_data,
+                                       std::vector<uint64_t>& cuts) {
+    return cut_chunks(data, size, end_of_data, cuts, [this](char* chunk, uint64_t chunk_size, bool complete) {
+        return Gear_Chunking::resume_cutpoint(chunk, chunk_size, complete);
+    });
+}
+
+uint64_t Gear_Chunking::search_cutpoint(const char* data, uint64_t& idx, uint64_t end, bool finish) {
+    if (simd_mode == SIMD_Mode::NONE) {
+        return find_cutpoint_native(data, idx, end);
+    }
+    return find_cutpoint_simd(data, idx, end, finish);
+}
+
+uint64_t Gear_Chunking::find_cutpoint_native(const char* data, uint64_t& idx, uint64_t end) {
+    uint64_t cut = hash_until_cutpoint(data, idx, end, hash_window(data, idx));
+    idx = end;
+    return cut;
+}
+
+uint64_t Gear_Chunking::hash_window(const char* data, uint64_t idx) {
+    // A byte is shifted out of the hash GEAR_WINDOW_SIZE positions after it
+    uint64_t hash = 0;
+    uint64_t first = std::max(min_block_size, idx - std::min(idx, (uint64_t)GEAR_WINDOW_SIZE - 1));
+    for (uint64_t i = first; i < idx; i++) {
+        hash = ghash(hash, data[i]);
+    }
+    return hash;
+}
+
+uint64_t Gear_Chunking::hash_until_cutpoint(const char* data, uint64_t idx,
+                                            uint64_t end, uint64_t hash) {
+    while (idx < end) {
+        // Once the window of a position lies in a run, the hash is the same
+        // at every position until the run ends and it is not a cut point
+        Byte_Run run = find_run(data, idx, end);
+        uint64_t serial_end = std::min(end, run.start + GEAR_WINDOW_SIZE);
+        for (; idx < serial_end; idx++) {
+            hash = ghash(hash, data[idx]);
+            if (!(hash & mask)) {
+                return idx;
+            }
+        }
+        idx = std::max(idx, skip_run(data, run, end));
+    }
+
+    return idx;
+}
+
+uint64_t Gear_Chunking::find_cutpoint_simd(const char* data, uint64_t& idx, uint64_t end, bool finish) {
+    // Hashing starts at the minimum chunk size, so the first positions only
+    // see part of a window. The kernel hashes full windows, hash them serially.
+    uint64_t serial_end = std::min(end, std::max(min_block_size + GEAR_WINDOW_SIZE - 1,
+                                                 (uint64_t)GEAR_WINDOW_SIZE));
+    if (idx < serial_end) {
+        uint64_t cut = hash_until_cutpoint(data, idx, serial_end, hash_window(data, idx));
+        if (cut < serial_end) {
+            return cut;
+        }
+        idx = serial_end;
+    }
+
+    const uint64_t lanes = gear_lanes();
+    const uint64_t block_size = lanes * GEAR_SIMD_LANE_SPAN;
+    uint64_t block_words[AVX512_REGISTER_SIZE_INT64 * GEAR_SIMD_LANE_SPAN / BITMAP_WORD_BITS];
+    uint64_t* words = block_words;
+    while (idx + block_size <= end) {
+        // Runs are skipped by the serial loop, which finishes the chunk
+        Byte_Run run = find_run(data, idx, end);
+        if (run.start < run.end && run.start < idx + block_size) {
+            break;
+        }
+        mark_gear_candidates(data, idx, GEAR_SIMD_LANE_SPAN, GEAR_TABLE, &mask, 1, &words);
+        for (uint64_t w = 0; w < block_size / BITMAP_WORD_BITS; w++) {
+            if (block_words[w]) {
+                return idx + w * BITMAP_WORD_BITS + __builtin_ctzll(block_words[w]);
+            }
+        }
+        idx += block_size;
+    }
+    if (!finish) {
+        return end;
+    }
+
+    // Hash the window preceding the remaining positions and finish serially
+    uint64_t cut = hash_until_cutpoint(data, idx, end, hash_window(data, idx));
+    idx = end;
+    return cut;
+}
+
+void Gear_Chunking::mark_candidates(const char* buff, uint64_t start,
+                                    uint64_t end, uint64_t** bitmaps) {
+    if (simd_mode == SIMD_Mode::NONE) {
+        mark_candidates_native(buff, start, end, bitmaps);
+        return;
+    }
+
+    // The kernel needs a full window before its first position and lanes
+    // spanning whole bitmap words, the rest is marked by the native code
+    const uint64_t lanes = gear_lanes();
+    uint64_t vector_start = std::max(start, (uint64_t)GEAR_WINDOW_SIZE);
+    uint64_t lane_span = (end > vector_start) ?
+        (end - vector_start) / (lanes * BITMAP_WORD_BITS) * BITMAP_WORD_BITS : 0;
+    if (lane_span == 0) {
+        mark_candidates_native(buff, start, end, bitmaps);
+        return;
+    }
+    uint64_t vector_end = vector_start + lanes * lane_span;
+
+    if (start < vector_start) {
+        mark_candidates_native(buff, start, vector_start, bitmaps);
+    }
+    uint64_t* words = bitmaps[0] + vector_start / BITMAP_WORD_BITS;
+    mark_gear_candidates(buff, vector_start, lane_span, GEAR_TABLE, &mask, 1, &words);
+    if (vector_end < end) {
+        mark_candidates_native(buff, vector_end, end, bitmaps);
+    }
+}
+
+void Gear_Chunking::mark_candidates_native(const char* buff, uint64_t start,
+                                           uint64_t end, uint64_t** bitmaps) {
+    uint64_t hash = 0;
+    uint64_t word = 0;
+
+    // Warm up with the bytes preceding the segment so that every position
+    // in [start, end) is hashed over its full window
+    uint64_t idx = (start >= GEAR_WINDOW_SIZE - 1) ? start - (GEAR_WINDOW_SIZE - 1) : 0;
+    for (; idx < start; idx++) {
+        hash = ghash(hash, buff[idx]);
+    }
+
+    for (; idx < end; idx++) {
+        hash = ghash(hash, buff[idx]);
+        word |= (uint64_t)!(hash & mask) << (idx % BITMAP_WORD_BITS);
+        if (idx % BITMAP_WORD_BITS == BITMAP_WORD_BITS - 1) {
+            bitmaps[0][idx / BITMAP_WORD_BITS] = word;
+            word = 0;
+        }
+    }
+    if (end % BITMAP_WORD_BITS) {
+        bitmaps[0][end / BITMAP_WORD_BITS] = word;
+    }
+}
+
+uint64_t Gear_Chunking::find_cutpoint_bitmap(char* buff, uint64_t start,
+                                             uint64_t size) {
+    char* data = buff + start;
     uint64_t hash = 0;
     uint64_t idx = min_block_size;
 
@@ -48,8 +242,12 @@ uint64_t Gear_Chunking::find_cutpoint(char* data, uint64_t size) {
     if (size <= min_block_size) {
         return size;
     }
+    uint64_t end = std::min(size, max_block_size);
 
-    while (idx < size && idx < max_block_size) {
+    // find_cutpoint starts hashing at the minimum chunk size, so the first
+    // positions after it only see part of a window. Hash them the same way.
+    uint64_t warmup_end = std::min(end, min_block_size + GEAR_WINDOW_SIZE - 1);
+    while (idx < warmup_end) {
         hash = ghash(hash, data[idx]);
         if (!(hash & mask)) {
             return idx;
@@ -57,6 +255,32 @@ uint64_t Gear_Chunking::find_cutpoint(char* data, uint64_t size) {
         idx += 1;
     }
 
-    return idx;
+    if (idx >= end) {
+        return idx;
+    }
+    return next_candidate(0, start + idx, start + end) - start;
 }
 
+bool Gear_Chunking::begin_lane(uint64_t lane, const char* data, uint64_t chunk_start,
+                               uint64_t size, uint64_t& cut) {
+    (void)data;
+    // Same bounds as find_cutpoint
+    if (size <= min_block_size) {
+        cut = chunk_start + size;
+        return false;
+    }
+    uint64_t end = std::min(size, max_block_size);
+    if (min_block_size >= end) {
+        cut = chunk_start + min_block_size;
+        return false;
+    }
+    stream_state.pos[lane] = chunk_start + min_block_size;
+    stream_state.end[lane] = chunk_start + end;
+    stream_state.phase[lane] = chunk_start + end;
+    stream_state.hash[lane] = 0;
+    return true;
+}
+
+uint64_t Gear_Chunking::advance_lanes(uint64_t active) {
+    return advance_gear_lanes(stream_state, active, GEAR_TABLE, mask, mask);
+}
@@ -9,7 +9,9 @@
  *
  */
 
+ #include <algorithm>
  #include <fstream>
+ #include <type_traits>
  #include "maxp_chunking.hpp"
  
  MAXP_Chunking::MAXP_Chunking(){
@@ -17,27 +19,6 @@
     max_block_size = DEFAULT_MAXP_MAX_BLOCK_SIZE;
     simd_mode = SIMD_Mode::NONE;
 
-    
-    #ifdef __SSE3__
-    xmm_array = nullptr;
-    #endif
-
-    #ifdef __AVX2__
-    ymm_array = nullptr;
-    #endif
-
-    #if defined(__AVX512F__)
-    zmm_array = nullptr;
-    #endif
-
-    #if defined(__ARM_NEON)
-    neon_array = nullptr;
-    #endif
-
-    #ifdef __ALTIVEC__
-    altivec_array = nullptr;
-    #endif
-
     chunk_counter = 0;
  }
  
@@ -45,227 +26,48 @@
     window_size = config.get_maxp_window_size();
     max_block_size = config.get_maxp_max_block_size();
     simd_mode = config.get_simd_mode();
-
-    #ifdef __SSE3__
-    xmm_array = nullptr;
-    #endif
-
-    #ifdef __AVX2__
-    ymm_array = nullptr;
-    #endif
-    
-    #if defined(__AVX512F__)
-    zmm_array = nullptr;
-    #endif
-
-    #if defined(__ARM_NEON)
-    neon_array = nullptr;
-    #endif
-
-    #ifdef __ALTIVEC__
-    altivec_array = nullptr;
-    #endif
+    run_skip = config.get_run_skip();
 
     chunk_counter = 0;
 
-    if(simd_mode == SIMD_Mode::NONE) {
-        // No SIMD mode selected
-        // Pass
-    }
-
-    #ifdef __SSE3__
-    else if(simd_mode == SIMD_Mode::SSE128) {
-        if(window_size % SSE_REGISTER_SIZE_BYTES != 0 || (window_size / 16) % 2 != 0) {
-            // Check if window size is a multiple of 16
-            // Check if window size makes an even number of vectors for find_maximum_sse128
-            std::cout << "MAXP window size currently unsupported by SSE128. Please use an even multiple of SSE128_REGISTER_SIZE_BYTES (default 16)." << std::endl;
-            exit(1);
-        }
-        uint64_t num_vectors = window_size / SSE_REGISTER_SIZE_BYTES;
-        xmm_array = new __m128i[num_vectors]();
-        if(xmm_array == nullptr) {
-            std::cout << "Error allocating memory for 128-bit vectors (__m128i)" << std::endl;
-            exit(1);
-        }
-    }
-    #endif
-
-    #ifdef __AVX2__
-    else if(simd_mode == SIMD_Mode::AVX256) {
-        if(window_size % AVX256_REGISTER_SIZE_BYTES != 0 || (window_size / 32) % 2 != 0) {
-            // Check if window size is a multiple of 32
-            // Check if window size makes an even number of vectors for find_maximum_AVX256
-            std::cout << "MAXP window size currently unsupported by AVX256. Please use an even multiple of AVX_REGISTER_SIZE_BYTES (default 32)." << std::endl;
+    switch (simd_mode) {
+        case SIMD_Mode::NONE:
+        #ifdef SIMD_SSE128_KERNELS
+        case SIMD_Mode::SSE128:
+        case SIMD_Mode::SSE128_NOSLIDE:
+        #endif
+        #ifdef SIMD_AVX256_KERNELS
+        case SIMD_Mode::AVX256:
+        case SIMD_Mode::AVX256_NOSLIDE:
+        #endif
+        #ifdef SIMD_AVX512_KERNELS
+        case SIMD_Mode::AVX512:
+        case SIMD_Mode::AVX512_NOSLIDE:
+        #endif
+        #ifdef SIMD_NEON_KERNELS
+        case SIMD_Mode::NEON:
+        #endif
+        #ifdef SIMD_ALTIVEC_KERNELS
+        case SIMD_Mode::ALTIVEC:
+        #endif
+            break;
+        default:
+            std::cout << "Unsupported SIMD Mode for MAXP" << std::endl;
             exit(1);
-        }
-        uint64_t num_vectors = window_size / AVX256_REGISTER_SIZE_BYTES;
-        ymm_array = new __m256i[num_vectors]();
-        if(ymm_array == nullptr) {
-            std::cout << "Error allocating memory for 256-bit vectors(__m256i)" << std::endl;
-            exit(1);
-        }
-    }
-    #endif
-
-    #if defined(__AVX512F__)
-    else if(simd_mode == SIMD_Mode::AVX512) {
-        if(window_size % AVX512_REGISTER_SIZE_BYTES != 0 || (window_size / 64) % 2 != 0) {
-            // Check if window size is a multiple of 64
-            // Check if window size makes an even number of vectors for find_maximum_AVX512
-            std::cout << "MAXP window size currently unsupported by AVX512. Please use an even multiple of AVX_REGISTER_SIZE_BYTES (default 64)." << std::endl;
-            exit(1);
-        }
-        uint64_t num_vectors = window_size / AVX512_REGISTER_SIZE_BYTES;
-        zmm_array = new __m512i[num_vectors]();
-        if(zmm_array == nullptr) {
-            std::cout << "Error allocating memory for 512-bit vectors(__m512i)" << std::endl;
-            exit(1);
-        }
-    }
-    #endif
-
-    #if defined(__ARM_NEON)
-    else if(simd_mode == SIMD_Mode::NEON) {
-        if(window_size % NEON_REGISTER_SIZE_BYTES != 0 || (window_size / 16) % 2 != 0) {
-            // Check if window size is a multiple of 16
-            // Check if window size makes an even number of vectors for find_maximum_neon
-            std::cout << "MAXP window size currently unsupported by NEON. Please use an even multiple of NEON_REGISTER_SIZE_BYTES (default 16)." << std::endl;
-            exit(1);
-        }
-        uint64_t num_vectors = window_size / NEON_REGISTER_SIZE_BYTES;
-        neon_array = new uint8x16_t[num_vectors]();
-        if(neon_array == nullptr) {
-            std::cout << "Error allocating memory for NEON vectors(uint8x16_t)" << std::endl;
-            exit(1);
-        }
-    }
-    #endif
-
-    #ifdef __ALTIVEC__
-    else if(simd_mode == SIMD_Mode::ALTIVEC) {
-        if(window_size % ALTIVEC_REGISTER_SIZE_BYTES != 0 || (window_size / 16) % 2 != 0) {
-            // Check if window size is a multiple of 16
-            // Check if window size makes an even number of vectors for find_maximum_altivec
-            std::cout << "MAXP window size currently unsupported by ALTIVEC. Please use an even multiple of ALTIVEC_REGISTER_SIZE_BYTES (default 16)." << std::endl;
-            exit(1);
-        }
-        uint64_t num_vectors = window_size / ALTIVEC_REGISTER_SIZE_BYTES;
-        altivec_array = new __vector unsigned char[num_vectors]();
-        if(altivec_array == nullptr) {
-            std::cout << "Error allocating memory for ALTIVEC vectors(__vector unsigned char)" << std::endl;
-            exit(1);
-        }
-    }
-    #endif
-    
-    else {
-        std::cout << "Unsupported SIMD Mode for MAXP" << std::endl;
-        exit(1);
     }
  }
 
- #ifdef __SSE3__
- uint64_t MAXP_Chunking::find_cutpoint_sse128(char *buff, uint64_t size){
-    if(size < (2 * window_size) + 1)
-        return size;
-    
-    // Cap out max size
-    size = std::min(size, max_block_size);
+template <class Vector>
+uint64_t MAXP_Chunking::find_cutpoint_simd(char *buff, uint64_t size){
+    if constexpr (is_no_slide_vector<Vector>)
+        return find_cutpoint_noslide<Vector>(buff, size);
 
-    uint8_t max_value;
-    uint8_t backward_max = 0;
-    uint64_t max_pos = window_size;
-
-    uint64_t return_pos_range_scan;
-
-    while(max_pos < (size - window_size)){
-
-        max_value = (uint8_t)buff[max_pos];
-
-        return_pos_range_scan = range_scan_geq_sse128(buff, max_pos + 1, max_pos + 1 + window_size, max_value);
-        if(return_pos_range_scan == max_pos + window_size + 1){
-            // No match found i.e. all bytes in range are less than max_value
-            // Start backward scan to verify if target is a local max
-
-            backward_max = find_maximum_sse128(buff, max_pos - window_size, max_pos, xmm_array);
-            
-            // No bytes > max value in the backward region i.e. max_value is a local max
-            // Chunk boundary found
-            if(backward_max <= max_value){
-                return max_pos;
-            }
-            else {
-                // Nothing until max_pos + window_size + 1 can be a chunk boundary now
-                max_pos += window_size + 1;
-            }
-
-        }
-        else {
-            // Update maximum value
-            max_pos = return_pos_range_scan;
-        }
-    }
-
-    // No chunk boundary found
-    return size;
-
-}
-#endif
-
-#ifdef __AVX2__
-uint64_t MAXP_Chunking::find_cutpoint_avx256(char *buff, uint64_t size){
     if(size < (2 * window_size) + 1)
         return size;
-
-    // Cap out max size
-    size = std::min(size, max_block_size);
-
-    uint8_t max_value;
-    uint8_t backward_max = 0;
-    uint64_t max_pos = window_size;
-
-    uint64_t return_pos_range_scan;
-
-    while(max_pos < (size - window_size)){
-
-        max_value = (uint8_t)buff[max_pos];
-
-        return_pos_range_scan = range_scan_geq_avx256(buff, max_pos + 1, max_pos + 1 + window_size, max_value);
-        if(return_pos_range_scan == max_pos + window_size + 1){
-            // No match found i.e. all bytes in range are less than max_value
-            // Start backward scan to verify if target is a local max
-
-            backward_max = find_maximum_avx256(buff, max_pos - window_size, max_pos, ymm_array);
-            
-            // No bytes > max value in the backward region i.e. max_value is a local max
-            // Chunk boundary found
-            if(backward_max <= max_value){
-                return max_pos;
-            }
-            else {
-                // Nothing until max_pos + window_size + 1 can be a chunk boundary now
-                max_pos += window_size + 1;
-            }
-
-        }
-        else {
-            // Update maximum value
-            max_pos = return_pos_range_scan;
-        }
-    }
-
-    // No chunk boundary found
-    return size;
-}
-#endif
     
-#if defined(__AVX512F__)
-uint64_t MAXP_Chunking::find_cutpoint_avx512(char *buff, uint64_t size){
-    if(size < (2 * window_size) + 1)
-        return size;
-
     // Cap out max size
     size = std::min(size, max_block_size);
+    reset_block_extrema(buff, size);
 
     uint8_t max_value;
     uint8_t backward_max = 0;
@@ -273,16 +75,17 @@ uint64_t MAXP_Chunking::find_cutpoint_avx512(char *buff, uint64_t size){
 
     uint64_t return_pos_range_scan;
 
-    while(max_pos < (size - window_size)){
+    // Same end of the search as the native one, which needs the byte after the window of a maximum
+    while(max_pos + window_size < size - 1){
 
         max_value = (uint8_t)buff[max_pos];
 
-        return_pos_range_scan = range_scan_geq_avx512(buff, max_pos + 1, max_pos + 1 + window_size, max_value);
+        return_pos_range_scan = Vector::template range_scan<Scan_Op::GEQ>(buff, max_pos + 1, max_pos + 1 + window_size, max_value);
         if(return_pos_range_scan == max_pos + window_size + 1){
             // No match found i.e. all bytes in range are less than max_value
             // Start backward scan to verify if target is a local max
 
-            backward_max = find_maximum_avx512(buff, max_pos - window_size, max_pos, zmm_array);
+            backward_max = range_maximum(max_pos - window_size, max_pos);
             
             // No bytes > max value in the backward region i.e. max_value is a local max
             // Chunk boundary found
@@ -298,6 +101,9 @@ uint64_t MAXP_Chunking::find_cutpoint_avx512(char *buff, uint64_t size){
         else {
             // Update maximum value
             max_pos = return_pos_range_scan;
+            // Each byte of a run of the new maximum would become the maximum in turn
+            if(run_skip && max_pos + 1 < size && buff[max_pos + 1] == buff[max_pos])
+                max_pos = run_end(buff, max_pos + 1, size, (uint8_t)buff[max_pos]) - 1;
         }
     }
 
@@ -305,102 +111,39 @@ uint64_t MAXP_Chunking::find_cutpoint_avx512(char *buff, uint64_t size){
     return size;
 
 }
-#endif
 
-#if defined(__ARM_NEON)
-uint64_t MAXP_Chunking::find_cutpoint_neon(char *buff, uint64_t size){
+template <class Vector>
+uint64_t MAXP_Chunking::find_cutpoint_noslide(char *buff, uint64_t size){
     if(size < (2 * window_size) + 1)
         return size;
 
-    // Cap out max size
     size = std::min(size, max_block_size);
-
-    uint8_t max_value;
-    uint8_t backward_max = 0;
     uint64_t max_pos = window_size;
 
-    uint64_t return_pos_range_scan;
-
-    while(max_pos < (size - window_size)){
-
-        max_value = (uint8_t)buff[max_pos];
-
-        return_pos_range_scan = range_scan_geq_neon(buff, max_pos + 1, max_pos + 1 + window_size, max_value);
-        if(return_pos_range_scan == max_pos + window_size + 1){
-            // No match found i.e. all bytes in range are less than max_value
-            // Start backward scan to verify if target is a local max
-
-            backward_max = find_maximum_neon(buff, max_pos - window_size, max_pos, neon_array);
-            
-            // No bytes > max value in the backward region i.e. max_value is a local max
-            // Chunk boundary found
-            if(backward_max <= max_value){
+    // Same end of the search as the sliding and native ones
+    while(max_pos + window_size < size - 1){
+        uint8_t max_value = (uint8_t)buff[max_pos];
+        uint8_t forward_max = Vector::template find_extremum<true>(buff, max_pos + 1, max_pos + 1 + window_size);
+        if(forward_max < max_value){
+            // max_value is a local max if no byte before it is larger
+            if(Vector::template find_extremum<true>(buff, max_pos - window_size, max_pos) <= max_value)
                 return max_pos;
-            }
-            else {
-                // Nothing until max_pos + window_size + 1 can be a chunk boundary now
-                max_pos += window_size + 1;
-            }
-
+            // Nothing until max_pos + window_size + 1 can be a chunk boundary now
+            max_pos += window_size + 1;
         }
         else {
-            // Update maximum value
-            max_pos = return_pos_range_scan;
+            // The bytes before the first one reaching forward_max have it in the window after them, so the
+            // search jumps to it
+            max_pos = Vector::template range_scan<Scan_Op::GEQ>(buff, max_pos + 1, max_pos + 1 + window_size, forward_max);
+            // Each byte of a run of the new maximum would become the maximum in turn
+            if(run_skip && max_pos + 1 < size && buff[max_pos + 1] == buff[max_pos])
+                max_pos = run_end(buff, max_pos + 1, size, (uint8_t)buff[max_pos]) - 1;
         }
     }
 
     // No chunk boundary found
     return size;
-
 }
-#endif
-
-#ifdef __ALTIVEC__
-uint64_t MAXP_Chunking::find_cutpoint_altivec(char *buff, uint64_t size){
-    if(size < (2 * window_size) + 1){
-        return size;
-    }
-    
-    // Cap out max size
-    size = std::min(size, max_block_size);
-    uint8_t max_value;
-    uint8_t backward_max = 0;
-    uint64_t max_pos = window_size;
-    uint64_t return_pos_range_scan;
-
-    while(max_pos < (size - window_size)){
-
-        max_value = (uint8_t)buff[max_pos];
-        
-        return_pos_range_scan = range_scan_geq_altivec(buff, max_pos + 1, max_pos + 1 + window_size, max_value);
-        
-        if(return_pos_range_scan == max_pos + window_size + 1){
-            // No match found i.e. all bytes in range are less than max_value
-            // Start backward scan to verify if target is a local max
-        
-            backward_max = find_maximum_altivec(buff, max_pos - window_size, max_pos, altivec_array);
-        
-            // No bytes > max value in the backward region i.e. max_value is a local max
-            // Chunk boundary found
-            if(backward_max <= max_value){
-                return max_pos;
-            }
-            else {
-                // Nothing until max_pos + window_size + 1 can be a chunk boundary now
-                max_pos += window_size + 1;
-            }
-
-        }
-        else {
-            // Update maximum value
-            max_pos = return_pos_range_scan;
-        }
-    }
-
-    // N:wqo chunk boundary found
-    return size;
-}
-#endif
 
 uint64_t MAXP_Chunking::find_cutpoint_native(char *buff, uint64_t size){
  
@@ -408,39 +151,51 @@ uint64_t MAXP_Chunking::find_cutpoint_native(char *buff, uint64_t size){
         return size;
      }
 
-
      size = std::min(size, max_block_size);
 
+     const uint8_t *bytes = (const uint8_t *)buff;
      uint64_t max_position = window_size;
-     uint8_t max_value = (uint8_t)buff[max_position];
-     uint64_t j;
-     bool local_max_found = false;
+     uint8_t max_value = bytes[max_position];
  
      // Scan window from left to right looking for a byte with a value > all bytes in a "window_size" after it
-     for(uint64_t i = window_size; i < size - 1; i++){
- 
-         if((uint8_t)buff[i] >= max_value){
-            max_position = i;
-            max_value = (uint8_t)buff[i];
-         }
-         else if(i == max_position + window_size){ 
-            // Target byte found
-            // Initiate backward scanning to see if i is local maximum
-            local_max_found = true;
-                
-            for(j = max_position - window_size; j < max_position; j++){
-                if((uint8_t)buff[j] > max_value){
-                    max_position = i+1;
-                    max_value = (uint8_t)buff[i+1];
-                    local_max_found = false;
-                    break;
+     uint64_t i = window_size;
+     while(i < size - 1){
+        Byte_Run run = find_run(buff, i, size - 1);
+        uint64_t segment_end = std::min(size - 1, run.start + 1);
+        for(; i < segment_end; i++){
+             if(bytes[i] >= max_value){
+                max_position = i;
+                max_value = bytes[i];
+             }
+             else if(i == max_position + window_size){ 
+                // Target byte found
+                // Check that no byte in the window before it is larger. The maximum of the window
+                // is a reduction without early exit, which the compiler vectorizes on any target.
+                // The windows of two checks never overlap, so every byte is read at most twice.
+                uint8_t left_max = 0;
+                for(uint64_t j = max_position - window_size; j < max_position; j++){
+                    left_max = std::max(left_max, bytes[j]);
                 }
+
+                // Insert chunk boundary at max_position (not i) i.e. chunk boundary does not include right window
+                if(left_max <= max_value){
+                    return max_position;
+                }
+                max_position = i+1;
+                max_value = bytes[i+1];
             }
- 
-            // Insert chunk boundary at max_position (not i) i.e. chunk boundary does not include right window
-            if(local_max_found == true){
-                return max_position;
+        }
+
+        // Past its first byte, a run either keeps moving the maximum to its last byte
+        // or leaves it alone until the window after the maximum ends
+        if(i < run.end){
+            uint64_t after_run = skip_run(buff, run, size - 1);
+            if(max_value == bytes[run.start] && max_position >= run.start){
+                i = after_run;
+                max_position = i - 1;
             }
+            else
+                i = std::min(after_run, max_position + window_size);
         }
     }
     
@@ -454,33 +209,42 @@ uint64_t MAXP_Chunking::find_cutpoint_native(char *buff, uint64_t size){
         return find_cutpoint_native(buff, size);
     }
     
-    #ifdef __SSE3__
+    #ifdef SIMD_SSE128_KERNELS
     else if(simd_mode == SIMD_Mode::SSE128) {
-        return find_cutpoint_sse128(buff, size);
+        return find_cutpoint_simd<SSE128_Vector>(buff, size);
+    }
+    else if(simd_mode == SIMD_Mode::SSE128_NOSLIDE) {
+        return find_cutpoint_simd<No_Slide_Vector<SSE128_Vector>>(buff, size);
     }
     #endif
     
-    #ifdef __AVX2__
+    #ifdef SIMD_AVX256_KERNELS
     else if(simd_mode == SIMD_Mode::AVX256) {
-        return find_cutpoint_avx256(buff, size);
+        return find_cutpoint_simd<AVX256_Vector>(buff, size);
+    }
+    else if(simd_mode == SIMD_Mode::AVX256_NOSLIDE) {
+        return find_cutpoint_simd<No_Slide_Vector<AVX256_Vector>>(buff, size);
     }
     #endif
 
-    #if defined(__AVX512F__)
+    #if defined(SIMD_AVX512_KERNELS)
     else if(simd_mode == SIMD_Mode::AVX512) {
-        return find_cutpoint_avx512(buff, size);
+        return find_cutpoint_simd<AVX512_Vector>(buff, size);
+    }
+    else if(simd_mode == SIMD_Mode::AVX512_NOSLIDE) {
+        return find_cutpoint_simd<No_Slide_Vector<AVX512_Vector>>(buff, size);
     }
     #endif
 
-    #if defined(__ARM_NEON)
+    #if defined(SIMD_NEON_KERNELS)
     else if(simd_mode == SIMD_Mode::NEON) {
-        return find_cutpoint_neon(buff, size);
+        return find_cutpoint_simd<NEON_Vector>(buff, size);
     }
     #endif
 
-    #ifdef __ALTIVEC__
+    #ifdef SIMD_ALTIVEC_KERNELS
     else if(simd_mode == SIMD_Mode::ALTIVEC) {
-        return find_cutpoint_altivec(buff, size);
+        return find_cutpoint_simd<ALTIVEC_Vector>(buff, size);
     }
     #endif
 
@@ -489,31 +253,89 @@ uint64_t MAXP_Chunking::find_cutpoint_native(char *buff, uint64_t size){
         exit(1);
     }
  }
- 
- MAXP_Chunking::~MAXP_Chunking(){
-    
-    #ifdef __SSE3__
-    if(xmm_array != nullptr)
-        delete xmm_array;
+
+ uint64_t MAXP_Chunking::find_cutpoints(char *buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts){
+    if(simd_mode == SIMD_Mode::NONE) {
+        return find_cutpoints_for<void>(buff, size, end_of_data, cuts);
+    }
+
+    #ifdef SIMD_SSE128_KERNELS
+    else if(simd_mode == SIMD_Mode::SSE128) {
+        return find_cutpoints_for<SSE128_Vector>(buff, size, end_of_data, cuts);
+    }
+    else if(simd_mode == SIMD_Mode::SSE128_NOSLIDE) {
+        return find_cutpoints_for<No_Slide_Vector<SSE128_Vector>>(buff, size, end_of_data, cuts);
+    }
     #endif
 
-    #ifdef __AVX2__
-    if(ymm_array != nullptr)
-        delete ymm_array;
-    #endif 
+    #ifdef SIMD_AVX256_KERNELS
+    else if(simd_mode == SIMD_Mode::AVX256) {
+        return find_cutpoints_for<AVX256_Vector>(buff, size, end_of_data, cuts);
+    }
+    else if(simd_mode == SIMD_Mode::AVX256_NOSLIDE) {
+        return find_cutpoints_for<No_Slide_Vector<AVX256_Vector>>(buff, size, end_of_data, cuts);
+    }
+    #endif
 
-    #if defined(__AVX512F__)
-    if(zmm_array != nullptr)
-        delete zmm_array;
+    #if defined(SIMD_AVX512_KERNELS)
+    else if(simd_mode == SIMD_Mode::AVX512) {
+        return find_cutpoints_for<AVX512_Vector>(buff, size, end_of_data, cuts);
+    }
+    else if(simd_mode == SIMD_Mode::AVX512_NOSLIDE) {
+        return find_cutpoints_for<No_Slide_Vector<AVX512_Vector>>(buff, size, end_of_data, cuts);
+    }
     #endif
 
-    #if defined(__ARM_NEON__)
-    if(neon_array != nullptr)
-        delete neon_array;
-    #endif  
+    #if defined(SIMD_NEON_KERNELS)
+    else if(simd_mode == SIMD_Mode::NEON) {
+        return find_cutpoints_for<NEON_Vector>(buff, size, end_of_data, cuts);
+    }
+    #endif
 
-    #ifdef __ALTIVEC__
-    if(altivec_array != nullptr)
-        delete altivec_array; 
+    #ifdef SIMD_ALTIVEC_KERNELS
+    else if(simd_mode == SIMD_Mode::ALTIVEC) {
+        return find_cutpoints_for<ALTIVEC_Vector>(buff, size, end_of_data, cuts);
+    }
     #endif
- }
\ No newline at end of file
+
+    else {
+        std::cout << "Unsupported SIMD Mode for MAXP" << std::endl;
+        exit(1);
+    }
+ }
+
+ template <class Vector>
+ uint64_t MAXP_Chunking::find_cutpoints_for(char *buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts){
+    return cut_whole_chunks(buff, size, end_of_data, cuts, [this](char *chunk, uint64_t chunk_size) {
+        if constexpr (std::is_void_v<Vector>)
+            return find_cutpoint_native(chunk, chunk_size);
+        else
+            return find_cutpoint_simd<Vector>(chunk, chunk_size);
+    });
+ }
+
+ bool MAXP_Chunking::supports_simd_mode(SIMD_Mode mode) const {
+    return mode == SIMD_Mode::NONE || simd_mode_supported(mode);
+ }
+
+ uint64_t MAXP_Chunking::get_max_block_size() const {
+    return max_block_size;
+ }
+
+ template <class Vector>
+ uint64_t MAXP_Chunking_Specialized<Vector>::find_cutpoint(char *buff, uint64_t size){
+    chunk_counter++;
+    if constexpr (std::is_void_v<Vector>)
+        return find_cutpoint_native(buff, size);
+    else
+        return find_cutpoint_simd<Vector>(buff, size);
+ }
+
+ template <class Vector>
+ uint64_t MAXP_Chunking_Specialized<Vector>::find_cutpoints(char *buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts){
+    return find_cutpoints_for<Vector>(buff, size, end_of_data, cuts);
+ }
+
+ #define MAXP_CHUNKING_SPECIALIZATION(VECTOR) template class MAXP_Chunking_Specialized<VECTOR>;
+ MAXP_CHUNKING_SPECIALIZATION(void)
+ FOR_EACH_SIMD_VECTOR(MAXP_CHUNKING_SPECIALIZATION)
@@ -0,0 +1,101 @@
+/**
+ * @file multi_stream_chunking.cpp
+ * @author WASL
+ * @brief Implementation of the chunking of several files at once
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "multi_stream_chunking.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+std::vector<std::vector<std::string>> Multi_Stream_Chunking_Technique::chunk_files(
+    const std::vector<std::string>& file_paths) {
+    const uint64_t lanes = stream_lanes();
+    if (file_paths.size() <= 1 || lanes == 0) {
+        return Chunking_Technique::chunk_files(file_paths);
+    }
+    const uint64_t size_limit = chunk_size_limit();
+
+    // Files are read whole, so the lanes never wait for data
+    const uint64_t num_files = file_paths.size();
+    std::vector<std::vector<char>> files(num_files);
+    std::vector<uint64_t> file_sizes(num_files);
+    for (uint64_t f = 0; f < num_files; f++) {
+        std::ifstream file_ptr(file_paths[f], std::ios::in | std::ios::binary);
+        file_sizes[f] = get_file_size(&file_ptr);
+        files[f].resize(file_sizes[f] + STREAM_DATA_PADDING);
+        file_ptr.read(files[f].data(), file_sizes[f]);
+    }
+
+    // Offsets of the ends of the chunks of every file
+    std::vector<std::vector<uint64_t>> cuts(num_files);
+    // File chunked by each lane, num_files until the lane takes its first file
+    uint64_t lane_file[STREAM_LANES_MAX];
+    uint64_t lane_offset[STREAM_LANES_MAX];
+    uint64_t next_file = 0;
+    uint64_t active = 0;
+
+    // Moves a lane to its next chunk needing the kernel, taking the next file when its file is done
+    auto start_lane = [&](uint64_t lane) {
+        while (true) {
+            if (lane_file[lane] == num_files || lane_offset[lane] >= file_sizes[lane_file[lane]]) {
+                if (next_file == num_files) {
+                    return;
+                }
+                lane_file[lane] = next_file++;
+                lane_offset[lane] = 0;
+                continue;
+            }
+            const char* data = files[lane_file[lane]].data();
+            uint64_t start = lane_offset[lane];
+            uint64_t size = std::min(size_limit, file_sizes[lane_file[lane]] - start);
+            uint64_t cut;
+            stream_state.data[lane] = (uint64_t)data;
+            if (begin_lane(lane, data, start, size, cut)) {
+                active |= 1ULL << lane;
+                return;
+            }
+            cuts[lane_file[lane]].push_back(cut);
+            lane_offset[lane] = cut;
+        }
+    };
+
+    auto begin_chunking = std::chrono::high_resolution_clock::now();
+    for (uint64_t lane = 0; lane < lanes; lane++) {
+        lane_file[lane] = num_files;
+        lane_offset[lane] = 0;
+        start_lane(lane);
+    }
+    while (active) {
+        uint64_t found = advance_lanes(active);
+        while (found) {
+            uint64_t lane = __builtin_ctzll(found);
+            found &= found - 1;
+            active &= ~(1ULL << lane);
+            cuts[lane_file[lane]].push_back(stream_state.cut[lane]);
+            lane_offset[lane] = stream_state.cut[lane];
+            start_lane(lane);
+        }
+    }
+    auto end_chunking = std::chrono::high_resolution_clock::now();
+    total_time_chunking += (end_chunking - begin_chunking);
+
+    std::vector<std::vector<std::string>> hashes(num_files);
+    for (uint64_t f = 0; f < num_files; f++) {
+        emitted_bytes = 0;
+        index_limit = UINT64_MAX;
+        uint64_t chunk_start = 0;
+        for (uint64_t cut : cuts[f]) {
+            emit_chunk(hashes[f], files[f].data() + chunk_start, cut - chunk_start);
+            chunk_start = cut;
+        }
+        std::vector<char>().swap(files[f]);
+    }
+    return hashes;
+}
@@ -9,76 +9,9 @@
  *
  */
 #include "rabins_chunking.hpp"
-#include <iostream>
-
-int Rabins_Chunking::deg(uint64_t p) {
-    uint64_t mask = 0x8000000000000000LL;
-
-    for (int i = 0; i < 64; i++) {
-        if ((mask & p) > 0) {
-            return 63 - i;
-        }
-
-        mask >>= 1;
-    }
-    return -1;
-}
-
-// Mod calculates the remainder of x divided by p.
-uint64_t Rabins_Chunking::mod(uint64_t x, uint64_t p) {
-    while (deg(x) >= deg(p)) {
-        unsigned int sshift = deg(x) - deg(p);
-
-        x = x ^ (p << sshift);
-    }
-
-    return x;
-}
-
-
-uint64_t Rabins_Chunking::append_byte(uint64_t hash, uint8_t b, uint64_t pol) {
-    hash <<= 8;
-    hash |= (uint64_t)b;
-
-    return mod(hash, pol);
-}
-
-void Rabins_Chunking::calc_tables(void) {
-    // calculate table for sliding out bytes. The byte to slide out is used as
-    // the index for the table, the value contains the following:
-    // out_table[b] = Hash(b || 0 ||        ...        || 0)
-    //                          \ windowsize-1 zero bytes /
-    // To slide out byte b_0 for window size w with known hash
-    // H := H(b_0 || ... || b_w), it is sufficient to add out_table[b_0]:
-    //    H(b_0 || ... || b_w) + H(b_0 || 0 || ... || 0)
-    //  = H(b_0 + b_0 || b_1 + 0 || ... || b_w + 0)
-    //  = H(    0     || b_1 || ...     || b_w)
-    //
-    // Afterwards a new byte can be shifted in.
-    for (int b = 0; b < 256; b++) {
-        uint64_t hash = 0;
-
-        hash = append_byte(hash, (uint8_t)b, POLYNOMIAL);
-        for (uint64_t i = 0; i < window_size - 1; i++) {
-            hash = append_byte(hash, 0, POLYNOMIAL);
-        }
-        out_table[b] = hash;
-    }
 
-    // calculate table for reduction mod Polynomial
-    int k = deg(POLYNOMIAL);
-    for (int b = 0; b < 256; b++) {
-        // mod_table[b] = A | B, where A = (b(x) * x^k mod pol) and  B = b(x) *
-        // x^k
-        //
-        // The 8 bits above deg(Polynomial) determine what happens next and so
-        // these bits are used as a lookup to this table. The value is split in
-        // two parts: Part A contains the result of the modulus operation, part
-        // B is used to cancel out the 8 top bits so that one XOR operation is
-        // enough to reduce modulo Polynomial
-        mod_table[b] = mod(((uint64_t)b) << k, POLYNOMIAL) | ((uint64_t)b) << k;
-    }
-}
+#include <algorithm>
+#include <iostream>
 
 void Rabins_Chunking::rabin_append(uint8_t b) {
     uint8_t index = (uint8_t)(digest >> POL_SHIFT);
@@ -88,15 +21,16 @@ void Rabins_Chunking::rabin_append(uint8_t b) {
 }
 
 void Rabins_Chunking::rabin_slide(uint8_t b) {
-    uint8_t out = window[wpos];
-    window[wpos] = b;
+    // wpos counts the bytes slid in, the byte sliding out was written window_size slides ago
+    uint8_t out = window[(wpos - window_size) & window_mask];
+    window[wpos & window_mask] = b;
     digest = (digest ^ out_table[out]);
-    wpos = (wpos + 1) % window_size;
+    wpos++;
     rabin_append(b);
 }
 
 void Rabins_Chunking::rabin_reset() {
-    for (uint64_t i = 0; i < window_size; i++) window[i] = 0;
+    memset(window, 0, window_mask + 1);
     wpos = 0;
     count = 0;
     digest = 0;
@@ -104,9 +38,107 @@ void Rabins_Chunking::rabin_reset() {
     rabin_slide(1);
 }
 
+uint64_t Rabins_Chunking::fingerprint_window(const char *buf) {
+    const uint8_t *bytes = (const uint8_t *)buf;
+    uint64_t fingerprint = 0;
+    uint64_t i = 0;
+    for (; i + 4 <= window_size; i += 4) {
+        uint64_t word = ((uint64_t)bytes[i] << 24) | ((uint64_t)bytes[i + 1] << 16) |
+                        ((uint64_t)bytes[i + 2] << 8) | (uint64_t)bytes[i + 3];
+        fingerprint = ((fingerprint & ((1ULL << (POLYNOMIAL_DEGREE - 32)) - 1)) << 32 | word) ^
+                      append_tables[3][(uint8_t)(fingerprint >> (POLYNOMIAL_DEGREE - 8))] ^
+                      append_tables[2][(uint8_t)(fingerprint >> (POLYNOMIAL_DEGREE - 16))] ^
+                      append_tables[1][(uint8_t)(fingerprint >> (POLYNOMIAL_DEGREE - 24))] ^
+                      append_tables[0][(uint8_t)(fingerprint >> (POLYNOMIAL_DEGREE - 32))];
+    }
+    for (; i < window_size; i++) {
+        uint8_t index = (uint8_t)(fingerprint >> POL_SHIFT);
+        fingerprint = ((fingerprint << 8) | bytes[i]) ^ mod_table[index];
+    }
+    return fingerprint;
+}
+
+uint64_t Rabins_Chunking::find_window_cutpoint(const char *buf, uint64_t first, uint64_t limit) {
+    if (first >= limit) {
+        return limit;
+    }
+    // The fingerprint is the residue of the window contents, so building it from
+    // zero yields the same value as sliding it from the start of the chunk
+    uint64_t fingerprint = fingerprint_window(buf + first + 1 - window_size);
+    if ((fingerprint & fingerprint_mask) == 0) {
+        return first;
+    }
+    uint64_t i = first + 1;
+    while (i < limit) {
+        // Once the window of a position lies in a run, the fingerprint is the
+        // same at every position until the run ends and it is not a cut point
+        Byte_Run run = find_run(buf, i, limit);
+        uint64_t serial_end = std::min(limit, run.start + window_size);
+        for (; i < serial_end; i++) {
+            fingerprint ^= out_table[(uint8_t)buf[i - window_size]];
+            uint8_t index = (uint8_t)(fingerprint >> POL_SHIFT);
+            fingerprint = ((fingerprint << 8) | (uint8_t)buf[i]) ^ mod_table[index];
+            if ((fingerprint & fingerprint_mask) == 0) {
+                return i;
+            }
+        }
+        i = std::max(i, skip_run(buf, run, limit));
+    }
+    return limit;
+}
+
 uint64_t Rabins_Chunking::find_cutpoint(char *buf, uint64_t len) {
-    for (unsigned int i = 0; i < len; i++) {
-        char b = *buf++;
+    // Below window_size bytes the fingerprint still contains the reset state
+    if (min_block_size < window_size) {
+        return find_cutpoint_sliding(buf, len, true);
+    }
+    // No position before the minimum chunk size can be a cut point, so only
+    // the window preceding it is fingerprinted. A candidate at position i
+    // closes a chunk of i + 1 bytes
+    uint64_t limit = std::min(len, max_block_size);
+    if (min_block_size > limit) {
+        return limit;
+    }
+    uint64_t idx = min_block_size - 1;
+    uint64_t cut = (simd_mode == SIMD_Mode::NONE) ? find_cutpoint_native(buf, idx, limit)
+                                                   : find_cutpoint_simd(buf, idx, limit, true);
+    return (cut < limit) ? cut + 1 : limit;
+}
+
+uint64_t Rabins_Chunking::resume_cutpoint(char *buf, uint64_t len, bool end_of_data) {
+    if (min_block_size < window_size) {
+        return find_cutpoint_sliding(buf, len, end_of_data);
+    }
+    uint64_t limit = std::min(len, max_block_size);
+    if (min_block_size > limit) {
+        return end_of_data ? limit : 0;
+    }
+    bool finish = end_of_data || limit == max_block_size;
+    uint64_t idx = (scan_pos == 0) ? min_block_size - 1 : scan_pos;
+    uint64_t cut = (simd_mode == SIMD_Mode::NONE) ? find_cutpoint_native(buf, idx, limit)
+                                                   : find_cutpoint_simd(buf, idx, limit, finish);
+    if (cut < limit || finish) {
+        scan_pos = 0;
+        return (cut < limit) ? cut + 1 : limit;
+    }
+    scan_pos = idx;
+    return 0;
+}
+
+void Rabins_Chunking::reset_scan() {
+    rabin_reset();
+    scan_pos = 0;
+}
+
+uint64_t Rabins_Chunking::find_cutpoints(char *buf, uint64_t len, bool end_of_data, std::vector<uint64_t> &cuts) {
+    return cut_chunks(buf, len, end_of_data, cuts, [this](char *chunk, uint64_t chunk_len, bool complete) {
+        return Rabins_Chunking::resume_cutpoint(chunk, chunk_len, complete);
+    });
+}
+
+uint64_t Rabins_Chunking::find_cutpoint_sliding(char *buf, uint64_t len, bool end_of_data) {
+    for (uint64_t i = count; i < len; i++) {
+        char b = buf[i];
 
         rabin_slide(b);
 
@@ -121,15 +153,197 @@ uint64_t Rabins_Chunking::find_cutpoint(char *buf, uint64_t len) {
             return size;
         }
     }
+    if (!end_of_data) {
+        return 0;
+    }
     rabin_reset();
     return len;
 }
 
-void Rabins_Chunking::rabin_init() {
-    if (!tables_initialized) {
-        calc_tables();
-        tables_initialized = true;
+uint64_t Rabins_Chunking::find_cutpoint_native(const char *buf, uint64_t &idx, uint64_t limit) {
+    uint64_t cut = find_window_cutpoint(buf, idx, limit);
+    idx = limit;
+    return cut;
+}
+
+uint64_t Rabins_Chunking::find_cutpoint_simd(const char *buf, uint64_t &idx, uint64_t limit, bool finish) {
+    // The kernel slides a byte out before each position, so its first position
+    // needs window_size bytes before it
+    if (idx >= window_size) {
+        const uint64_t lanes = rabin_lanes();
+        const uint64_t block_size = lanes * RABIN_SIMD_LANE_SPAN;
+        uint64_t block_words[AVX512_REGISTER_SIZE_INT64 * RABIN_SIMD_LANE_SPAN / BITMAP_WORD_BITS];
+        uint64_t *words = block_words;
+        while (idx + block_size <= limit) {
+            // Runs are skipped by find_window_cutpoint, which finishes the chunk
+            Byte_Run run = find_run(buf, idx, limit);
+            if (run.start < run.end && run.start < idx + block_size) {
+                break;
+            }
+            mark_rabin_candidates(buf, idx, RABIN_SIMD_LANE_SPAN, mod_table, out_table, window_size,
+                                  POL_SHIFT, &fingerprint_mask, 1, &words);
+            for (uint64_t w = 0; w < block_size / BITMAP_WORD_BITS; w++) {
+                if (block_words[w]) {
+                    return idx + w * BITMAP_WORD_BITS + __builtin_ctzll(block_words[w]);
+                }
+            }
+            idx += block_size;
+        }
+        if (!finish) {
+            return limit;
+        }
+    }
+    return find_cutpoint_native(buf, idx, limit);
+}
+
+void Rabins_Chunking::mark_window_candidates(const char *buff, uint64_t start,
+                                             uint64_t end, const uint64_t *masks,
+                                             uint64_t levels, uint64_t **bitmaps) {
+    uint64_t fingerprint = 0;
+    uint64_t words[BITMAP_MAX_LEVELS] = {0};
+
+    if (simd_mode != SIMD_Mode::NONE) {
+        // The kernel needs a full window before its first position and lanes
+        // spanning whole bitmap words, the rest is marked by the code below
+        const uint64_t lanes = rabin_lanes();
+        uint64_t vector_start = std::max(start, (window_size + BITMAP_WORD_BITS - 1) /
+                                                    BITMAP_WORD_BITS * BITMAP_WORD_BITS);
+        uint64_t lane_span = (end > vector_start) ?
+            (end - vector_start) / (lanes * BITMAP_WORD_BITS) * BITMAP_WORD_BITS : 0;
+        if (lane_span > 0) {
+            uint64_t vector_end = vector_start + lanes * lane_span;
+            if (start < vector_start) {
+                mark_window_candidates(buff, start, vector_start, masks, levels, bitmaps);
+            }
+            uint64_t *level_words[BITMAP_MAX_LEVELS];
+            for (uint64_t level = 0; level < levels; level++) {
+                level_words[level] = bitmaps[level] + vector_start / BITMAP_WORD_BITS;
+            }
+            mark_rabin_candidates(buff, vector_start, lane_span, mod_table, out_table, window_size,
+                                  POL_SHIFT, masks, levels, level_words);
+            if (vector_end < end) {
+                mark_window_candidates(buff, vector_end, end, masks, levels, bitmaps);
+            }
+            return;
+        }
+    }
+
+    // Fingerprint of the window_size - 1 bytes preceding the segment. The
+    // fingerprint is the residue of the window contents, so building it from
+    // zero yields the same value as sliding it from the start of the chunk.
+    uint64_t window_start = (start >= window_size - 1) ? start - (window_size - 1) : 0;
+    for (uint64_t i = window_start; i < start; i++) {
+        uint8_t index = (uint8_t)(fingerprint >> POL_SHIFT);
+        fingerprint = ((fingerprint << 8) | (uint8_t)buff[i]) ^ mod_table[index];
+    }
+
+    for (uint64_t i = start; i < end; i++) {
+        if (i >= window_start + window_size) {
+            fingerprint ^= out_table[(uint8_t)buff[i - window_size]];
+        }
+        uint8_t index = (uint8_t)(fingerprint >> POL_SHIFT);
+        fingerprint = ((fingerprint << 8) | (uint8_t)buff[i]) ^ mod_table[index];
+
+        for (uint64_t level = 0; level < levels; level++) {
+            words[level] |= (uint64_t)((fingerprint & masks[level]) == 0) << (i % BITMAP_WORD_BITS);
+        }
+        if (i % BITMAP_WORD_BITS == BITMAP_WORD_BITS - 1) {
+            for (uint64_t level = 0; level < levels; level++) {
+                bitmaps[level][i / BITMAP_WORD_BITS] = words[level];
+                words[level] = 0;
+            }
+        }
     }
+    if (end % BITMAP_WORD_BITS) {
+        for (uint64_t level = 0; level < levels; level++) {
+            bitmaps[level][end / BITMAP_WORD_BITS] = words[level];
+        }
+    }
+}
+
+void Rabins_Chunking::mark_candidates(const char *buff, uint64_t start,
+                                      uint64_t end, uint64_t **bitmaps) {
+    mark_window_candidates(buff, start, end, &fingerprint_mask, 1, bitmaps);
+}
+
+uint64_t Rabins_Chunking::find_cutpoint_bitmap(char *buff, uint64_t start,
+                                               uint64_t len) {
+    // Below window_size bytes the fingerprint still contains the reset state
+    if (min_block_size < window_size) {
+        return find_cutpoint(buff + start, len);
+    }
+
+    uint64_t limit = std::min(len, max_block_size);
+    if (min_block_size > limit) {
+        return limit;
+    }
+    // A candidate at position i closes a chunk of i + 1 bytes
+    uint64_t cut = next_candidate(0, start + min_block_size - 1, start + limit);
+    if (cut < start + limit) {
+        return cut - start + 1;
+    }
+    return limit;
+}
+
+bool Rabins_Chunking::begin_lane(uint64_t lane, const char *data, uint64_t chunk_start,
+                                 uint64_t len, uint64_t &cut) {
+    // The kernel slides bytes out of a full window, slide the first one in
+    // serially with the checks of find_cutpoint
+    const char *buf = data + chunk_start;
+    uint64_t warmup = std::min(len, window_size);
+    for (uint64_t i = 0; i < warmup; i++) {
+        rabin_slide(buf[i]);
+        count++;
+        if ((count >= min_block_size && ((digest & fingerprint_mask) == 0)) ||
+            count >= max_block_size) {
+            cut = chunk_start + count;
+            rabin_reset();
+            return false;
+        }
+    }
+    if (warmup == len) {
+        cut = chunk_start + len;
+        rabin_reset();
+        return false;
+    }
+
+    stream_state.pos[lane] = chunk_start + window_size;
+    stream_state.end[lane] = chunk_start + std::min(len, max_block_size);
+    // The byte at position i closes a chunk of i + 1 bytes
+    stream_state.phase[lane] = chunk_start + std::max(min_block_size, (uint64_t)1) - 1;
+    stream_state.hash[lane] = digest;
+    rabin_reset();
+    return true;
+}
+
+uint64_t Rabins_Chunking::advance_lanes(uint64_t active) {
+    return advance_rabin_lanes(stream_state, active, mod_table, out_table, fingerprint_mask,
+                               window_size, POL_SHIFT);
+}
+
+void Rabins_Chunking::rabin_init() {
+    // calculate table for sliding out bytes. The byte to slide out is used as
+    // the index for the table, the value contains the following:
+    // out_table[b] = Hash(b || 0 ||        ...        || 0)
+    //                          \ windowsize-1 zero bytes /
+    // To slide out byte b_0 for window size w with known hash
+    // H := H(b_0 || ... || b_w), it is sufficient to add out_table[b_0]:
+    //    H(b_0 || ... || b_w) + H(b_0 || 0 || ... || 0)
+    //  = H(b_0 + b_0 || b_1 + 0 || ... || b_w + 0)
+    //  = H(    0     || b_1 || ...     || b_w)
+    //
+    // Afterwards a new byte can be shifted in.
+    uint64_t size = window_size;
+    out_table = shared_table<Rabin_Window_Table>(size, [size](Rabin_Window_Table &table) {
+        for (int b = 0; b < 256; b++) {
+            // Appending the zero bytes with mod_table gives the same residue as rabin_append_byte
+            uint64_t hash = rabin_append_byte(0, (uint8_t)b, POLYNOMIAL);
+            for (uint64_t i = 0; i < size - 1; i++) {
+                hash = (hash << 8) ^ mod_table[(uint8_t)(hash >> POL_SHIFT)];
+            }
+            table.out_table[b] = hash;
+        }
+    })->out_table;
     rabin_reset();
 }
 
@@ -138,10 +352,33 @@ Rabins_Chunking::Rabins_Chunking(const Config &config) {
     min_block_size = config.get_rabinc_min_block_size();
     avg_block_size = config.get_rabinc_avg_block_size();
     max_block_size = config.get_rabinc_max_block_size();
-    window = new uint8_t[config.get_rabinc_window_size()];
     window_size = config.get_rabinc_window_size();
+    window_mask = 1;
+    while (window_mask < window_size) {
+        window_mask <<= 1;
+    }
+    window = new uint8_t[window_mask];
+    window_mask -= 1;
     fingerprint_mask = (1 << (fls32(avg_block_size) - 1)) - 1;
     rabin_init();
+
+    simd_mode = config.get_simd_mode();
+    if (simd_mode != SIMD_Mode::NONE && rabin_lanes() == 0) {
+        std::cout << "SIMD mode unsupported for Rabin chunking. Please use avx256 or avx512." << std::endl;
+        exit(1);
+    }
+
+    init_candidate_bitmap(config, 1);
+    run_skip = config.get_run_skip();
+}
+
+bool Rabins_Chunking::supports_simd_mode(SIMD_Mode mode) const {
+    return mode == SIMD_Mode::NONE ||
+           ((mode == SIMD_Mode::AVX256 || mode == SIMD_Mode::AVX512) && simd_mode_supported(mode));
+}
+
+uint64_t Rabins_Chunking::get_max_block_size() const {
+    return max_block_size;
 }
 
 Rabins_Chunking::~Rabins_Chunking() { delete[] window; }
@@ -11,33 +11,14 @@
 
 #include "ram_chunking.hpp"
 #include <fstream>
+#include <type_traits>
 
 RAM_Chunking::RAM_Chunking() {
     avg_block_size = DEFAULT_RAM_AVG_BLOCK_SIZE;
     technique_name = "RAM Chunking";
 
     window_size = avg_block_size - 256;
-    
-    #ifdef __SSE3__
-    sse_array = nullptr;
-    #endif
-    
-    #ifdef __AVX2__
-    avx256_array = nullptr;
-    #endif
-    
-    #if defined(__AVX512F__)
-        avx512_array = nullptr;
-    #endif
-    
-    #ifdef __ARM_NEON
-        neon_array = nullptr;
-    #endif
 
-    #ifdef __ALTIVEC__
-        altivec_array = nullptr;
-    #endif
-   
     simd_mode = SIMD_Mode::NONE;
 
 }
@@ -48,164 +29,187 @@ RAM_Chunking::RAM_Chunking(const Config& config) {
     window_size = avg_block_size - 256;
     // window_size = avg_block_size / (exp(1) - 1);  // avg_block size / e-1
 
-    #ifdef __SSE3__
-        sse_array = nullptr;
-    #endif
-    
-    #ifdef __AVX2__
-        avx256_array = nullptr;
-    #endif
-    
-    #if defined(__AVX512F__)
-        avx512_array = nullptr;
-    #endif
-
-    #ifdef __ARM_NEON
-        neon_array = nullptr;
-    #endif
-
-    #ifdef __ALTIVEC__
-        altivec_array = nullptr;
-    #endif
-    
     technique_name = "RAM Chunking";
 
     simd_mode = config.get_simd_mode();
+    run_skip = config.get_run_skip();
+
+    switch(simd_mode){
+        case SIMD_Mode::NONE:
+        #ifdef SIMD_SSE128_KERNELS
+        case SIMD_Mode::SSE128:
+        case SIMD_Mode::SSE128_NOSLIDE:
+        #endif
+        #ifdef SIMD_AVX256_KERNELS
+        case SIMD_Mode::AVX256:
+        case SIMD_Mode::AVX256_NOSLIDE:
+        #endif
+        #if defined(SIMD_AVX512_KERNELS)
+        case SIMD_Mode::AVX512:
+        case SIMD_Mode::AVX512_NOSLIDE:
+        #endif
+        #ifdef SIMD_NEON_KERNELS
+        case SIMD_Mode::NEON:
+        #endif
+        #ifdef SIMD_ALTIVEC_KERNELS
+        case SIMD_Mode::ALTIVEC:
+        #endif
+            break;
+        default:
+            std::cout << "Error: Unsupported SIMD mode" << std::endl;
+            exit(EXIT_FAILURE);
+    }
+}
 
-    if(simd_mode == SIMD_Mode::NONE){
+template <class Vector>
+uint64_t RAM_Chunking::find_cutpoint_simd(char* buff, uint64_t size) {
+    if (size > max_block_size)
+        size = max_block_size;
+    else if(size < window_size)
+        return size;
 
+    // The maximum of the window comes from the block summaries, the scan after it from the range scan kernel.
+    // The no-slide modes reduce the window directly, without summarizing its blocks
+    uint8_t max_value;
+    if constexpr (is_no_slide_vector<Vector>)
+        max_value = Vector::template find_extremum<true>(buff, 0, window_size);
+    else {
+        reset_block_extrema(buff, size);
+        max_value = range_maximum(0, window_size);
+    }
+    return Vector::template range_scan<Scan_Op::GEQ>(buff, window_size, size, max_value);
+}
+
+bool RAM_Chunking::supports_simd_mode(SIMD_Mode mode) const {
+    return mode == SIMD_Mode::NONE || simd_mode_supported(mode);
+}
+
+uint64_t RAM_Chunking::get_max_block_size() const {
+    return max_block_size;
+}
+
+uint64_t RAM_Chunking::find_cutpoint_native(char* buff, uint64_t size) {
+    uint32_t i = 0;
+    uint8_t max_value = (uint8_t)buff[i];
+    i++;
+    if (size > max_block_size)
+        size = max_block_size;
+    else if(size < window_size)
+        return size;
+
+    // If no SIMD enabled, execute basic find_maximum
+    for(i = 0; i < window_size; i++){
+        if ((uint8_t)buff[i] >= max_value)
+            max_value = (uint8_t)buff[i];
+    }
+
+    i = window_size;
+    while (i < size) {
+        // A run below the maximum is passed over after its first byte
+        Byte_Run run = find_run(buff, i, size);
+        uint64_t segment_end = std::min(size, run.start + 1);
+        for (; i < segment_end; i++) {
+            if ((uint8_t)buff[i] >= max_value)
+                return i;
+        }
+        i = std::max<uint64_t>(i, skip_run(buff, run, size));
+    }
+    return size;
+}
+
+uint64_t RAM_Chunking::find_cutpoint(char* buff, uint64_t size) {
+    if(simd_mode == SIMD_Mode::NONE){
+        return find_cutpoint_native(buff, size);
     }
 
-    #ifdef __SSE3__
+    #ifdef SIMD_SSE128_KERNELS
     else if(simd_mode == SIMD_Mode::SSE128){
-         uint64_t num_vectors = window_size / SSE_REGISTER_SIZE_BYTES;
-         sse_array = new __m128i[num_vectors]();
+        return find_cutpoint_simd<SSE128_Vector>(buff, size);
+    }
+    else if(simd_mode == SIMD_Mode::SSE128_NOSLIDE){
+        return find_cutpoint_simd<No_Slide_Vector<SSE128_Vector>>(buff, size);
     }
     #endif
-    
-    #ifdef __AVX2__
+
+    #ifdef SIMD_AVX256_KERNELS
     else if(simd_mode == SIMD_Mode::AVX256){
-        uint64_t num_vectors = window_size / AVX256_REGISTER_SIZE_BYTES;
-        avx256_array = new __m256i[num_vectors]();
+        return find_cutpoint_simd<AVX256_Vector>(buff, size);
+    }
+    else if(simd_mode == SIMD_Mode::AVX256_NOSLIDE){
+        return find_cutpoint_simd<No_Slide_Vector<AVX256_Vector>>(buff, size);
     }
     #endif
-    
-    #if defined(__AVX512F__)
+
+    #if defined(SIMD_AVX512_KERNELS)
     else if(simd_mode == SIMD_Mode::AVX512){
-        uint64_t num_vectors = window_size / AVX512_REGISTER_SIZE_BYTES;
-        avx512_array = new __m512i[num_vectors]();
+        return find_cutpoint_simd<AVX512_Vector>(buff, size);
+    }
+    else if(simd_mode == SIMD_Mode::AVX512_NOSLIDE){
+        return find_cutpoint_simd<No_Slide_Vector<AVX512_Vector>>(buff, size);
     }
     #endif
-    
-    #ifdef __ARM_NEON
+
+    #if defined(SIMD_NEON_KERNELS)
     else if(simd_mode == SIMD_Mode::NEON){
-        uint64_t num_vectors = window_size / NEON_REGISTER_SIZE_BYTES;
-        neon_array = new uint8x16_t[num_vectors]();
+        return find_cutpoint_simd<NEON_Vector>(buff, size);
     }
     #endif
 
-    #ifdef __ALTIVEC__
+    #ifdef SIMD_ALTIVEC_KERNELS
     else if(simd_mode == SIMD_Mode::ALTIVEC){
-        uint64_t num_vectors = window_size / ALTIVEC_REGISTER_SIZE_BYTES;
-        altivec_array = new __vector unsigned char[num_vectors]();
+        return find_cutpoint_simd<ALTIVEC_Vector>(buff, size);
     }
     #endif
-
+    
     else {
         std::cout << "Error: Unsupported SIMD mode" << std::endl;
         exit(EXIT_FAILURE);
     }
-}
-
-RAM_Chunking::~RAM_Chunking() {
-
-    if(simd_mode == SIMD_Mode::NONE){
-        // No SIMD mode, nothing to delete
-        return;
-    }
-
-    #ifdef __SSE3__
-    else if(simd_mode == SIMD_Mode::SSE128)
-        delete sse_array;
-    #endif
-
-    #ifdef __AVX2__
-    else if(simd_mode == SIMD_Mode::AVX256)
-        delete avx256_array;
-    #endif
 
-   #if defined(__AVX512F__)
-    else if(simd_mode == SIMD_Mode::AVX512)
-        delete avx512_array;
-    #endif
-
-    #ifdef __ARM_NEON
-    else if(simd_mode == SIMD_Mode::NEON)
-        delete neon_array;
-    #endif
-
-    #ifdef __ALTIVEC__
-    else if(simd_mode == SIMD_Mode::ALTIVEC)
-        delete altivec_array;
-    #endif
+    return size;
 }
 
-uint64_t RAM_Chunking::find_cutpoint(char* buff, uint64_t size) {
-    uint32_t i = 0;
-    uint8_t max_value = (uint8_t)buff[i];
-    i++;
-    if (size > max_block_size)
-        size = max_block_size;
-    else if(size < window_size)
-        return size;
-
+uint64_t RAM_Chunking::find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) {
     if(simd_mode == SIMD_Mode::NONE){
-        // If no SIMD enabled, execute basic find_maximum
-        for(i = 0; i < window_size; i++){
-            if ((uint8_t)buff[i] >= max_value)
-	    	    max_value = (uint8_t)buff[i];
-        }
-
-        for (i = window_size; i < size; i++) {
-            if ((uint8_t)buff[i] >= max_value)
-                return i;
-        }
-
+        return find_cutpoints_for<void>(buff, size, end_of_data, cuts);
     }
 
-    #ifdef __SSE3__
-    // If SIMD enabled, accelerate find_maximum() and slide depending on chosen SIMD mode 
+    #ifdef SIMD_SSE128_KERNELS
     else if(simd_mode == SIMD_Mode::SSE128){
-        max_value = find_maximum_sse128(buff, 0, window_size, sse_array);
-        return range_scan_geq_sse128(buff, window_size, size, max_value);
+        return find_cutpoints_for<SSE128_Vector>(buff, size, end_of_data, cuts);
+    }
+    else if(simd_mode == SIMD_Mode::SSE128_NOSLIDE){
+        return find_cutpoints_for<No_Slide_Vector<SSE128_Vector>>(buff, size, end_of_data, cuts);
     }
     #endif
 
-    #ifdef __AVX2__
+    #ifdef SIMD_AVX256_KERNELS
     else if(simd_mode == SIMD_Mode::AVX256){
-        max_value = find_maximum_avx256(buff, 0, window_size, avx256_array);
-        return range_scan_geq_avx256(buff, window_size, size, max_value);
+        return find_cutpoints_for<AVX256_Vector>(buff, size, end_of_data, cuts);
+    }
+    else if(simd_mode == SIMD_Mode::AVX256_NOSLIDE){
+        return find_cutpoints_for<No_Slide_Vector<AVX256_Vector>>(buff, size, end_of_data, cuts);
     }
     #endif
 
-    #if defined(__AVX512F__)
+    #if defined(SIMD_AVX512_KERNELS)
     else if(simd_mode == SIMD_Mode::AVX512){
-        max_value = find_maximum_avx512(buff, 0, window_size, avx512_array);
-        return range_scan_geq_avx512(buff, window_size, size, max_value);
+        return find_cutpoints_for<AVX512_Vector>(buff, size, end_of_data, cuts);
+    }
+    else if(simd_mode == SIMD_Mode::AVX512_NOSLIDE){
+        return find_cutpoints_for<No_Slide_Vector<AVX512_Vector>>(buff, size, end_of_data, cuts);
     }
     #endif
 
-    #if defined(__ARM_NEON)
+    #if defined(SIMD_NEON_KERNELS)
     else if(simd_mode == SIMD_Mode::NEON){
-        max_value = find_maximum_neon(buff, 0, window_size, neon_array);
-        return range_scan_geq_neon(buff, window_size, size, max_value);
+        return find_cutpoints_for<NEON_Vector>(buff, size, end_of_data, cuts);
     }
     #endif
 
-    #ifdef __ALTIVEC__
+    #ifdef SIMD_ALTIVEC_KERNELS
     else if(simd_mode == SIMD_Mode::ALTIVEC){
-        max_value = find_maximum_altivec(buff, 0, window_size, altivec_array);
-        return range_scan_geq_altivec(buff, window_size, size, max_value);
+        return find_cutpoints_for<ALTIVEC_Vector>(buff, size, end_of_data, cuts);
     }
     #endif
     
@@ -213,7 +217,32 @@ uint64_t RAM_Chunking::find_cutpoint(char* buff, uint64_t size) {
         std::cout << "Error: Unsupported SIMD mode" << std::endl;
         exit(EXIT_FAILURE);
     }
+}
 
-    return size;
+template <class Vector>
+uint64_t RAM_Chunking::find_cutpoints_for(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) {
+    return cut_whole_chunks(buff, size, end_of_data, cuts, [this](char* chunk, uint64_t chunk_size) {
+        if constexpr (std::is_void_v<Vector>)
+            return find_cutpoint_native(chunk, chunk_size);
+        else
+            return find_cutpoint_simd<Vector>(chunk, chunk_size);
+    });
+}
+
+template <class Vector>
+uint64_t RAM_Chunking_Specialized<Vector>::find_cutpoint(char* buff, uint64_t size) {
+    if constexpr (std::is_void_v<Vector>)
+        return find_cutpoint_native(buff, size);
+    else
+        return find_cutpoint_simd<Vector>(buff, size);
 }
 
+template <class Vector>
+uint64_t RAM_Chunking_Specialized<Vector>::find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) {
+    return find_cutpoints_for<Vector>(buff, size, end_of_data, cuts);
+}
+
+#define RAM_CHUNKING_SPECIALIZATION(VECTOR) template class RAM_Chunking_Specialized<VECTOR>;
+RAM_CHUNKING_SPECIALIZATION(void)
+FOR_EACH_SIMD_VECTOR(RAM_CHUNKING_SPECIALIZATION)
+
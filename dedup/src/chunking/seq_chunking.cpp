@@ -22,6 +22,7 @@ Seq_Chunking::Seq_Chunking() {
     min_block_size = DEFAULT_SEQ_MIN_BLOCK_SIZE;
     avg_block_size = DEFAULT_SEQ_AVG_BLOCK_SIZE;
     max_block_size = DEFAULT_SEQ_MAX_BLOCK_SIZE;
+    simd_mode = SIMD_Mode::NONE;
     
     technique_name = "Seq Chunking";
 }
@@ -39,94 +40,123 @@ Seq_Chunking::Seq_Chunking(const Config& config) {
    
     
     technique_name = "Seq Chunking";
+
+    run_skip = config.get_run_skip();
+    simd_mode = config.get_simd_mode();
+    if(simd_mode != SIMD_Mode::NONE && (seq_lanes() == 0 || !bmi2_supported())){
+        std::cout << "SIMD mode unsupported for SeqCDC. Please use avx256 or avx512 on a CPU with BMI2." << std::endl;
+        exit(1);
+    }
 }
 
 Seq_Chunking::~Seq_Chunking() {
 
 }
 
-uint64_t Seq_Chunking::find_cutpoint_increasing(char *buff, uint64_t size){
-    uint64_t curr_pos = min_block_size;
-    uint16_t opposing_slope_count = 0; 
-    uint16_t curr_seq_length = 0;
-
-    int cmp_result = 0;
-    bool cmp_sign = false;
-
-     while(curr_pos < size){
-
-                // Compare current and previous byte
-                cmp_result = (uint8_t)buff[curr_pos] - (uint8_t)buff[curr_pos - 1];
-                curr_pos++;
-
-                // Low Entropy Absorption
-                if(cmp_result == 0)
-                    continue;
+bool Seq_Chunking::supports_simd_mode(SIMD_Mode mode) const {
+    return mode == SIMD_Mode::NONE ||
+           ((mode == SIMD_Mode::AVX256 || mode == SIMD_Mode::AVX512) && simd_mode_supported(mode) &&
+            bmi2_supported());
+}
 
-                // Get result of comparison (signbit is true if negative)
-                cmp_sign = signbit(cmp_result);
+uint64_t Seq_Chunking::get_max_block_size() const {
+    return max_block_size;
+}
 
-                // Opposing slope is only incremented when curr_byte < prev_byte i.e. cmp_result is negative i.e. cmp_sign == 1
-                opposing_slope_count += cmp_sign;
+uint64_t Seq_Chunking::find_cutpoint_increasing(char *buff, uint64_t size, Seq_Scan_State &state){
 
-                // Curr seq length is incremented only when cmp_sign == 0
-                curr_seq_length = (curr_seq_length * !cmp_sign) + !cmp_sign;
+    uint64_t curr_pos = state.pos;
+    uint16_t opposing_slope_count = state.opposing_slope_count;
+    uint16_t curr_seq_length = state.seq_length;
 
+    int cmp_result = 0;
+    bool cmp_sign = false;
 
-                // Return chunk boundary if sequence threshold reached
-                if(curr_seq_length == seq_length_threshold)
-                    return curr_pos - 1;
-                // Jump skip_size bytes if jump_trigger hit
-                else if(opposing_slope_count == jump_trigger){
-                    curr_pos += jump_size;
-                    opposing_slope_count = 0;
-                }
-     
-     }
+    while(curr_pos < size){
+        // Inside a run every comparison is equal and absorbed, so only its first byte is compared
+        Byte_Run run = find_run(buff, curr_pos, size);
+        uint64_t segment_end = std::min(size, run.start + 1);
+        while(curr_pos < segment_end){
+            // Compare current and previous byte
+            cmp_result = (uint8_t)buff[curr_pos] - (uint8_t)buff[curr_pos - 1];
+            curr_pos++;
+
+            // Low Entropy Absorption
+            if(cmp_result == 0)
+                continue;
+
+            // Get result of comparison (signbit is true if negative)
+            cmp_sign = signbit(cmp_result);
+
+            // Opposing slope is only incremented when curr_byte < prev_byte i.e. cmp_result is negative i.e. cmp_sign == 1
+            opposing_slope_count += cmp_sign;
+
+            // Curr seq length is incremented only when cmp_sign == 0
+            curr_seq_length = (curr_seq_length * !cmp_sign) + !cmp_sign;
+
+
+            // Return chunk boundary if sequence threshold reached
+            if(curr_seq_length == seq_length_threshold)
+                return curr_pos - 1;
+            // Jump skip_size bytes if jump_trigger hit
+            else if(opposing_slope_count == jump_trigger){
+                curr_pos += jump_size;
+                opposing_slope_count = 0;
+            }
+        }
+        curr_pos = std::max(curr_pos, skip_run(buff, run, size));
+    }
 
+    state = {curr_pos, opposing_slope_count, curr_seq_length};
     return size;    
 }
 
-uint64_t Seq_Chunking::find_cutpoint_decreasing(char *buff, uint64_t size){
-    uint64_t curr_pos = min_block_size;
-    uint16_t opposing_slope_count = 0; 
-    uint16_t curr_seq_length = 0;
+uint64_t Seq_Chunking::find_cutpoint_decreasing(char *buff, uint64_t size, Seq_Scan_State &state){
+
+    uint64_t curr_pos = state.pos;
+    uint16_t opposing_slope_count = state.opposing_slope_count;
+    uint16_t curr_seq_length = state.seq_length;
 
     int cmp_result = 0;
     bool cmp_sign = false;  
 
-       while(curr_pos < size){
-
-                // Compare current and previous byte
-                cmp_result = (uint8_t)buff[curr_pos] - (uint8_t)buff[curr_pos - 1];
-                curr_pos++;
-
-                // Low Entropy Absorption
-                if(cmp_result == 0)
-                    continue;
-
-                // Get result of comparison (signbit is true if negative)
-                // Note that signbit is negated here to invert all comparisons
-                cmp_sign = !(signbit(cmp_result));
-
-                // Opposing slope is only incremented when curr_byte > prev_byte
-                opposing_slope_count += cmp_sign;
-
-                // Curr seq length is incremented only when cmp_sign == 0
-                curr_seq_length = (curr_seq_length * !cmp_sign) + !cmp_sign;
-
-
-                // Return chunk boundary if sequence threshold reached
-                if(curr_seq_length == seq_length_threshold)
-                    return curr_pos - 1;
-                // Jump skip_size bytes if jump_trigger hit
-                else if(opposing_slope_count == jump_trigger){
-                    curr_pos += jump_size;
-                    opposing_slope_count = 0;
-                }
-       }
-     
+    while(curr_pos < size){
+        // Inside a run every comparison is equal and absorbed, so only its first byte is compared
+        Byte_Run run = find_run(buff, curr_pos, size);
+        uint64_t segment_end = std::min(size, run.start + 1);
+        while(curr_pos < segment_end){
+            // Compare current and previous byte
+            cmp_result = (uint8_t)buff[curr_pos] - (uint8_t)buff[curr_pos - 1];
+            curr_pos++;
+
+            // Low Entropy Absorption
+            if(cmp_result == 0)
+                continue;
+
+            // Get result of comparison (signbit is true if negative)
+            // Note that signbit is negated here to invert all comparisons
+            cmp_sign = !(signbit(cmp_result));
+
+            // Opposing slope is only incremented when curr_byte > prev_byte
+            opposing_slope_count += cmp_sign;
+
+            // Curr seq length is incremented only when cmp_sign == 0
+            curr_seq_length = (curr_seq_length * !cmp_sign) + !cmp_sign;
+
+
+            // Return chunk boundary if sequence threshold reached
+            if(curr_seq_length == seq_length_threshold)
+                return curr_pos - 1;
+            // Jump skip_size bytes if jump_trigger hit
+            else if(opposing_slope_count == jump_trigger){
+                curr_pos += jump_size;
+                opposing_slope_count = 0;
+            }
+        }
+        curr_pos = std::max(curr_pos, skip_run(buff, run, size));
+    }
 
+    state = {curr_pos, opposing_slope_count, curr_seq_length};
     return size;
 
 }
@@ -140,18 +170,65 @@ uint64_t Seq_Chunking::find_cutpoint(char* buff, uint64_t size) {
     if(size > max_block_size)
         size = max_block_size;
 
+    Seq_Scan_State state = {min_block_size, 0, 0};
+    return search_cutpoint(buff, size, state);
+}
+
+uint64_t Seq_Chunking::resume_cutpoint(char* buff, uint64_t size, bool end_of_data) {
+    if(size < min_block_size)
+        return end_of_data ? size : 0;
+
+    uint64_t end = std::min(size, max_block_size);
+    if(!scan_active){
+        scan_state = {min_block_size, 0, 0};
+        scan_active = true;
+    }
+    uint64_t cut = search_cutpoint(buff, end, scan_state);
+    if(cut < end || end_of_data || end == max_block_size){
+        scan_active = false;
+        return cut;
+    }
+    return 0;
+}
+
+void Seq_Chunking::reset_scan() {
+    scan_active = false;
+}
+
+uint64_t Seq_Chunking::find_cutpoints(char* buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts) {
+    return cut_chunks(buff, size, end_of_data, cuts, [this](char* chunk, uint64_t chunk_size, bool complete) {
+        return Seq_Chunking::resume_cutpoint(chunk, chunk_size, complete);
+    });
+}
+
+uint64_t Seq_Chunking::search_cutpoint(char* buff, uint64_t size, Seq_Scan_State &state) {
+    if(simd_mode != SIMD_Mode::NONE)
+        return find_cutpoint_simd(buff, size, state);
+
     switch(op_mode){
 
         // Seq in INCREASING operation mode
         case Seq_Op_Mode::INCREASING: 
-            return find_cutpoint_increasing(buff, size);
+            return find_cutpoint_increasing(buff, size, state);
             
         // Seq in DECREASING operation mode
         case Seq_Op_Mode::DECREASING:
-            return find_cutpoint_decreasing(buff, size);
+            return find_cutpoint_decreasing(buff, size, state);
         
         default:
             return size;
     }
 }
 
+uint64_t Seq_Chunking::find_cutpoint_simd(char* buff, uint64_t size, Seq_Scan_State &state) {
+    // The kernels count without the 16-bit wrap-around of the scalar counters
+    bool kernel_limits = seq_length_threshold >= 1 && seq_length_threshold <= UINT16_MAX &&
+                         jump_trigger >= 1 && jump_trigger <= UINT16_MAX && min_block_size >= 1;
+    if(kernel_limits && find_seq_cutpoint(buff, size, op_mode == Seq_Op_Mode::DECREASING, seq_length_threshold,
+                                          jump_trigger, jump_size, state))
+        return state.pos;
+
+    if(op_mode == Seq_Op_Mode::DECREASING)
+        return find_cutpoint_decreasing(buff, size, state);
+    return find_cutpoint_increasing(buff, size, state);
+}
\ No newline at end of file
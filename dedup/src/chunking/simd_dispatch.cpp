@@ -0,0 +1,123 @@
+/**
+ * @file simd_dispatch.cpp
+ * @author WASL
+ * @brief Detection of the SIMD instruction sets supported by the CPU
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "simd_dispatch.hpp"
+
+namespace {
+
+struct CPU_Features {
+    bool sse128 = false;
+    bool avx256 = false;
+    bool avx512 = false;
+    bool crc32c = false;
+    bool bmi2 = false;
+};
+
+// Queried once, the first time a SIMD mode is checked
+const CPU_Features& cpu_features() {
+    static const CPU_Features features = []() {
+        CPU_Features detected;
+        #ifdef SIMD_X86_KERNELS
+            __builtin_cpu_init();
+            detected.sse128 = __builtin_cpu_supports("sse4.1");
+            detected.avx256 = __builtin_cpu_supports("avx2");
+            detected.avx512 = __builtin_cpu_supports("avx512f") &&
+                              __builtin_cpu_supports("avx512vl") &&
+                              __builtin_cpu_supports("avx512bw");
+            detected.crc32c = __builtin_cpu_supports("sse4.2");
+            detected.bmi2 = __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2") &&
+                            __builtin_cpu_supports("popcnt");
+        #elif defined(SIMD_CRC32C_KERNELS)
+            detected.crc32c = true;
+        #endif
+        return detected;
+    }();
+    return features;
+}
+
+}  // namespace
+
+bool simd_mode_supported(SIMD_Mode mode) {
+    switch (mode) {
+        case SIMD_Mode::NONE:
+            return true;
+        #ifdef SIMD_X86_KERNELS
+        case SIMD_Mode::SSE128:
+        case SIMD_Mode::SSE128_NOSLIDE:
+            return cpu_features().sse128;
+        case SIMD_Mode::AVX256:
+        case SIMD_Mode::AVX256_NOSLIDE:
+            return cpu_features().avx256;
+        case SIMD_Mode::AVX512:
+        case SIMD_Mode::AVX512_NOSLIDE:
+            return cpu_features().avx512;
+        #endif
+        #ifdef SIMD_NEON_KERNELS
+        case SIMD_Mode::NEON:
+            return true;
+        #endif
+        #ifdef SIMD_ALTIVEC_KERNELS
+        case SIMD_Mode::ALTIVEC:
+            return true;
+        #endif
+        default:
+            return false;
+    }
+}
+
+bool crc32c_hardware_supported() {
+    return cpu_features().crc32c;
+}
+
+bool bmi2_supported() {
+    return cpu_features().bmi2;
+}
+
+SIMD_Mode best_simd_mode() {
+    return best_simd_mode(simd_mode_supported);
+}
+
+SIMD_Mode best_simd_mode(const std::function<bool(SIMD_Mode)>& supported) {
+    const SIMD_Mode preference[] = {SIMD_Mode::AVX512, SIMD_Mode::AVX256,
+                                    SIMD_Mode::SSE128, SIMD_Mode::NEON,
+                                    SIMD_Mode::ALTIVEC};
+    for (SIMD_Mode mode : preference) {
+        if (supported(mode)) {
+            return mode;
+        }
+    }
+    return SIMD_Mode::NONE;
+}
+
+const char* simd_mode_name(SIMD_Mode mode) {
+    switch (mode) {
+        case SIMD_Mode::NONE:
+            return "none";
+        case SIMD_Mode::SSE128_NOSLIDE:
+            return "sse128_noslide";
+        case SIMD_Mode::AVX256_NOSLIDE:
+            return "avx256_noslide";
+        case SIMD_Mode::AVX512_NOSLIDE:
+            return "avx512_noslide";
+        case SIMD_Mode::SSE128:
+            return "sse128";
+        case SIMD_Mode::AVX256:
+            return "avx256";
+        case SIMD_Mode::AVX512:
+            return "avx512";
+        case SIMD_Mode::NEON:
+            return "neon128";
+        case SIMD_Mode::ALTIVEC:
+            return "altivec128";
+        case SIMD_Mode::AUTO:
+            return "auto";
+    }
+    return "unknown";
+}
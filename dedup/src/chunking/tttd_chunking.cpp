@@ -9,6 +9,7 @@
  *
  */
 
+#include <algorithm>
 #include <fstream>
 #include "tttd_chunking.hpp"
 
@@ -23,7 +24,48 @@ TTTD_Chunking::TTTD_Chunking(const Config & config): Rabins_Chunking(config){
 
     rabin_mask = (1 << (fls32(avg_block_size) - 1)) - 1;
     backup_mask = (1 << (fls32(avg_block_size/2) - 1)) - 1;
-    
+
+    init_candidate_bitmap(config, 2);
+}
+
+std::vector<std::vector<std::string>> TTTD_Chunking::chunk_files(const std::vector<std::string>& file_paths){
+    return Chunking_Technique::chunk_files(file_paths);
+}
+
+uint64_t TTTD_Chunking::get_max_block_size() const{
+    return max_block_size;
+}
+
+uint64_t TTTD_Chunking::resume_cutpoint(char *buff, uint64_t size, bool end_of_data){
+    return Chunking_Technique::resume_cutpoint(buff, size, end_of_data);
+}
+
+uint64_t TTTD_Chunking::find_cutpoints(char *buff, uint64_t size, bool end_of_data, std::vector<uint64_t>& cuts){
+    return cut_whole_chunks(buff, size, end_of_data, cuts, [this](char *chunk, uint64_t chunk_size){
+        return TTTD_Chunking::find_cutpoint(chunk, chunk_size);
+    });
+}
+
+/**
+ * @brief: The Rabin window is reset to a single 1 byte before min_block_size, so until
+ * window_size bytes are slid in the fingerprint is that of the 1 byte followed by the data
+ * @return: true if the main divisor matched
+*/
+bool TTTD_Chunking::find_warmup_cutpoint(const char *buff, uint64_t warmup_end, uint64_t &last_backup_pos,
+                                         uint64_t &cut){
+    uint64_t fingerprint = 1;
+    for (uint64_t i = min_block_size; i < warmup_end; i++){
+        uint8_t index = (uint8_t)(fingerprint >> POL_SHIFT);
+        fingerprint = ((fingerprint << 8) | (uint8_t)buff[i]) ^ mod_table[index];
+        if((fingerprint & backup_mask) == 0){
+            last_backup_pos = i;
+            if((fingerprint & rabin_mask) == 0){
+                cut = i;
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 /**
@@ -34,25 +76,133 @@ uint64_t TTTD_Chunking::find_cutpoint(char *buff, uint64_t size){
     if(size < min_block_size)
         return size;
     
-    uint64_t end_pos = (size < max_block_size) ? size: max_block_size;
+    // Never examine the byte past the end of the buffer
+    uint64_t end_pos = (size <= max_block_size) ? size - 1 : max_block_size;
     uint64_t last_backup_pos = 0;
+    uint64_t cut;
+
+    uint64_t pos = std::min(end_pos + 1, min_block_size + window_size - 1);
+    if(find_warmup_cutpoint(buff, pos, last_backup_pos, cut))
+        return cut;
+
+    // From here on every fingerprint covers a full window of data
+    if(simd_mode != SIMD_Mode::NONE && pos >= window_size){
+        // The kernel marks the backup candidates and the main candidates in one pass.
+        // A main candidate is also a backup candidate, so the first main candidate of a
+        // block is the cut point, otherwise its last backup candidate is the fallback.
+        const uint64_t masks[2] = {backup_mask, backup_mask | rabin_mask};
+        const uint64_t block_size = rabin_lanes() * RABIN_SIMD_LANE_SPAN;
+        const uint64_t block_words = block_size / BITMAP_WORD_BITS;
+        uint64_t backup_words[AVX512_REGISTER_SIZE_INT64 * RABIN_SIMD_LANE_SPAN / BITMAP_WORD_BITS];
+        uint64_t main_words[AVX512_REGISTER_SIZE_INT64 * RABIN_SIMD_LANE_SPAN / BITMAP_WORD_BITS];
+        uint64_t *words[2] = {backup_words, main_words};
+        while(pos + block_size <= end_pos + 1){
+            // Runs are skipped by the serial loop, which finishes the chunk
+            Byte_Run run = find_run(buff, pos, end_pos + 1);
+            if(run.start < run.end && run.start < pos + block_size)
+                break;
+            mark_rabin_candidates(buff, pos, RABIN_SIMD_LANE_SPAN, mod_table, out_table, window_size,
+                                  POL_SHIFT, masks, 2, words);
+            for(uint64_t w = 0; w < block_words; w++){
+                if(main_words[w])
+                    return pos + w * BITMAP_WORD_BITS + __builtin_ctzll(main_words[w]);
+            }
+            for(uint64_t w = block_words; w > 0; w--){
+                if(backup_words[w - 1]){
+                    last_backup_pos = pos + w * BITMAP_WORD_BITS - 1 - __builtin_clzll(backup_words[w - 1]);
+                    break;
+                }
+            }
+            pos += block_size;
+        }
+    }
 
-    for (pos = min_block_size; pos <= end_pos; pos++){
-        
-        rabin_slide(buff[pos]);
-        if((digest & backup_mask) == 0){
-            last_backup_pos = pos;
-            if((digest & rabin_mask) == 0){
-                rabin_reset();
-                return pos;
+    if(pos <= end_pos){
+        uint64_t fingerprint = fingerprint_window(buff + pos + 1 - window_size);
+        while(true){
+            // Positions are tested one by one up to the first whose window lies in a run
+            Byte_Run run = find_run(buff, pos, end_pos + 1);
+            uint64_t serial_last = std::min(end_pos, run.start + window_size - 1);
+            while(true){
+                if((fingerprint & backup_mask) == 0){
+                    last_backup_pos = pos;
+                    if((fingerprint & rabin_mask) == 0)
+                        return pos;
+                }
+                if(pos >= serial_last)
+                    break;
+                pos++;
+                fingerprint ^= out_table[(uint8_t)buff[pos - window_size]];
+                uint8_t index = (uint8_t)(fingerprint >> POL_SHIFT);
+                fingerprint = ((fingerprint << 8) | (uint8_t)buff[pos]) ^ mod_table[index];
             }
+            // The fingerprint is the same until the run ends, its last position is the last backup candidate
+            uint64_t after_run = skip_run(buff, run, end_pos + 1);
+            if(after_run > pos + 1){
+                pos = after_run - 1;
+                if((fingerprint & backup_mask) == 0)
+                    last_backup_pos = pos;
+            }
+            if(++pos > end_pos)
+                break;
+            fingerprint ^= out_table[(uint8_t)buff[pos - window_size]];
+            uint8_t index = (uint8_t)(fingerprint >> POL_SHIFT);
+            fingerprint = ((fingerprint << 8) | (uint8_t)buff[pos]) ^ mod_table[index];
         }
     }
-    rabin_reset();
+
     if(last_backup_pos >= min_block_size)
         return last_backup_pos;
-    else
+    // Without a backup candidate the chunk is cut at the maximum block size
+    return (size <= max_block_size) ? size : max_block_size;
+}
+
+/**
+ * @brief: Marks the positions matching the backup divisor and the positions
+ * matching both the backup and the main divisor
+ * @return: None
+*/
+void TTTD_Chunking::mark_candidates(const char* buff, uint64_t start,
+                                    uint64_t end, uint64_t** bitmaps){
+    // find_cutpoint only tests the main divisor once the backup divisor matched
+    const uint64_t masks[2] = {backup_mask, backup_mask | rabin_mask};
+    mark_window_candidates(buff, start, end, masks, 2, bitmaps);
+}
+
+/**
+ * @brief: Two threshold, two-divisor algorithm on top of the candidate bitmaps
+ * @return: Cut point value
+*/
+uint64_t TTTD_Chunking::find_cutpoint_bitmap(char *buff, uint64_t start, uint64_t size){
+    if(size < min_block_size)
         return size;
+
+    char *data = buff + start;
+    uint64_t end_pos = (size <= max_block_size) ? size - 1 : max_block_size;
+    uint64_t last_backup_pos = 0;
+
+    uint64_t cut;
+
+    // The fingerprint starts from the reset state at min_block_size, so the
+    // first window_size - 1 positions are evaluated as in find_cutpoint
+    uint64_t warmup_end = std::min(end_pos + 1, min_block_size + window_size - 1);
+    if(find_warmup_cutpoint(data, warmup_end, last_backup_pos, cut))
+        return cut;
+
+    if(warmup_end <= end_pos){
+        uint64_t main_pos = next_candidate(TTTD_MAIN_LEVEL, start + warmup_end, start + end_pos + 1);
+        if(main_pos <= start + end_pos)
+            return main_pos - start;
+
+        uint64_t backup_pos = last_candidate(TTTD_BACKUP_LEVEL, start + warmup_end, start + end_pos + 1);
+        if(backup_pos <= start + end_pos)
+            last_backup_pos = backup_pos - start;
+    }
+
+    if(last_backup_pos >= min_block_size)
+        return last_backup_pos;
+    // Without a backup candidate the chunk is cut at the maximum block size
+    return (size <= max_block_size) ? size : max_block_size;
 }
 
 TTTD_Chunking::~TTTD_Chunking(){};
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "config.hpp"
+#include "simd_dispatch.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "config_error.hpp"
@@ -61,48 +65,57 @@ HashingTech Config::get_hashing_tech() const {
 }
 
 SIMD_Mode Config::get_simd_mode() const {
+    std::string value;
     try {
-        std::string value = parser.get_property(SIMD_MODE_STRING);
-        if (value == "none") {
-            return SIMD_Mode::NONE;
-        } 
-        #ifdef __SSE3__
-            else if (value == "sse128") {
-                return SIMD_Mode::SSE128;
-            } 
-            else if (value == "sse128_noslide"){
-                return SIMD_Mode::SSE128_NOSLIDE;
-            }
-        #endif
-        
-        #ifdef __AVX2__
-            else if (value == "avx256") {
-                return SIMD_Mode::AVX256;
-            }
-        #endif
-        
-        #ifdef __AVX512F__
-            else if (value == "avx512") {
-                return SIMD_Mode::AVX512;
-            }
-        #endif
-        #ifdef __ARM_NEON
-            else if (value == "neon128") {
-                return SIMD_Mode::NEON;
-            }
-        #endif
-        #ifdef __ALTIVEC__
-            else if (value == "altivec128") {
-                return SIMD_Mode::ALTIVEC;
-            }
-        #endif
-        else {
-            throw ConfigError("Unsupported SIMD mode");
-        }
-    } catch (...) {
+        value = parser.get_property(SIMD_MODE_STRING);
+    } catch (const std::out_of_range&) {
+        return SIMD_Mode::NONE;
     }
-    throw ConfigError(
-        "Unsupported SIMD mode. Please check compilation flags and configuration file.");
+
+    SIMD_Mode mode;
+    if (value == "none") {
+        return SIMD_Mode::NONE;
+    } else if (value == "auto" || value == "autotune") {
+        return SIMD_Mode::AUTO;
+    } else if (value == "sse128") {
+        mode = SIMD_Mode::SSE128;
+    } else if (value == "sse128_noslide") {
+        mode = SIMD_Mode::SSE128_NOSLIDE;
+    } else if (value == "avx256") {
+        mode = SIMD_Mode::AVX256;
+    } else if (value == "avx256_noslide") {
+        mode = SIMD_Mode::AVX256_NOSLIDE;
+    } else if (value == "avx512") {
+        mode = SIMD_Mode::AVX512;
+    } else if (value == "avx512_noslide") {
+        mode = SIMD_Mode::AVX512_NOSLIDE;
+    } else if (value == "neon128") {
+        mode = SIMD_Mode::NEON;
+    } else if (value == "altivec128") {
+        mode = SIMD_Mode::ALTIVEC;
+    } else {
+        throw ConfigError(
+            "Unsupported SIMD mode. Please check compilation flags and configuration file.");
+    }
+
+    if (!simd_mode_supported(mode)) {
+        throw ConfigError(
+            "SIMD mode " + value + " is not supported by this binary or CPU. The best "
+            "supported mode is " + simd_mode_name(best_simd_mode()) + " (simd_mode=auto).");
+    }
+    return mode;
+}
+
+bool Config::get_simd_autotune() const {
+    try {
+        return parser.get_property(SIMD_MODE_STRING) == "autotune";
+    } catch (const std::out_of_range&) {
+    }
+    return false;
+}
+
+void Config::set_simd_mode(SIMD_Mode mode) {
+    parser.set_property(SIMD_MODE_STRING, simd_mode_name(mode));
 }
 
 uint64_t Config::get_fc_size() const {
@@ -363,6 +376,22 @@ uint32_t Config::get_crc_hash_bits() const {
         "The configuration file does not specify a valid crc hash bit number");
 }
 
+CRC_Polynomial Config::get_crc_polynomial() const {
+    std::string value;
+    try {
+        value = parser.get_property(CRC_POLYNOMIAL);
+    } catch (const std::out_of_range&) {
+        return CRC_Polynomial::CRC32;
+    }
+    if (value == "crc32") {
+        return CRC_Polynomial::CRC32;
+    } else if (value == "crc32c") {
+        return CRC_Polynomial::CRC32C;
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid crc polynomial");
+}
+
 uint64_t Config::get_buffer_size() const {
     try {
         std::string value = parser.get_property(BUFFER_SIZE);
@@ -373,6 +402,196 @@ uint64_t Config::get_buffer_size() const {
         "The configuration file does not specify a valid buffer size");
 }
 
+void Config::set_buffer_size(uint64_t buffer_size) {
+    parser.set_property(BUFFER_SIZE, std::to_string(buffer_size));
+}
+
+bool Config::get_candidate_bitmap() const {
+    try {
+        std::string value = parser.get_property(CANDIDATE_BITMAP);
+        if (value == "true") {
+            return true;
+        } else if (value == "false") {
+            return false;
+        }
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid candidate bitmap "
+        "option");
+}
+
+uint64_t Config::get_candidate_bitmap_threads() const {
+    std::string value;
+    try {
+        value = parser.get_property(CANDIDATE_BITMAP_THREADS);
+    } catch (const std::out_of_range&) {
+        return 1;
+    }
+    try {
+        uint64_t threads = std::stoull(value);
+        if (threads > 0) {
+            return threads;
+        }
+    } catch (...) {
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid number of candidate "
+        "bitmap threads");
+}
+
+uint64_t Config::get_candidate_bitmap_region_size() const {
+    std::string value;
+    try {
+        value = parser.get_property(CANDIDATE_BITMAP_REGION_SIZE);
+    } catch (const std::out_of_range&) {
+        return 16 * 1024 * 1024;
+    }
+    try {
+        uint64_t region_size = std::stoull(value);
+        if (region_size > 0) {
+            return region_size;
+        }
+    } catch (...) {
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid candidate bitmap "
+        "region size");
+}
+
+bool Config::get_run_skip() const {
+    try {
+        std::string value = parser.get_property(RUN_SKIP);
+        if (value == "true") {
+            return true;
+        } else if (value == "false") {
+            return false;
+        }
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid run skip option");
+}
+
+uint64_t Config::get_manifest_range_overlap() const {
+    std::string value;
+    try {
+        value = parser.get_property(MANIFEST_RANGE_OVERLAP);
+    } catch (const std::out_of_range&) {
+        return 0;
+    }
+    try {
+        return std::stoull(value);
+    } catch (...) {
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid manifest range "
+        "overlap");
+}
+
+std::string Config::get_fingerprint_index() const {
+    try {
+        return parser.get_property(FINGERPRINT_INDEX);
+    } catch (const std::out_of_range&) {
+    }
+    return "";
+}
+
+uint64_t Config::get_fingerprint_index_capacity() const {
+    std::string value;
+    try {
+        value = parser.get_property(FINGERPRINT_INDEX_CAPACITY);
+    } catch (const std::out_of_range&) {
+        return 16 * 1024 * 1024;
+    }
+    try {
+        uint64_t capacity = std::stoull(value);
+        if (capacity > 0) {
+            return capacity;
+        }
+    } catch (...) {
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid fingerprint index "
+        "capacity");
+}
+
+bool Config::get_write_hash_file() const {
+    try {
+        std::string value = parser.get_property(WRITE_HASH_FILE);
+        if (value == "true") {
+            return true;
+        } else if (value == "false") {
+            return false;
+        }
+    } catch (const std::out_of_range&) {
+        return true;
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid write hash file "
+        "option");
+}
+
+uint64_t Config::get_checkpoint_interval() const {
+    std::string value;
+    try {
+        value = parser.get_property(CHECKPOINT_INTERVAL);
+    } catch (const std::out_of_range&) {
+        return 0;
+    }
+    try {
+        return std::stoull(value);
+    } catch (...) {
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid checkpoint interval");
+}
+
+uint64_t Config::get_multi_stream_files() const {
+    std::string value;
+    try {
+        value = parser.get_property(MULTI_STREAM_FILES);
+    } catch (const std::out_of_range&) {
+        return 0;
+    }
+    try {
+        return std::stoull(value);
+    } catch (...) {
+    }
+    throw ConfigError(
+        "The configuration file does not specify a valid number of multi-stream files");
+}
+
+std::string Config::get_autotune_profile() const {
+    try {
+        return parser.get_property(AUTOTUNE_PROFILE);
+    } catch (const std::out_of_range&) {
+    }
+    return "";
+}
+
+std::string Config::get_chunking_signature() const {
+    // Settings that do not change how the chunker runs, or that are tuned
+    const std::string ignored[] = {SIMD_MODE_STRING, BUFFER_SIZE, HASHING_TECH, OUTPUT_FILE,
+                                   MANIFEST_RANGE_OVERLAP, FINGERPRINT_INDEX,
+                                   FINGERPRINT_INDEX_CAPACITY, WRITE_HASH_FILE,
+                                   CHECKPOINT_INTERVAL, AUTOTUNE_PROFILE};
+    std::string signature;
+    for (const auto& property : parser.get_properties()) {
+        if (std::find(std::begin(ignored), std::end(ignored), property.first) !=
+            std::end(ignored)) {
+            continue;
+        }
+        if (!signature.empty()) {
+            signature += ' ';
+        }
+        signature += property.first + '=' + property.second;
+    }
+    return signature;
+}
+
 uint64_t Config::get_seq_jump_trigger() const {
     try {
         std::string value = parser.get_property(SEQ_JUMP_TRIGGER);
@@ -42,6 +42,16 @@ std::string Parser::get_property(const std::string& key) const {
     return dict.at(key);
 }
 
+void Parser::set_property(const std::string& key, const std::string& value) {
+    dict[key] = value;
+}
+
+std::vector<std::pair<std::string, std::string>> Parser::get_properties() const {
+    std::vector<std::pair<std::string, std::string>> properties(dict.begin(), dict.end());
+    std::sort(properties.begin(), properties.end());
+    return properties;
+}
+
 void Parser::print() const {
     for (auto it = dict.begin(); it != dict.end(); ++it) {
         std::cout << it->first << " = " << it->second << std::endl;
@@ -9,7 +9,14 @@
  *
  */
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -22,6 +29,9 @@
 #include "chunking_common.hpp"
 #include "config.hpp"
 #include "config_error.hpp"
+#include "fingerprint_index.hpp"
+#include "autotune.hpp"
+#include "simd_dispatch.hpp"
 
 #include "ae_chunking.hpp"
 #include "fastcdc.hpp"
@@ -43,35 +53,257 @@
 
 bool disable_hashing = false;
 
+static void print_index_stats(const Fingerprint_Index& index) {
+    Fingerprint_Index_Stats stats = index.get_stats();
+    std::cout << "Index chunks (all processes): " << stats.total_chunks << std::endl;
+    std::cout << "Index unique chunks: " << stats.unique_chunks << std::endl;
+    std::cout << "Index bytes without dedup: " << stats.total_bytes << std::endl;
+    std::cout << "Index bytes with dedup: " << stats.unique_bytes << std::endl;
+    if (stats.unique_bytes > 0) {
+        std::cout << "Index dedup ratio (DER): "
+                  << (double)stats.total_bytes / (double)stats.unique_bytes << std::endl;
+    }
+    if (index.is_full()) {
+        std::cout << "Index is full, the counters above are incomplete" << std::endl;
+    }
+}
+
+static void print_stats(std::unique_ptr<Chunking_Technique>& chunk_method,
+                        uint64_t chunk_count, uint64_t total_bytes) {
+    uint64_t total_mb = total_bytes / (1024*1024);
+    double total_seconds_chunking =  chunk_method->total_time_chunking.count() /1000;
+    double total_seconds_hashing =  chunk_method->total_time_hashing.count() /1000;
+     // Print stats
+    std::cout << "Total number of chunks: " << chunk_count << std::endl;
+    std::cout << "Total bytes chunked: " << total_bytes << std::endl;
+    std::cout << "Avg Chunk size: " << total_bytes / chunk_count
+              << std::endl;
+
+    std::cout << "Chunking Throughput (MB/sec): " << total_mb / total_seconds_chunking << std::endl;
+    std::cout << "Hashing Throughput (MB/sec): "
+              << total_mb / total_seconds_hashing << std::endl;
+
+    if (chunk_method->fingerprint_index) {
+        print_index_stats(*chunk_method->fingerprint_index);
+    }
+}
+
+struct Checkpoint {
+    // Number of directory entries completed
+    uint64_t entries_done = 0;
+    // Chunk boundary reached in the entry after the completed ones
+    uint64_t file_offset = 0;
+    // Path of the entry in progress, or of the last completed one
+    std::string entry_path;
+    uint64_t output_size = 0;
+    uint64_t chunk_count = 0;
+    uint64_t total_bytes = 0;
+    double time_chunking = 0;
+    double time_hashing = 0;
+};
+
+static bool load_checkpoint(const std::string& checkpoint_file, Checkpoint& checkpoint) {
+    std::ifstream in_file(checkpoint_file);
+    if (!in_file.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in_file, line)) {
+        size_t idx = line.find('=');
+        if (idx == std::string::npos) {
+            continue;
+        }
+        std::string key = line.substr(0, idx);
+        std::string value = line.substr(idx + 1);
+        if (key == "entries_done") {
+            checkpoint.entries_done = std::stoull(value);
+        } else if (key == "file_offset") {
+            checkpoint.file_offset = std::stoull(value);
+        } else if (key == "entry_path") {
+            checkpoint.entry_path = value;
+        } else if (key == "output_size") {
+            checkpoint.output_size = std::stoull(value);
+        } else if (key == "chunk_count") {
+            checkpoint.chunk_count = std::stoull(value);
+        } else if (key == "total_bytes") {
+            checkpoint.total_bytes = std::stoull(value);
+        } else if (key == "time_chunking") {
+            checkpoint.time_chunking = std::stod(value);
+        } else if (key == "time_hashing") {
+            checkpoint.time_hashing = std::stod(value);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the data of a file or the entries of a directory to disk with fsync, so they survive a
+ * power loss. fsync applies to the file, not to the descriptor it is called on
+ * @return: false if it failed, with a message on stderr
+ */
+static bool sync_path(const std::string& path, int flags = O_RDONLY) {
+    int fd = open(path.c_str(), flags);
+    if (fd < 0 || fsync(fd) != 0) {
+        std::cerr << "Failed to sync " << path << ": " << strerror(errno) << std::endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+static void save_checkpoint(const std::string& checkpoint_file, const Checkpoint& checkpoint) {
+    // Write a temporary file and rename it, so a crash never leaves a partial checkpoint. The temporary file is
+    // synced before the rename and the directory after it, so the checkpoint found after a reboot is complete
+    std::string tmp_file = checkpoint_file + ".tmp";
+    std::ofstream out_file(tmp_file, std::ios::out | std::ios::trunc);
+    out_file.precision(17);
+    out_file << "entries_done=" << checkpoint.entries_done << '\n'
+             << "file_offset=" << checkpoint.file_offset << '\n'
+             << "output_size=" << checkpoint.output_size << '\n'
+             << "chunk_count=" << checkpoint.chunk_count << '\n'
+             << "total_bytes=" << checkpoint.total_bytes << '\n'
+             << "time_chunking=" << checkpoint.time_chunking << '\n'
+             << "time_hashing=" << checkpoint.time_hashing << '\n'
+             << "entry_path=" << checkpoint.entry_path << '\n';
+    out_file.close();
+    if (out_file.fail()) {
+        std::cerr << "Failed to write checkpoint " << tmp_file << std::endl;
+        return;
+    }
+    if (!sync_path(tmp_file)) {
+        return;
+    }
+    std::filesystem::rename(tmp_file, checkpoint_file);
+    std::filesystem::path directory = std::filesystem::absolute(checkpoint_file).parent_path();
+    sync_path(directory.string(), O_RDONLY | O_DIRECTORY);
+}
+
 static void driver_function(const std::filesystem::path& dir_path,
-                            std::unique_ptr<Chunking_Technique>& chunk_method, const std::string& output_file) {
+                            std::unique_ptr<Chunking_Technique>& chunk_method, const std::string& output_file,
+                            bool write_hashes, uint64_t checkpoint_interval, bool resume,
+                            uint64_t multi_stream_files) {
     /**
      * @brief Uses the specified chunking technique to chunk the file, hash it
      * using the specified hashing technique and print the hashes
      * @param chunk_method: Chunking Technique Object. Object from a class
      * inheriting the Chunking_Technique interface.
      * @param output_file: Output file path for writing hashes to
+     * @param write_hashes: false to skip writing the output file
+     * @param checkpoint_interval: Number of bytes chunked between two
+     * checkpoints, 0 to disable checkpoints. Files are chunked in segments
+     * of this size so large files are checkpointed at chunk boundaries
+     * @param resume: continue from the checkpoint of a previous run
+     * @param multi_stream_files: Number of files handed to the chunking
+     * technique at once, so it can chunk them together. Only used without
+     * checkpoints
      * @return: void
      *
      */
     const std::string delimiter = ", ";
     uint64_t chunk_count = 0;
     uint64_t total_bytes = 0;
+    const std::string checkpoint_file = output_file + ".checkpoint";
+    Checkpoint checkpoint;
     
     if (!std::filesystem::is_directory(dir_path)) {
         std::cerr << dir_path << " is not a directory" << std::endl;
         return;
     }
 
-    // open the output file for writing the hashes to
-    std::ofstream out_file(output_file, std::ios::out | std::ios::trunc);
+    if (resume) {
+        if (!load_checkpoint(checkpoint_file, checkpoint)) {
+            std::cerr << "No checkpoint found at " << checkpoint_file
+                      << ", starting from the beginning" << std::endl;
+            resume = false;
+        } else {
+            chunk_count = checkpoint.chunk_count;
+            total_bytes = checkpoint.total_bytes;
+            chunk_method->total_time_chunking =
+                std::chrono::duration<double, std::milli>(checkpoint.time_chunking);
+            chunk_method->total_time_hashing =
+                std::chrono::duration<double, std::milli>(checkpoint.time_hashing);
+        }
+    }
 
-    if (!out_file.is_open()) {
-        std::cerr << "Failed to open " << output_file << " for writing"
-                  << std::endl;
-        return;
+    // open the output file for writing the hashes to
+    std::ofstream out_file;
+    if (write_hashes) {
+        if (resume) {
+            // Drop the hashes written after the checkpoint. A file shorter than the checkpoint lost hashes it
+            // recorded, and resize_file would pad it with zeros
+            std::error_code error;
+            uint64_t output_size = std::filesystem::file_size(output_file, error);
+            if (error || output_size < checkpoint.output_size) {
+                std::cerr << "Cannot resume: " << output_file << " is shorter than the "
+                          << checkpoint.output_size << " bytes recorded in " << checkpoint_file
+                          << std::endl;
+                return;
+            }
+            std::filesystem::resize_file(output_file, checkpoint.output_size, error);
+            if (error) {
+                std::cerr << "Failed to truncate " << output_file << ": "
+                          << error.message() << std::endl;
+                return;
+            }
+            out_file.open(output_file, std::ios::out | std::ios::app);
+        } else {
+            out_file.open(output_file, std::ios::out | std::ios::trunc);
+        }
+        if (!out_file.is_open()) {
+            std::cerr << "Failed to open " << output_file << " for writing"
+                      << std::endl;
+            return;
+        }
     }
 
+    uint64_t entry_idx = 0;
+    uint64_t bytes_since_checkpoint = 0;
+    auto write_checkpoint = [&](uint64_t entries_done, uint64_t file_offset,
+                                const std::string& entry_path) {
+        bytes_since_checkpoint = 0;
+        if (write_hashes) {
+            // The hashes reach the disk before the checkpoint recording them
+            out_file.flush();
+            if (!sync_path(output_file)) {
+                return;
+            }
+            checkpoint.output_size = out_file.tellp();
+        }
+        checkpoint.entries_done = entries_done;
+        checkpoint.file_offset = file_offset;
+        checkpoint.entry_path = entry_path;
+        checkpoint.chunk_count = chunk_count;
+        checkpoint.total_bytes = total_bytes;
+        checkpoint.time_chunking = chunk_method->total_time_chunking.count();
+        checkpoint.time_hashing = chunk_method->total_time_hashing.count();
+        save_checkpoint(checkpoint_file, checkpoint);
+    };
+
+    // Files waiting to be chunked together, in directory order
+    const bool batch_files = multi_stream_files > 1 && checkpoint_interval == 0 && !resume;
+    std::vector<std::string> batch_paths;
+    uint64_t batch_bytes = 0;
+    auto chunk_batch = [&]() {
+        std::vector<std::vector<std::string>> batch_hashes = chunk_method->chunk_files(batch_paths);
+        for (const auto& hashes : batch_hashes) {
+            chunk_count += hashes.size();
+            if (write_hashes) {
+                for (const auto& hash : hashes) {
+                    out_file << hash << '\n';
+                }
+            }
+        }
+        total_bytes += batch_bytes;
+        if (chunk_method->fingerprint_index) {
+            chunk_method->fingerprint_index->flush();
+        }
+        batch_paths.clear();
+        batch_bytes = 0;
+    };
+
     for (const auto& entry :
         std::filesystem::recursive_directory_iterator(dir_path)) {
         std::filesystem::path file_path = entry.path();
@@ -80,39 +312,297 @@ static void driver_function(const std::filesystem::path& dir_path,
             continue;
         }
 
+        uint64_t start_offset = 0;
+        if (resume) {
+            // Skip the entries completed before the checkpoint, making sure
+            // the directory is still traversed in the same order
+            bool check_path = (entry_idx + 1 == checkpoint.entries_done && checkpoint.file_offset == 0) ||
+                              (entry_idx == checkpoint.entries_done && checkpoint.file_offset > 0);
+            if (check_path && file_path.string() != checkpoint.entry_path) {
+                std::cerr << "Cannot resume: expected " << checkpoint.entry_path << " but found "
+                          << file_path << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            if (entry_idx < checkpoint.entries_done) {
+                entry_idx++;
+                continue;
+            }
+            if (entry_idx == checkpoint.entries_done) {
+                start_offset = checkpoint.file_offset;
+            }
+        }
+
         std::ifstream file_ptr;
         file_ptr.open(file_path, std::ios::in);
         if (!file_ptr.is_open()) {
             std::cerr << "Failed to open " << file_path << " for reading"
                       << std::endl;
+            entry_idx++;
             continue;
         }
-        // Chunk file using specified Chunking_Technique
-        std::vector<std::string> hashes =
-            chunk_method->chunk_file(file_path);
         // get the size of the file
-        total_bytes += chunk_method->get_file_size(&file_ptr);
+        uint64_t file_size = chunk_method->get_file_size(&file_ptr);
+
+        if (batch_files) {
+            batch_paths.push_back(file_path.string());
+            batch_bytes += file_size;
+            if (batch_paths.size() == multi_stream_files) {
+                chunk_batch();
+            }
+            entry_idx++;
+            continue;
+        }
+
+        if (checkpoint_interval == 0 && start_offset == 0) {
+            // Chunk file using specified Chunking_Technique
+            std::vector<std::string> hashes =
+                chunk_method->chunk_file(file_path);
+            chunk_count += hashes.size();
+            if (write_hashes) {
+                for (const auto& hash : hashes) {
+                    out_file << hash << std::endl;
+                    // fc.print();
+                }
+            }
+        } else {
+            // Chunk file in segments ending at chunk boundaries, checkpointing between them
+            uint64_t segment_size = checkpoint_interval ? checkpoint_interval : file_size;
+            uint64_t offset = start_offset;
+            while (offset < file_size) {
+                std::vector<std::string> hashes;
+                uint64_t segment_end = chunk_method->chunk_file_segment(
+                    file_path, offset, segment_size, hashes);
+                bytes_since_checkpoint += segment_end - offset;
+                offset = segment_end;
+                chunk_count += hashes.size();
+                if (write_hashes) {
+                    for (const auto& hash : hashes) {
+                        out_file << hash << '\n';
+                    }
+                }
+                if (checkpoint_interval > 0 && offset < file_size) {
+                    write_checkpoint(entry_idx, offset, file_path.string());
+                }
+            }
+        }
+        total_bytes += file_size;
+        if (chunk_method->fingerprint_index) {
+            chunk_method->fingerprint_index->flush();
+        }
+        entry_idx++;
+        if (checkpoint_interval > 0 && bytes_since_checkpoint >= checkpoint_interval) {
+            write_checkpoint(entry_idx, 0, file_path.string());
+        }
+    }
+    if (!batch_paths.empty()) {
+        chunk_batch();
+    }
+
+    out_file.close();
+    if (checkpoint_interval > 0 || resume) {
+        // The run is complete, the next one starts from the beginning
+        std::filesystem::remove(checkpoint_file);
+    }
+    print_stats(chunk_method, chunk_count, total_bytes);
+}
+
+static void driver_function_manifest(const std::filesystem::path& manifest_path,
+                                     std::unique_ptr<Chunking_Technique>& chunk_method,
+                                     const std::string& output_file,
+                                     bool write_hashes, uint64_t range_overlap) {
+    /**
+     * @brief Chunks the files listed in a manifest, one entry per line.
+     * An entry is either a file path, or a file path followed by the start
+     * and end offsets of a byte range, separated by tabs. Every entry is
+     * written to the output file as a header line "@<start>,<end>,<path>"
+     * followed by the hashes of its chunks. Chunks of a byte range run past
+     * its end by range_overlap bytes so merge-shards can resynchronize them
+     * with the chunks of the following range.
+     * @param manifest_path: Path to the manifest file
+     * @param chunk_method: Chunking Technique Object
+     * @param output_file: Output file path for writing hashes to
+     * @param write_hashes: false to skip writing the output file
+     * @param range_overlap: Number of bytes past the end of a range in which
+     * chunks are still written
+     * @return: void
+     *
+     */
+    uint64_t chunk_count = 0;
+    uint64_t total_bytes = 0;
+
+    std::ifstream manifest(manifest_path);
+    if (!manifest.is_open()) {
+        std::cerr << "Failed to open " << manifest_path << " for reading"
+                  << std::endl;
+        return;
+    }
+
+    // open the output file for writing the hashes to
+    std::ofstream out_file;
+    if (write_hashes) {
+        out_file.open(output_file, std::ios::out | std::ios::trunc);
+        if (!out_file.is_open()) {
+            std::cerr << "Failed to open " << output_file << " for writing"
+                      << std::endl;
+            return;
+        }
+    }
+
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::string file_path = line;
+        uint64_t start = 0;
+        uint64_t end = UINT64_MAX;
+        bool is_range = false;
+        size_t idx = line.find('\t');
+        if (idx != std::string::npos) {
+            file_path = line.substr(0, idx);
+            std::istringstream range(line.substr(idx + 1));
+            if (!(range >> start >> end) || start > end) {
+                std::cerr << "Invalid byte range in manifest entry: " << line
+                          << std::endl;
+                continue;
+            }
+            is_range = true;
+        }
+
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(file_path, error)) {
+            std::cerr << "Failed to open " << file_path << " for reading"
+                      << std::endl;
+            continue;
+        }
+        uint64_t file_size = std::filesystem::file_size(file_path);
+        end = std::min(end, file_size);
+        start = std::min(start, end);
+
+        // Chunk file or byte range using specified Chunking_Technique
+        std::vector<std::string> hashes = is_range ?
+            chunk_method->chunk_file_range(file_path, start, end, range_overlap) :
+            chunk_method->chunk_file(file_path);
+        total_bytes += end - start;
         chunk_count += hashes.size();
+        if (chunk_method->fingerprint_index) {
+            chunk_method->fingerprint_index->flush();
+        }
 
+        if (!write_hashes) {
+            continue;
+        }
+        out_file << '@' << start << ',' << end << ',' << file_path << '\n';
         for (const auto& hash : hashes) {
-            out_file << hash << std::endl;
-            // fc.print();
+            out_file << hash << '\n';
         }
     }
 
     out_file.close();
-    uint64_t total_mb = total_bytes / (1024*1024);
-    double total_seconds_chunking =  chunk_method->total_time_chunking.count() /1000;
-    double total_seconds_hashing =  chunk_method->total_time_hashing.count() /1000;
-     // Print stats
-    std::cout << "Total number of chunks: " << chunk_count << std::endl;
-    std::cout << "Total bytes chunked: " << total_bytes << std::endl;
-    std::cout << "Avg Chunk size: " << total_bytes / chunk_count
-              << std::endl;
+    print_stats(chunk_method, chunk_count, total_bytes);
+}
 
-    std::cout << "Chunking Throughput (MB/sec): " << total_mb / total_seconds_chunking << std::endl;
-    std::cout << "Hashing Throughput (MB/sec): "
-              << total_mb / total_seconds_hashing << std::endl;
+/**
+ * AE, RAM and MAXP are created specialized on the vector type of their SIMD mode (see visit_simd_vector), AE
+ * also on its extreme mode, so their searches make no runtime selection. A mode without a vector type in this
+ * binary creates the generic technique, whose constructor reports it.
+ */
+static std::unique_ptr<Chunking_Technique> create_ae_chunking(const Config& config) {
+    bool maximum = config.get_ae_extreme_mode() == MAX;
+    return visit_simd_vector(config.get_simd_mode(),
+        [&](auto tag) -> std::unique_ptr<Chunking_Technique> {
+            using Vector = typename decltype(tag)::type;
+            if (maximum)
+                return std::make_unique<AE_Chunking_Specialized<Vector, true>>(config);
+            return std::make_unique<AE_Chunking_Specialized<Vector, false>>(config);
+        },
+        [&]() -> std::unique_ptr<Chunking_Technique> { return std::make_unique<AE_Chunking>(config); });
+}
+
+static std::unique_ptr<Chunking_Technique> create_ram_chunking(const Config& config) {
+    return visit_simd_vector(config.get_simd_mode(),
+        [&](auto tag) -> std::unique_ptr<Chunking_Technique> {
+            return std::make_unique<RAM_Chunking_Specialized<typename decltype(tag)::type>>(config);
+        },
+        [&]() -> std::unique_ptr<Chunking_Technique> { return std::make_unique<RAM_Chunking>(config); });
+}
+
+static std::unique_ptr<Chunking_Technique> create_maxp_chunking(const Config& config) {
+    return visit_simd_vector(config.get_simd_mode(),
+        [&](auto tag) -> std::unique_ptr<Chunking_Technique> {
+            return std::make_unique<MAXP_Chunking_Specialized<typename decltype(tag)::type>>(config);
+        },
+        [&]() -> std::unique_ptr<Chunking_Technique> { return std::make_unique<MAXP_Chunking>(config); });
+}
+
+/**
+ * FastCDC without SIMD is created specialized on its average size and normalization level when they are among
+ * FOR_EACH_FASTCDC_SPECIALIZATION, so its masks are immediates
+ */
+static std::unique_ptr<Chunking_Technique> create_fastcdc(const Config& config) {
+    if (config.get_simd_mode() == SIMD_Mode::NONE) {
+        uint64_t avg_block_size = config.get_fastcdc_avg_block_size();
+        uint64_t normalization_level = config.get_fastcdc_disable_normalization() ?
+            0 : config.get_fastcdc_normalization_level();
+        #define CREATE_FASTCDC_SPECIALIZATION(AVG_BLOCK_SIZE, NORMALIZATION_LEVEL) \
+            if (avg_block_size == AVG_BLOCK_SIZE && normalization_level == NORMALIZATION_LEVEL) \
+                return std::make_unique<FastCDC_Specialized<AVG_BLOCK_SIZE, NORMALIZATION_LEVEL>>(config);
+        FOR_EACH_FASTCDC_SPECIALIZATION(CREATE_FASTCDC_SPECIALIZATION)
+        #undef CREATE_FASTCDC_SPECIALIZATION
+    }
+    return std::make_unique<FastCDC>(config);
+}
+
+static std::unique_ptr<Chunking_Technique> create_chunking_technique(const Config& config) {
+    /**
+     * @brief Creates the chunking technique specified in the config file
+     * @param config: the config object
+     * @return: Chunking Technique Object
+     */
+    // Call relevant constructors
+    switch (config.get_chunking_tech()) {
+        case ChunkingTech::FIXED:
+            return std::make_unique<Fixed_Chunking>(config);
+        case ChunkingTech::RABINS:
+            return std::make_unique<Rabins_Chunking>(config);
+        case ChunkingTech::AE:
+            return create_ae_chunking(config);
+        case ChunkingTech::GEAR:
+            return std::make_unique<Gear_Chunking>(config);
+        case ChunkingTech::FASTCDC:
+            return create_fastcdc(config);
+        case ChunkingTech::RAM:
+            return create_ram_chunking(config);
+        case ChunkingTech::CRC:
+            return std::make_unique<SS_CRC_Chunking>(config);
+        case ChunkingTech::MAXP:
+            return create_maxp_chunking(config);
+        case ChunkingTech::SEQ:
+            return std::make_unique<Seq_Chunking>(config);
+        case ChunkingTech::TTTD:
+            return std::make_unique<TTTD_Chunking>(config);
+        default:
+            std::cerr << "Unimplemented chunking technique" << std::endl;
+            exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Replaces simd_mode=auto with the widest mode the configured chunking
+ * technique has kernels for on this CPU, none if it has no SIMD kernels
+ * @param config: the config object, its SIMD mode is set
+ */
+static void resolve_auto_simd_mode(Config& config) {
+    if (config.get_simd_mode() != SIMD_Mode::AUTO) {
+        return;
+    }
+    // Constructing a technique with a mode its kernels cannot run exits, so the probe runs without SIMD
+    config.set_simd_mode(SIMD_Mode::NONE);
+    std::unique_ptr<Chunking_Technique> probe = create_chunking_technique(config);
+    config.set_simd_mode(best_simd_mode([&probe](SIMD_Mode mode) {
+        return probe->supports_simd_mode(mode);
+    }));
 }
 
 int main(int argc, char* argv[]) {
@@ -121,8 +611,60 @@ int main(int argc, char* argv[]) {
      * driver_function()
      * @todo: Add Config class which takes in parameters
      */
-    if (argc > 4 || argc < 3) {
-        std::cout << "Usage: ./dedup.exe <file_path> <config_file_path> [bool]"
+    bool manifest_mode = false;
+    bool resume = false;
+    bool index_stats = false;
+    bool index_remove = false;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = std::string(argv[i]);
+        if (arg == "--manifest") {
+            manifest_mode = true;
+        } else if (arg == "--resume") {
+            resume = true;
+        } else if (arg == "--index-stats") {
+            index_stats = true;
+        } else if (arg == "--index-remove") {
+            index_remove = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    if ((index_stats || index_remove) && args.size() == 1) {
+        // Inspect or remove the fingerprint index named in the config file
+        try {
+            Config config{args[0]};
+            std::string index_name = config.get_fingerprint_index();
+            if (index_name.empty()) {
+                std::cerr << "The configuration file does not specify a fingerprint index"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            if (index_stats) {
+                Fingerprint_Index index{index_name};
+                print_index_stats(index);
+            }
+            if (index_remove && !Fingerprint_Index::remove(index_name)) {
+                std::cerr << "Fingerprint index " << index_name << " does not exist"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        } catch (const ConfigError& e) {
+            std::cerr << e.what() << std::endl;
+            exit(EXIT_FAILURE);
+        } catch (const FingerprintIndexError& e) {
+            std::cerr << e.what() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        exit(EXIT_SUCCESS);
+    }
+
+    if (args.size() > 3 || args.size() < 2 || index_stats || index_remove ||
+        (manifest_mode && resume)) {
+        std::cout << "Usage: ./dedup.exe [--manifest | --resume] <file_path> <config_file_path> [bool]"
+                  << std::endl;
+        std::cout << "       ./dedup.exe [--index-stats] [--index-remove] <config_file_path>"
                   << std::endl;
         std::cout
             << "\t  <file_path>: Path to file to run chunking and hashing on."
@@ -132,12 +674,24 @@ int main(int argc, char* argv[]) {
         std::cout << "\t  [bool]: t or f indicating whether to only perform "
                      "chunking. {f}"
                   << std::endl;
+        std::cout << "\t  --manifest: <file_path> is a manifest listing the "
+                     "files and byte ranges to chunk"
+                  << std::endl;
+        std::cout << "\t  --resume: continue from the checkpoint written by an "
+                     "interrupted run (see checkpoint_interval)"
+                  << std::endl;
+        std::cout << "\t  --index-stats: print the counters of the fingerprint "
+                     "index named in the config file"
+                  << std::endl;
+        std::cout << "\t  --index-remove: remove the fingerprint index named in "
+                     "the config file"
+                  << std::endl;
 
         exit(EXIT_FAILURE);
     }
 
-    if (argc == 4) {
-        std::string bool_val = std::string(argv[3]);
+    if (args.size() == 3) {
+        std::string bool_val = args[2];
         if (bool_val != "t" && bool_val != "f") {
             std::cerr << bool_val << " is not valid. Must be either 't' or 'f'"
                       << std::endl;
@@ -148,52 +702,20 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    std::string dir_path = std::string(argv[1]);
+    std::string dir_path = args[0];
     std::string output_file;
     try {
-        Config config{std::string(argv[2])};
-        ChunkingTech chunking_technique = config.get_chunking_tech();
+        Config config{args[1]};
         HashingTech hashing_technique = config.get_hashing_tech();
         output_file = config.get_output_file();
         
-        std::unique_ptr<Chunking_Technique> chunk_method;
-
-        // Set parameters for hashing technique and call relevant constructors
-        switch (chunking_technique) {
-            case ChunkingTech::FIXED:
-                chunk_method = std::make_unique<Fixed_Chunking>(config);
-                break;
-            case ChunkingTech::RABINS:
-                chunk_method = std::make_unique<Rabins_Chunking>(config);
-                break;
-            case ChunkingTech::AE:
-                chunk_method = std::make_unique<AE_Chunking>(config);
-                break;
-            case ChunkingTech::GEAR:
-                chunk_method = std::make_unique<Gear_Chunking>(config);
-                break;
-            case ChunkingTech::FASTCDC:
-                chunk_method = std::make_unique<FastCDC>(config);
-                break;
-            case ChunkingTech::RAM:
-                chunk_method = std::make_unique<RAM_Chunking>(config);
-                break;
-            case ChunkingTech::CRC:
-                chunk_method = std::make_unique<SS_CRC_Chunking>(config);
-                break;
-            case ChunkingTech::MAXP:
-                chunk_method = std::make_unique<MAXP_Chunking>(config);
-                break;
-            case ChunkingTech::SEQ:
-                chunk_method = std::make_unique<Seq_Chunking>(config);
-                break;
-            case ChunkingTech::TTTD:
-                chunk_method = std::make_unique<TTTD_Chunking>(config);
-                break;
-            default:
-                std::cerr << "Unimplemented chunking technique" << std::endl;
-                exit(EXIT_FAILURE);
+        if (config.get_simd_autotune()) {
+            autotune_chunking(config, dir_path, manifest_mode, create_chunking_technique);
+        } else {
+            resolve_auto_simd_mode(config);
         }
+        std::unique_ptr<Chunking_Technique> chunk_method = create_chunking_technique(config);
+
         if (!disable_hashing) {
             switch (hashing_technique) {
                 case HashingTech::MD5:
@@ -222,12 +744,40 @@ int main(int argc, char* argv[]) {
         //set buffer size 
         chunk_method -> stream_buffer_size = config.get_buffer_size();
 
+        // Attach to the fingerprint index shared with the other processes
+        std::string index_name = config.get_fingerprint_index();
+        if (!index_name.empty()) {
+            if (disable_hashing) {
+                std::cerr << "Chunking only: the fingerprint index is not used" << std::endl;
+            } else {
+                chunk_method -> fingerprint_index = std::make_unique<Fingerprint_Index>(
+                    index_name, config.get_fingerprint_index_capacity());
+            }
+        }
+        bool write_hashes = config.get_write_hash_file();
+
         // Call driver function
-        driver_function(dir_path, chunk_method, output_file);
+        if (manifest_mode) {
+            uint64_t range_overlap = config.get_manifest_range_overlap();
+            if (range_overlap == 0) {
+                // A zero buffer_size makes chunk_stream use 1 MiB buffers
+                uint64_t buffer_size = chunk_method->stream_buffer_size ?
+                    chunk_method->stream_buffer_size : 1024 * 1024;
+                range_overlap = 8 * buffer_size;
+            }
+            driver_function_manifest(dir_path, chunk_method, output_file, write_hashes, range_overlap);
+        } else {
+            driver_function(dir_path, chunk_method, output_file, write_hashes,
+                            config.get_checkpoint_interval(), resume,
+                            config.get_multi_stream_files());
+        }
         // driver_function_stream(dir_path, chunk_method, hash_method, output_file);
     } catch (const ConfigError& e) {
         std::cerr << e.what() << std::endl;
         exit(EXIT_FAILURE);
+    } catch (const FingerprintIndexError& e) {
+        std::cerr << e.what() << std::endl;
+        exit(EXIT_FAILURE);
     }
 
     exit(EXIT_SUCCESS);
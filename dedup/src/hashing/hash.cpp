@@ -43,4 +43,8 @@ std::string Hash::toString() const {
 
 BYTE* Hash::getHash() const {
     return this->hash;
+}
+
+unsigned int Hash::getSize() const {
+    return this->size;
 }
\ No newline at end of file
@@ -0,0 +1,224 @@
+/**
+ * @file fingerprint_index.cpp
+ * @author WASL
+ * @brief Implementations of the shared memory fingerprint index
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "fingerprint_index.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+FingerprintIndexError::FingerprintIndexError(const std::string& msg) : msg(msg) {}
+
+const char* FingerprintIndexError::what() const noexcept { return msg.c_str(); }
+
+static std::string shm_name(const std::string& name) {
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+static std::string errno_message(const std::string& what, const std::string& name) {
+    return what + " fingerprint index " + name + ": " + strerror(errno);
+}
+
+Fingerprint_Index::Fingerprint_Index(const std::string& _name, uint64_t capacity)
+    : name(shm_name(_name)) {
+    uint64_t slot_count = 1;
+    while (slot_count < capacity) {
+        slot_count <<= 1;
+    }
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        // Created here: size the object (zero filled, so all slots are empty)
+        // and publish the header once it is complete
+        mapping_size = sizeof(Header) + slot_count * sizeof(Slot);
+        if (ftruncate(fd, mapping_size) != 0) {
+            std::string msg = errno_message("Failed to size", name);
+            close(fd);
+            shm_unlink(name.c_str());
+            throw FingerprintIndexError(msg);
+        }
+        void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            std::string msg = errno_message("Failed to map", name);
+            shm_unlink(name.c_str());
+            throw FingerprintIndexError(msg);
+        }
+        header = static_cast<Header*>(mapping);
+        header->capacity = slot_count;
+        header->magic.store(FINGERPRINT_INDEX_MAGIC, std::memory_order_release);
+        slots = reinterpret_cast<Slot*>(header + 1);
+        mask = slot_count - 1;
+        return;
+    }
+    if (errno != EEXIST) {
+        throw FingerprintIndexError(errno_message("Failed to create", name));
+    }
+    // Another process created it first
+    Fingerprint_Index attached(_name);
+    std::swap(header, attached.header);
+    std::swap(slots, attached.slots);
+    std::swap(mapping_size, attached.mapping_size);
+    mask = attached.mask;
+}
+
+Fingerprint_Index::Fingerprint_Index(const std::string& _name) : name(shm_name(_name)) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        throw FingerprintIndexError(errno_message("Failed to open", name));
+    }
+
+    // Wait for the creating process to size the object and write the header
+    struct stat st;
+    for (int attempt = 0; ; attempt++) {
+        if (fstat(fd, &st) != 0) {
+            std::string msg = errno_message("Failed to stat", name);
+            close(fd);
+            throw FingerprintIndexError(msg);
+        }
+        if ((uint64_t)st.st_size >= sizeof(Header)) {
+            break;
+        }
+        if (attempt == 1000) {
+            close(fd);
+            throw FingerprintIndexError("Fingerprint index " + name + " was never initialized");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    mapping_size = st.st_size;
+    void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw FingerprintIndexError(errno_message("Failed to map", name));
+    }
+    header = static_cast<Header*>(mapping);
+
+    for (int attempt = 0;
+         header->magic.load(std::memory_order_acquire) != FINGERPRINT_INDEX_MAGIC;
+         attempt++) {
+        if (header->magic.load(std::memory_order_acquire) != 0) {
+            munmap(mapping, mapping_size);
+            header = nullptr;
+            throw FingerprintIndexError(name + " was created with another slot layout, remove it first");
+        }
+        if (attempt == 1000) {
+            munmap(mapping, mapping_size);
+            header = nullptr;
+            throw FingerprintIndexError("Fingerprint index " + name + " was never initialized");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (sizeof(Header) + header->capacity * sizeof(Slot) != mapping_size) {
+        munmap(mapping, mapping_size);
+        header = nullptr;
+        throw FingerprintIndexError(name + " is not a fingerprint index");
+    }
+    slots = reinterpret_cast<Slot*>(header + 1);
+    mask = header->capacity - 1;
+}
+
+Fingerprint_Index::~Fingerprint_Index() {
+    if (header != nullptr) {
+        flush();
+        munmap(header, mapping_size);
+    }
+}
+
+bool Fingerprint_Index::insert(const BYTE* digest, unsigned int digest_size,
+                               uint64_t chunk_size) {
+    uint64_t key[FINGERPRINT_KEY_WORDS] = {0};
+    uint32_t key_size = std::min(digest_size, (unsigned int)FINGERPRINT_KEY_SIZE);
+    memcpy(key, digest, key_size);
+    key[FINGERPRINT_KEY_WORDS - 1] = key_size;
+    // 0 marks an empty slot. Digests are uniformly distributed, so a first
+    // word of 0 or 1 is as unlikely as any other collision
+    if (key[0] == 0) {
+        key[0] = 1;
+    }
+
+    pending.total_chunks++;
+    pending.total_bytes += chunk_size;
+
+    // The first word of the digest picks the slot
+    uint64_t start = key[0];
+    for (uint64_t probe = 0; probe <= mask; probe++) {
+        Slot& slot = slots[(start + probe) & mask];
+        uint64_t first = 0;
+        bool claimed = slot.key[0].compare_exchange_strong(first, key[0],
+                                                           std::memory_order_acq_rel);
+        if (!claimed && first != key[0]) {
+            continue;
+        }
+        // The other words are stored by whichever process gets to them
+        // first. Unwritten words are 0, so storing a word is idempotent
+        bool same_key = true;
+        for (int i = 1; i < FINGERPRINT_KEY_WORDS && same_key; i++) {
+            uint64_t word = 0;
+            same_key = slot.key[i].compare_exchange_strong(word, key[i],
+                                                           std::memory_order_acq_rel) ||
+                       word == key[i];
+        }
+        if (!same_key) {
+            // Another key with the same first word
+            continue;
+        }
+        if (!claimed) {
+            return false;
+        }
+        slot.chunk_size = chunk_size;
+        pending.unique_chunks++;
+        pending.unique_bytes += chunk_size;
+        return true;
+    }
+
+    if (!full_warned) {
+        std::cerr << "Fingerprint index " << name << " is full, increase "
+                  << "fingerprint_index_capacity" << std::endl;
+        full_warned = true;
+    }
+    header->full.store(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Fingerprint_Index::flush() {
+    header->total_chunks.fetch_add(pending.total_chunks, std::memory_order_relaxed);
+    header->unique_chunks.fetch_add(pending.unique_chunks, std::memory_order_relaxed);
+    header->total_bytes.fetch_add(pending.total_bytes, std::memory_order_relaxed);
+    header->unique_bytes.fetch_add(pending.unique_bytes, std::memory_order_relaxed);
+    pending = {0, 0, 0, 0};
+}
+
+Fingerprint_Index_Stats Fingerprint_Index::get_stats() const {
+    return {header->total_chunks.load(std::memory_order_relaxed),
+            header->unique_chunks.load(std::memory_order_relaxed),
+            header->total_bytes.load(std::memory_order_relaxed),
+            header->unique_bytes.load(std::memory_order_relaxed)};
+}
+
+uint64_t Fingerprint_Index::get_capacity() const { return header->capacity; }
+
+bool Fingerprint_Index::is_full() const {
+    return header->full.load(std::memory_order_relaxed) != 0;
+}
+
+bool Fingerprint_Index::remove(const std::string& name) {
+    return shm_unlink(shm_name(name).c_str()) == 0;
+}
@@ -4,15 +4,150 @@
 #include <string>
 #include <cstdint>
 #include <iomanip>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <sstream>
+#include <algorithm>
+#include <unordered_set>
 
+enum class Routing { PREFIX, REPRESENTATIVE };
+
+struct Record {
+    std::string hash;
+    uint64_t size;
+};
+
+struct Shard_Stats {
+    uint64_t chunks = 0;
+    uint64_t logical_bytes = 0;
+    uint64_t stored_bytes = 0;
+};
+
+static void print_usage() {
+    std::cout << "Usage: ./measure-dedup.exe <hash_file_path> [--shards <n>[,<n>...]] "
+                 "[--superchunk <chunks>] [--routing prefix|representative]" << std::endl;
+    std::cout << "\t  --shards: simulate a cluster of n workers, each keeping its own index" << std::endl;
+    std::cout << "\t  --superchunk: number of consecutive chunks routed as one unit {1}" << std::endl;
+    std::cout << "\t  --routing: route by the fingerprint prefix of the first chunk or by the "
+                 "smallest fingerprint of the super-chunk {prefix}" << std::endl;
+}
+
+static uint64_t fingerprint_prefix(const std::string& hash) {
+    return std::stoull(hash.substr(0, 16), nullptr, 16);
+}
+
+/**
+ * @brief Routes every super-chunk to one of num_shards workers, then lets
+ * each worker deduplicate its chunks against its own index on its own thread.
+ * Routing is stateless: it only depends on the fingerprints of the super-chunk.
+ */
+static void simulate_cluster(const std::vector<Record>& records, uint64_t num_shards,
+                             uint64_t superchunk, Routing routing,
+                             uint64_t global_stored_bytes) {
+    std::vector<std::vector<uint64_t>> shard_records(num_shards);
+    for (uint64_t start = 0; start < records.size(); start += superchunk) {
+        uint64_t end = std::min((uint64_t)records.size(), start + superchunk);
+        uint64_t key = fingerprint_prefix(records[start].hash);
+        if (routing == Routing::REPRESENTATIVE) {
+            for (uint64_t i = start + 1; i < end; i++) {
+                key = std::min(key, fingerprint_prefix(records[i].hash));
+            }
+        }
+        std::vector<uint64_t>& target = shard_records[key % num_shards];
+        for (uint64_t i = start; i < end; i++) {
+            target.push_back(i);
+        }
+    }
+
+    std::vector<Shard_Stats> stats(num_shards);
+    auto begin = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> workers;
+    for (uint64_t shard = 0; shard < num_shards; shard++) {
+        workers.emplace_back([&records, &shard_records, &stats, shard]() {
+            std::unordered_set<std::string> index;
+            Shard_Stats& shard_stats = stats[shard];
+            for (uint64_t i : shard_records[shard]) {
+                if (index.insert(records[i].hash).second) {
+                    shard_stats.stored_bytes += records[i].size;
+                }
+                shard_stats.logical_bytes += records[i].size;
+                shard_stats.chunks++;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - begin).count();
+
+    uint64_t logical_bytes = 0;
+    uint64_t stored_bytes = 0;
+    uint64_t max_logical = 0;
+    uint64_t max_stored = 0;
+    for (const auto& shard_stats : stats) {
+        logical_bytes += shard_stats.logical_bytes;
+        stored_bytes += shard_stats.stored_bytes;
+        max_logical = std::max(max_logical, shard_stats.logical_bytes);
+        max_stored = std::max(max_stored, shard_stats.stored_bytes);
+    }
+    double mean_logical = (double)logical_bytes / num_shards;
+    double mean_stored = (double)stored_bytes / num_shards;
+
+    std::cout << std::setw(8) << num_shards
+              << std::setw(12) << (double)logical_bytes / (double)stored_bytes
+              << std::setw(14) << ((double)stored_bytes - (double)global_stored_bytes) /
+                                  (double)global_stored_bytes * 100
+              << std::setw(12) << max_logical / mean_logical
+              << std::setw(12) << max_stored / mean_stored
+              << std::setw(16) << (uint64_t)((double)logical_bytes / (1024 * 1024) / seconds)
+              << std::endl;
+}
 
 int main(int argc, char * argv[]){
-    if(argc != 2){
-        std::cout << "Usage: ./measure-dedup.exe <hash_file_path>" << std::endl;
+    std::vector<uint64_t> shard_counts;
+    uint64_t superchunk = 1;
+    Routing routing = Routing::PREFIX;
+    std::string hash_file_path;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = std::string(argv[i]);
+            if (arg == "--shards" && i + 1 < argc) {
+                std::stringstream counts(argv[++i]);
+                std::string count;
+                while (std::getline(counts, count, ',')) {
+                    shard_counts.push_back(std::stoull(count));
+                }
+            } else if (arg == "--superchunk" && i + 1 < argc) {
+                superchunk = std::stoull(argv[++i]);
+            } else if (arg == "--routing" && i + 1 < argc) {
+                std::string value = std::string(argv[++i]);
+                if (value == "prefix") {
+                    routing = Routing::PREFIX;
+                } else if (value == "representative") {
+                    routing = Routing::REPRESENTATIVE;
+                } else {
+                    print_usage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if (hash_file_path.empty() && arg.rfind("--", 0) != 0) {
+                hash_file_path = arg;
+            } else {
+                print_usage();
+                exit(EXIT_FAILURE);
+            }
+        }
+    } catch (const std::exception&) {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+    if (hash_file_path.empty() || superchunk == 0 ||
+        std::count(shard_counts.begin(), shard_counts.end(), 0)) {
+        print_usage();
         exit(EXIT_FAILURE);
     }
-
-    std::string hash_file_path = std::string(argv[1]);
 
     // read the hash file
     std::ifstream infile(hash_file_path);
@@ -26,7 +161,13 @@ int main(int argc, char * argv[]){
     uint64_t actual_bytes = 0;
     std::string line;
     std::set<std::string> hash_set;
+    // Kept in stream order for the cluster simulation
+    std::vector<Record> records;
     while(std::getline(infile, line)) {
+        // Skip the section headers written in --manifest mode
+        if (line.empty() || line[0] == '@') {
+            continue;
+        }
         size_t idx = line.find(',');
         std::string hash = line.substr(0, idx);
         uint64_t size = std::stoull(line.substr(idx+1, line.length()-idx-1));
@@ -36,6 +177,9 @@ int main(int argc, char * argv[]){
         }
         non_dedup_bytes += size;
         count++;
+        if (!shard_counts.empty()) {
+            records.push_back(Record{hash, size});
+        }
     }
 
     std::cout << "Read " << count << " records in total" << std::endl;
@@ -45,5 +189,18 @@ int main(int argc, char * argv[]){
     std::cout << std::setw(7) << "Dedup ratio (DER): " <<  (double)non_dedup_bytes / (double)actual_bytes << std::endl;
     std::cout << std::setw(7) << "Space savings: " <<  (((double)non_dedup_bytes - (double)actual_bytes)/ (double)non_dedup_bytes) *100 << "%" << std::endl;
 
+    if (!shard_counts.empty() && count > 0) {
+        std::cout << std::endl << "Cluster simulation: "
+                  << (routing == Routing::PREFIX ? "prefix" : "representative")
+                  << " routing, " << superchunk << " chunk(s) per super-chunk" << std::endl;
+        std::cout << std::setw(8) << "Shards" << std::setw(12) << "DER"
+                  << std::setw(14) << "Loss (%)" << std::setw(12) << "Load skew"
+                  << std::setw(12) << "Store skew" << std::setw(16) << "Index MB/sec"
+                  << std::endl;
+        for (uint64_t num_shards : shard_counts) {
+            simulate_cluster(records, num_shards, superchunk, routing, actual_bytes);
+        }
+    }
+
     exit(EXIT_SUCCESS);
 }
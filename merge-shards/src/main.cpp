@@ -0,0 +1,233 @@
+/**
+ * @file main.cpp
+ * @author WASL
+ * @brief Merges the hash files written by dedup.exe --manifest shards into a
+ * single hash file and reports the combined dedup ratio
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Chunks written by one shard for one manifest entry
+struct Section {
+    uint64_t start;
+    uint64_t end;
+    std::vector<std::string> lines;
+    std::vector<uint64_t> offsets;
+    uint64_t chunks_end;
+};
+
+struct Merge_Stats {
+    uint64_t count = 0;
+    uint64_t non_dedup_bytes = 0;
+    uint64_t actual_bytes = 0;
+    uint64_t resynchronized_edges = 0;
+    uint64_t failed_edges = 0;
+    std::unordered_set<std::string> hash_set;
+};
+
+static void emit_chunks(const Section& section, uint64_t first, uint64_t last,
+                        std::ofstream& out_file, Merge_Stats& stats) {
+    for (uint64_t i = first; i < last; i++) {
+        const std::string& line = section.lines[i];
+        size_t idx = line.find(',');
+        std::string hash = line.substr(0, idx);
+        uint64_t size = std::stoull(line.substr(idx + 1));
+        if (stats.hash_set.insert(hash).second) {
+            stats.actual_bytes += size;
+        }
+        stats.non_dedup_bytes += size;
+        stats.count++;
+        out_file << line << '\n';
+    }
+}
+
+/**
+ * @brief Counts <gap_start, gap_end> as one chunk found in no other file. The
+ * record is written with a placeholder hash naming the file and offset, since
+ * no shard hashed these bytes on their own.
+ */
+static void emit_gap(uint64_t file_number, uint64_t gap_start, uint64_t gap_end,
+                     std::ofstream& out_file, Merge_Stats& stats) {
+    std::string hash = "unmerged:" + std::to_string(file_number) + ":" + std::to_string(gap_start);
+    uint64_t size = gap_end - gap_start;
+    stats.hash_set.insert(hash);
+    stats.actual_bytes += size;
+    stats.non_dedup_bytes += size;
+    stats.count++;
+    out_file << hash << ',' << size << '\n';
+}
+
+/**
+ * @brief Stitches the sections of one file together. The first chunk of a
+ * byte range starts at the range edge rather than at a real boundary, so the
+ * chunks of the previous range (which run past the edge) are kept until the
+ * first boundary both ranges agree on. From there on both produce the same
+ * chunks as a single-process run.
+ */
+static void merge_file(const std::string& file_path, uint64_t file_number,
+                       std::vector<Section>& sections, std::ofstream& out_file,
+                       Merge_Stats& stats) {
+    std::sort(sections.begin(), sections.end(),
+              [](const Section& a, const Section& b) { return a.start < b.start; });
+
+    if (sections.front().start != 0) {
+        std::cerr << "Warning: " << file_path << " has no range starting at offset 0"
+                  << std::endl;
+    }
+
+    const Section* current = &sections[0];
+    uint64_t current_idx = 0;
+    for (uint64_t k = 1; k < sections.size(); k++) {
+        const Section& next = sections[k];
+        if (next.start != sections[k - 1].end) {
+            std::cerr << "Warning: ranges of " << file_path << " are not contiguous at offset "
+                      << next.start << std::endl;
+        }
+
+        // First chunk of the current section starting at or after the range edge
+        uint64_t i = std::lower_bound(current->offsets.begin(), current->offsets.end(),
+                                      next.start) - current->offsets.begin();
+        uint64_t edge_idx = i;
+        uint64_t j = 0;
+        bool found = false;
+        while (i <= current->offsets.size() && j < next.offsets.size()) {
+            uint64_t current_boundary = (i < current->offsets.size()) ?
+                current->offsets[i] : current->chunks_end;
+            if (current_boundary == next.offsets[j]) {
+                found = true;
+                break;
+            } else if (current_boundary < next.offsets[j]) {
+                i++;
+            } else {
+                j++;
+            }
+        }
+
+        if (found) {
+            emit_chunks(*current, current_idx, i, out_file, stats);
+            stats.resynchronized_edges++;
+        } else {
+            // Keep every chunk starting before the edge and skip the chunks
+            // of the next range they overlap. The bytes between the last kept
+            // chunk and the next boundary of the next range are counted as one
+            // chunk, so no byte of the file is lost. Results may differ slightly.
+            std::cerr << "Warning: no common boundary after offset " << next.start << " of "
+                      << file_path << ", increase manifest_range_overlap" << std::endl;
+            emit_chunks(*current, current_idx, edge_idx, out_file, stats);
+            uint64_t emitted_end = (edge_idx > 0) ? current->offsets[edge_idx - 1] +
+                std::stoull(current->lines[edge_idx - 1].substr(
+                    current->lines[edge_idx - 1].find(',') + 1)) : next.start;
+            j = std::lower_bound(next.offsets.begin(), next.offsets.end(), emitted_end) -
+                next.offsets.begin();
+            uint64_t gap_start = std::max(emitted_end, next.start);
+            uint64_t gap_end = (j < next.offsets.size()) ? next.offsets[j] : next.chunks_end;
+            if (gap_end > gap_start) {
+                emit_gap(file_number, gap_start, gap_end, out_file, stats);
+            }
+            stats.failed_edges++;
+        }
+        current = &next;
+        current_idx = j;
+    }
+    emit_chunks(*current, current_idx, current->lines.size(), out_file, stats);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: ./merge-shards.exe <output_file> <shard_hash_file> "
+                     "[<shard_hash_file> ...]"
+                  << std::endl;
+        std::cout << "\t  <output_file>: Path of the merged hash file to write"
+                  << std::endl;
+        std::cout << "\t  <shard_hash_file>: Hash file written by dedup.exe --manifest"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::unordered_map<std::string, std::vector<Section>> sections;
+    std::vector<std::string> file_order;
+
+    for (int arg = 2; arg < argc; arg++) {
+        std::string hash_file_path = std::string(argv[arg]);
+        std::ifstream infile(hash_file_path);
+        if (infile.fail()) {
+            std::cerr << "Failed to open hash file: " << hash_file_path << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        Section* section = nullptr;
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            if (line[0] == '@') {
+                // Section header: @<start>,<end>,<path>
+                size_t first = line.find(',');
+                size_t second = line.find(',', first + 1);
+                if (first == std::string::npos || second == std::string::npos) {
+                    std::cerr << "Invalid section header in " << hash_file_path << ": "
+                              << line << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                std::string file_path = line.substr(second + 1);
+                if (sections.count(file_path) == 0) {
+                    file_order.push_back(file_path);
+                }
+                sections[file_path].push_back(Section{});
+                section = &sections[file_path].back();
+                section->start = std::stoull(line.substr(1, first - 1));
+                section->end = std::stoull(line.substr(first + 1, second - first - 1));
+                section->chunks_end = section->start;
+                continue;
+            }
+            if (section == nullptr) {
+                std::cerr << hash_file_path << " is not a manifest hash file: missing section header"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            size_t idx = line.find(',');
+            uint64_t size = std::stoull(line.substr(idx + 1));
+            section->offsets.push_back(section->chunks_end);
+            section->lines.push_back(line);
+            section->chunks_end += size;
+        }
+    }
+
+    std::ofstream out_file(argv[1], std::ios::out | std::ios::trunc);
+    if (!out_file.is_open()) {
+        std::cerr << "Failed to open " << argv[1] << " for writing" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    Merge_Stats stats;
+    for (uint64_t k = 0; k < file_order.size(); k++) {
+        merge_file(file_order[k], k, sections[file_order[k]], out_file, stats);
+    }
+    out_file.close();
+
+    std::cout << "Merged " << file_order.size() << " files" << std::endl;
+    std::cout << "Resynchronized range edges: " << stats.resynchronized_edges << std::endl;
+    std::cout << "Range edges without a common boundary: " << stats.failed_edges << std::endl;
+    std::cout << "Read " << stats.count << " records in total" << std::endl;
+    std::cout << "Total bytes without dedup: " << stats.non_dedup_bytes << std::endl;
+    std::cout << "Total bytes with dedup: " << stats.actual_bytes << std::endl;
+    std::cout.precision(4);
+    std::cout << std::setw(7) << "Dedup ratio (DER): " <<  (double)stats.non_dedup_bytes / (double)stats.actual_bytes << std::endl;
+    std::cout << std::setw(7) << "Space savings: " <<  (((double)stats.non_dedup_bytes - (double)stats.actual_bytes)/ (double)stats.non_dedup_bytes) *100 << "%" << std::endl;
+
+    exit(EXIT_SUCCESS);
+}
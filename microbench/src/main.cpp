@@ -0,0 +1,447 @@
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <algorithm>
+
+#include "simd_kernels.hpp"
+
+#define DEFAULT_BUFFER_MB 8
+#define DEFAULT_REPETITIONS 7
+#define DEFAULT_WINDOW_STRIDE 64
+
+// Seed of the random data, so every run times the same bytes
+#define DATA_SEED 42
+
+// Kernel finding the maximum or minimum byte of a window <start_pos, end_pos>
+typedef uint8_t (*Extremum_Kernel)(const char *buff, uint64_t start_pos, uint64_t end_pos);
+
+/**
+ * @brief A version of the find_maximum / find_minimum kernels of one instruction set
+ */
+struct Kernel_Variant {
+    const char *name;
+    Extremum_Kernel find_maximum;
+    Extremum_Kernel find_minimum;
+};
+
+struct Instruction_Set {
+    const char *name;
+    uint64_t register_bytes;
+    bool supported;
+    std::vector<Kernel_Variant> variants;
+};
+
+// Variants compared for each instruction set, one column of the results each
+static const char *const VARIANT_NAMES[] = {"tree", "handwritten", "generic"};
+
+/**
+ * Scratch registers of the tree kernels. The chunkers used to own one array per SIMD mode, holding a register
+ * for every vector of a window.
+ */
+static void *tree_scratch = nullptr;
+
+/**
+ * @brief find_maximum / find_minimum as they were before the kernels accumulated in registers: every vector of
+ * the window is stored in the scratch array, then the array is reduced as a tree and the last register is
+ * scanned byte by byte. The tree reads scratch[num_vectors, next power of 2) when the vector count is not a
+ * power of 2, so the array is filled with the neutral value of the reduction before the kernel is timed.
+ */
+template <class Vector, bool MAXIMUM>
+SIMD_INLINE uint8_t tree_find_extremum(const char *buff, uint64_t start_pos, uint64_t end_pos){
+    using type = typename Vector::type;
+    type *array = (type *)tree_scratch;
+    uint64_t num_vectors = (end_pos - start_pos) / Vector::BYTES;
+
+    for(uint64_t i = 0; i < num_vectors; i++)
+        Vector::load(array[i], buff + start_pos + Vector::BYTES * i);
+
+    uint64_t step = 2;
+    uint64_t half_step = 1;
+    while(step <= num_vectors){
+        for(uint64_t i = 0; i < num_vectors; i += step)
+            simd_combine<Vector, MAXIMUM>(array[i], array[i + half_step]);
+        half_step = step;
+        step = step << 1;
+    }
+
+    uint8_t result_store[Vector::BYTES];
+    std::memcpy(result_store, &array[0], Vector::BYTES);
+    uint8_t result = MAXIMUM ? 0 : UINT8_MAX;
+    for(uint64_t i = 0; i < Vector::BYTES; i++)
+        result = MAXIMUM ? std::max(result, result_store[i]) : std::min(result, result_store[i]);
+    return result;
+}
+
+/**
+ * find_maximum / find_minimum of SSE128, AVX256 and AVX512 as they were written for each instruction set before
+ * the kernels were written once over the vector types of simd_kernels.hpp. They should run as fast as the
+ * generic kernels.
+ */
+#if defined(SIMD_X86_KERNELS)
+
+// Combines the bytes of 2 registers with max or min
+#define EXTREMA_COMBINE(MAXIMUM, MAX_OP, MIN_OP, a, b) ((MAXIMUM) ? MAX_OP(a, b) : MIN_OP(a, b))
+
+// Folds the high byte of each 16-bit lane onto the low one, which leaves 16-bit values minpos can reduce
+SIMD_TARGET_SSE128 static inline uint8_t horizontal_min_sse128(__m128i v){
+    v = _mm_min_epu8(v, _mm_srli_epi16(v, 8));
+    return (uint8_t)_mm_cvtsi128_si32(_mm_minpos_epu16(v));
+}
+
+// The maximum is the minimum of the inverted bytes
+SIMD_TARGET_SSE128 static inline uint8_t horizontal_max_sse128(__m128i v){
+    return ~horizontal_min_sse128(_mm_xor_si128(v, _mm_set1_epi8(-1)));
+}
+
+template <bool MAXIMUM>
+SIMD_TARGET_SSE128 static inline uint8_t find_extremum_sse128(const char *buff, uint64_t start_pos, uint64_t end_pos){
+    const uint8_t *bytes = (const uint8_t *)buff;
+    uint64_t num_vectors = (end_pos - start_pos) / sizeof(__m128i);
+    if(num_vectors == 0){
+        alignas(16) uint8_t copy[sizeof(__m128i)];
+        std::memset(copy, MAXIMUM ? 0 : UINT8_MAX, sizeof(copy));
+        std::memcpy(copy, bytes + start_pos, end_pos - start_pos);
+        __m128i v = _mm_load_si128((const __m128i *)copy);
+        return MAXIMUM ? horizontal_max_sse128(v) : horizontal_min_sse128(v);
+    }
+
+    const __m128i *data = (const __m128i *)(buff + start_pos);
+    __m128i acc[EXTREMA_ACCUMULATORS];
+    for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++)
+        acc[j] = _mm_loadu_si128(data);
+
+    uint64_t i = 0;
+    for(; i + EXTREMA_ACCUMULATORS <= num_vectors; i += EXTREMA_ACCUMULATORS){
+        for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++)
+            acc[j] = EXTREMA_COMBINE(MAXIMUM, _mm_max_epu8, _mm_min_epu8, acc[j], _mm_loadu_si128(data + i + j));
+    }
+    for(; i < num_vectors; i++)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm_max_epu8, _mm_min_epu8, acc[0], _mm_loadu_si128(data + i));
+
+    if((end_pos - start_pos) % sizeof(__m128i) != 0)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm_max_epu8, _mm_min_epu8, acc[0],
+                                 _mm_loadu_si128((const __m128i *)(buff + end_pos - sizeof(__m128i))));
+    for(uint64_t j = 1; j < EXTREMA_ACCUMULATORS; j++)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm_max_epu8, _mm_min_epu8, acc[0], acc[j]);
+    return MAXIMUM ? horizontal_max_sse128(acc[0]) : horizontal_min_sse128(acc[0]);
+}
+
+template <bool MAXIMUM>
+SIMD_TARGET_AVX256 static inline uint8_t find_extremum_avx256(const char *buff, uint64_t start_pos, uint64_t end_pos){
+    const uint8_t *bytes = (const uint8_t *)buff;
+    uint64_t num_vectors = (end_pos - start_pos) / sizeof(__m256i);
+    if(num_vectors == 0){
+        alignas(32) uint8_t copy[sizeof(__m256i)];
+        std::memset(copy, MAXIMUM ? 0 : UINT8_MAX, sizeof(copy));
+        std::memcpy(copy, bytes + start_pos, end_pos - start_pos);
+        __m256i v = _mm256_load_si256((const __m256i *)copy);
+        __m128i half = EXTREMA_COMBINE(MAXIMUM, _mm_max_epu8, _mm_min_epu8,
+                                       _mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        return MAXIMUM ? horizontal_max_sse128(half) : horizontal_min_sse128(half);
+    }
+
+    const __m256i *data = (const __m256i *)(buff + start_pos);
+    __m256i acc[EXTREMA_ACCUMULATORS];
+    for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++)
+        acc[j] = _mm256_loadu_si256(data);
+
+    uint64_t i = 0;
+    for(; i + EXTREMA_ACCUMULATORS <= num_vectors; i += EXTREMA_ACCUMULATORS){
+        for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++)
+            acc[j] = EXTREMA_COMBINE(MAXIMUM, _mm256_max_epu8, _mm256_min_epu8, acc[j], _mm256_loadu_si256(data + i + j));
+    }
+    for(; i < num_vectors; i++)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm256_max_epu8, _mm256_min_epu8, acc[0], _mm256_loadu_si256(data + i));
+
+    if((end_pos - start_pos) % sizeof(__m256i) != 0)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm256_max_epu8, _mm256_min_epu8, acc[0],
+                                 _mm256_loadu_si256((const __m256i *)(buff + end_pos - sizeof(__m256i))));
+    for(uint64_t j = 1; j < EXTREMA_ACCUMULATORS; j++)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm256_max_epu8, _mm256_min_epu8, acc[0], acc[j]);
+    __m128i half = EXTREMA_COMBINE(MAXIMUM, _mm_max_epu8, _mm_min_epu8,
+                                   _mm256_castsi256_si128(acc[0]), _mm256_extracti128_si256(acc[0], 1));
+    return MAXIMUM ? horizontal_max_sse128(half) : horizontal_min_sse128(half);
+}
+
+template <bool MAXIMUM>
+SIMD_TARGET_AVX512 static inline uint8_t find_extremum_avx512(const char *buff, uint64_t start_pos, uint64_t end_pos){
+    uint64_t num_vectors = (end_pos - start_pos) / sizeof(__m512i);
+    uint64_t tail = (end_pos - start_pos) % sizeof(__m512i);
+    const char *data = buff + start_pos;
+    const __m512i neutral = _mm512_set1_epi8(MAXIMUM ? 0 : -1);
+    __m512i acc[EXTREMA_ACCUMULATORS];
+    for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++)
+        acc[j] = neutral;
+
+    uint64_t i = 0;
+    for(; i + EXTREMA_ACCUMULATORS <= num_vectors; i += EXTREMA_ACCUMULATORS){
+        for(uint64_t j = 0; j < EXTREMA_ACCUMULATORS; j++)
+            acc[j] = EXTREMA_COMBINE(MAXIMUM, _mm512_max_epu8, _mm512_min_epu8, acc[j],
+                                     _mm512_loadu_si512((const void *)(data + (i + j) * sizeof(__m512i))));
+    }
+    for(; i < num_vectors; i++)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm512_max_epu8, _mm512_min_epu8, acc[0],
+                                 _mm512_loadu_si512((const void *)(data + i * sizeof(__m512i))));
+
+    // Masked-off bytes keep the neutral value and are never read
+    if(tail != 0)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm512_max_epu8, _mm512_min_epu8, acc[0],
+                                 _mm512_mask_loadu_epi8(neutral, ((__mmask64)1 << tail) - 1,
+                                                        (const void *)(data + num_vectors * sizeof(__m512i))));
+    for(uint64_t j = 1; j < EXTREMA_ACCUMULATORS; j++)
+        acc[0] = EXTREMA_COMBINE(MAXIMUM, _mm512_max_epu8, _mm512_min_epu8, acc[0], acc[j]);
+    __m256i quarter = EXTREMA_COMBINE(MAXIMUM, _mm256_max_epu8, _mm256_min_epu8,
+                                      _mm512_maskz_extracti64x4_epi64(0xF, acc[0], 0),
+                                      _mm512_maskz_extracti64x4_epi64(0xF, acc[0], 1));
+    __m128i half = EXTREMA_COMBINE(MAXIMUM, _mm_max_epu8, _mm_min_epu8,
+                                   _mm256_castsi256_si128(quarter), _mm256_extracti128_si256(quarter, 1));
+    return MAXIMUM ? horizontal_max_sse128(half) : horizontal_min_sse128(half);
+}
+
+#define HANDWRITTEN_VARIANTS(TARGET, PREFIX) \
+    TARGET static uint8_t PREFIX##_handwritten_max(const char *buff, uint64_t start_pos, uint64_t end_pos){ \
+        return find_extremum_##PREFIX<true>(buff, start_pos, end_pos); \
+    } \
+    TARGET static uint8_t PREFIX##_handwritten_min(const char *buff, uint64_t start_pos, uint64_t end_pos){ \
+        return find_extremum_##PREFIX<false>(buff, start_pos, end_pos); \
+    }
+
+HANDWRITTEN_VARIANTS(SIMD_TARGET_SSE128, sse128)
+HANDWRITTEN_VARIANTS(SIMD_TARGET_AVX256, avx256)
+HANDWRITTEN_VARIANTS(SIMD_TARGET_AVX512, avx512)
+#endif
+
+// tree and generic variants of a vector type, compiled for its instruction set
+#define KERNEL_VARIANTS(TARGET, VECTOR, PREFIX) \
+    TARGET static uint8_t PREFIX##_tree_max(const char *buff, uint64_t start_pos, uint64_t end_pos){ \
+        return tree_find_extremum<VECTOR, true>(buff, start_pos, end_pos); \
+    } \
+    TARGET static uint8_t PREFIX##_tree_min(const char *buff, uint64_t start_pos, uint64_t end_pos){ \
+        return tree_find_extremum<VECTOR, false>(buff, start_pos, end_pos); \
+    } \
+    static uint8_t PREFIX##_generic_max(const char *buff, uint64_t start_pos, uint64_t end_pos){ \
+        return VECTOR::find_extremum<true>(buff, start_pos, end_pos); \
+    } \
+    static uint8_t PREFIX##_generic_min(const char *buff, uint64_t start_pos, uint64_t end_pos){ \
+        return VECTOR::find_extremum<false>(buff, start_pos, end_pos); \
+    }
+
+#if defined(SIMD_SSE128_KERNELS)
+KERNEL_VARIANTS(SIMD_TARGET_SSE128, SSE128_Vector, sse128)
+#endif
+#if defined(SIMD_AVX256_KERNELS)
+KERNEL_VARIANTS(SIMD_TARGET_AVX256, AVX256_Vector, avx256)
+#endif
+#if defined(SIMD_AVX512_KERNELS)
+KERNEL_VARIANTS(SIMD_TARGET_AVX512, AVX512_Vector, avx512)
+#endif
+#if defined(SIMD_NEON_KERNELS)
+KERNEL_VARIANTS(SIMD_TARGET_NEON, NEON_Vector, neon)
+#endif
+#if defined(SIMD_ALTIVEC_KERNELS)
+KERNEL_VARIANTS(SIMD_TARGET_ALTIVEC, ALTIVEC_Vector, altivec)
+#endif
+
+#define INSTRUCTION_SET(NAME, VECTOR, PREFIX, SUPPORTED) \
+    Instruction_Set{NAME, VECTOR::BYTES, SUPPORTED, { \
+        {"tree", PREFIX##_tree_max, PREFIX##_tree_min}, \
+        {"generic", PREFIX##_generic_max, PREFIX##_generic_min}}}
+
+// Instruction sets that also have handwritten kernels
+#define X86_INSTRUCTION_SET(NAME, VECTOR, PREFIX, SUPPORTED) \
+    Instruction_Set{NAME, VECTOR::BYTES, SUPPORTED, { \
+        {"tree", PREFIX##_tree_max, PREFIX##_tree_min}, \
+        {"handwritten", PREFIX##_handwritten_max, PREFIX##_handwritten_min}, \
+        {"generic", PREFIX##_generic_max, PREFIX##_generic_min}}}
+
+static std::vector<Instruction_Set> instruction_sets() {
+    std::vector<Instruction_Set> sets;
+    #if defined(SIMD_X86_KERNELS)
+        __builtin_cpu_init();
+    #endif
+    #if defined(SIMD_SSE128_KERNELS)
+        sets.push_back(X86_INSTRUCTION_SET("sse128", SSE128_Vector, sse128, __builtin_cpu_supports("sse4.1") != 0));
+    #endif
+    #if defined(SIMD_AVX256_KERNELS)
+        sets.push_back(X86_INSTRUCTION_SET("avx256", AVX256_Vector, avx256, __builtin_cpu_supports("avx2") != 0));
+    #endif
+    #if defined(SIMD_AVX512_KERNELS)
+        sets.push_back(X86_INSTRUCTION_SET("avx512", AVX512_Vector, avx512,
+                                           __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                                           __builtin_cpu_supports("avx512vl")));
+    #endif
+    #if defined(SIMD_NEON_KERNELS)
+        sets.push_back(INSTRUCTION_SET("neon128", NEON_Vector, neon, true));
+    #endif
+    #if defined(SIMD_ALTIVEC_KERNELS)
+        sets.push_back(INSTRUCTION_SET("altivec128", ALTIVEC_Vector, altivec, true));
+    #endif
+    return sets;
+}
+
+static void print_usage() {
+    std::cout << "Usage: ./microbench.exe [--windows <bytes>[,<bytes>...]] [--size <MB>] "
+                 "[--stride <bytes>] [--reps <n>]" << std::endl;
+    std::cout << "\t  --windows: window sizes passed to the kernels {256,1024,7936}" << std::endl;
+    std::cout << "\t  --size: megabytes of random data the windows are taken from {" << DEFAULT_BUFFER_MB << "}"
+              << std::endl;
+    std::cout << "\t  --stride: bytes between the starts of consecutive windows {" << DEFAULT_WINDOW_STRIDE << "}"
+              << std::endl;
+    std::cout << "\t  --reps: repetitions of each measurement, the fastest is reported {" << DEFAULT_REPETITIONS
+              << "}" << std::endl;
+}
+
+/**
+ * @brief Runs a kernel on every window and checks its results against expected
+ * @return seconds taken by the fastest of repetitions passes, or a negative value if a result was wrong
+ */
+static double time_kernel(Extremum_Kernel kernel, const std::vector<char>& data, uint64_t window,
+                          uint64_t stride, const std::vector<uint8_t>& expected, uint64_t repetitions) {
+    double best = 0;
+    for (uint64_t rep = 0; rep < repetitions; rep++) {
+        std::vector<uint8_t> results(expected.size());
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < results.size(); i++) {
+            results[i] = kernel(data.data(), i * stride, i * stride + window);
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (results != expected) {
+            return -1;
+        }
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (rep == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char * argv[]){
+    std::vector<uint64_t> windows;
+    uint64_t buffer_mb = DEFAULT_BUFFER_MB;
+    uint64_t stride = DEFAULT_WINDOW_STRIDE;
+    uint64_t repetitions = DEFAULT_REPETITIONS;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = std::string(argv[i]);
+            if (arg == "--windows" && i + 1 < argc) {
+                std::stringstream sizes(argv[++i]);
+                std::string size;
+                while (std::getline(sizes, size, ',')) {
+                    windows.push_back(std::stoull(size));
+                }
+            } else if (arg == "--size" && i + 1 < argc) {
+                buffer_mb = std::stoull(argv[++i]);
+            } else if (arg == "--stride" && i + 1 < argc) {
+                stride = std::stoull(argv[++i]);
+            } else if (arg == "--reps" && i + 1 < argc) {
+                repetitions = std::stoull(argv[++i]);
+            } else {
+                print_usage();
+                exit(EXIT_FAILURE);
+            }
+        }
+    } catch (const std::exception&) {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+    if (windows.empty()) {
+        windows = {256, 1024, 7936};
+    }
+    uint64_t buffer_size = buffer_mb * 1024 * 1024;
+    uint64_t max_window = *std::max_element(windows.begin(), windows.end());
+    if (stride == 0 || repetitions == 0 || std::count(windows.begin(), windows.end(), 0) ||
+        max_window > buffer_size) {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<char> data(buffer_size);
+    std::mt19937_64 generator(DATA_SEED);
+    for (uint64_t i = 0; i < buffer_size; i += sizeof(uint64_t)) {
+        uint64_t value = generator();
+        std::memcpy(data.data() + i, &value, std::min((uint64_t)sizeof(uint64_t), buffer_size - i));
+    }
+
+    // Enough registers for the next power of 2 of the vector count of the largest window, for the narrowest registers
+    uint64_t scratch_registers = 1;
+    while (scratch_registers < max_window / 16 + 1) {
+        scratch_registers <<= 1;
+    }
+    uint64_t scratch_bytes = scratch_registers * 64;
+    tree_scratch = std::aligned_alloc(64, scratch_bytes);
+
+    std::vector<Instruction_Set> sets = instruction_sets();
+    if (sets.empty()) {
+        std::cout << "No SIMD kernels are compiled into this binary." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::cout << "Windows every " << stride << " bytes of " << buffer_mb << "MB of random data, fastest of "
+              << repetitions << " runs, GB/s of window bytes" << std::endl;
+    std::cout << std::left << std::setw(8) << "window" << std::setw(12) << "isa" << std::setw(6) << "op";
+    for (const char *name : VARIANT_NAMES) {
+        std::cout << std::setw(13) << name;
+    }
+    std::cout << std::endl;
+
+    bool all_correct = true;
+    for (uint64_t window : windows) {
+        uint64_t num_windows = (buffer_size - window) / stride + 1;
+        for (bool maximum : {true, false}) {
+            std::vector<uint8_t> expected(num_windows);
+            for (uint64_t i = 0; i < num_windows; i++) {
+                const uint8_t *bytes = (const uint8_t *)data.data() + i * stride;
+                expected[i] = maximum ? *std::max_element(bytes, bytes + window)
+                                      : *std::min_element(bytes, bytes + window);
+            }
+
+            for (const Instruction_Set& set : sets) {
+                std::cout << std::left << std::setw(8) << window << std::setw(12) << set.name
+                          << std::setw(6) << (maximum ? "max" : "min");
+                if (!set.supported) {
+                    std::cout << "not supported by this CPU" << std::endl;
+                    continue;
+                }
+                for (const char *name : VARIANT_NAMES) {
+                    auto variant = std::find_if(set.variants.begin(), set.variants.end(),
+                                                [name](const Kernel_Variant& v) { return std::string(v.name) == name; });
+                    // The tree kernels only handle windows of whole registers
+                    if (variant == set.variants.end() ||
+                        (std::string(name) == "tree" && window % set.register_bytes != 0)) {
+                        std::cout << std::setw(13) << "-";
+                        continue;
+                    }
+                    std::memset(tree_scratch, maximum ? 0 : UINT8_MAX, scratch_bytes);
+                    double seconds = time_kernel(maximum ? variant->find_maximum : variant->find_minimum,
+                                                 data, window, stride, expected, repetitions);
+                    if (seconds < 0) {
+                        std::cout << std::setw(13) << "WRONG";
+                        all_correct = false;
+                        continue;
+                    }
+                    std::stringstream throughput;
+                    throughput << std::fixed << std::setprecision(1)
+                               << (double)num_windows * window / seconds / 1e9;
+                    std::cout << std::setw(13) << throughput.str();
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    std::free(tree_scratch);
+    if (!all_correct) {
+        std::cout << "Some kernels returned a wrong maximum or minimum." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+#!/bin/bash
+
+# Checks that the SIMD modes of MAXP cut the same chunks as its native search (simd_mode=none)
+# for every window size up to a limit, on random files of odd lengths
+
+DEDUP_EXE="../build/dedup.exe"
+MAX_WINDOW=64
+SIMD_MODES="sse128 avx256 avx512 sse128_noslide avx256_noslide avx512_noslide"
+
+
+function display_help() {
+    echo "Usage: $0 [OPTIONS]"
+    echo "Options:"
+    echo "  -h, --help          Show this help message"
+    echo "  -e, Path to dedup.exe {$DEDUP_EXE}"
+    echo "  -w, Largest maxp_window_size checked, every size from 1 is checked {$MAX_WINDOW}"
+    echo "  -m, SIMD modes compared with simd_mode=none {\"$SIMD_MODES\"}"
+    exit 1
+}
+
+# Process parameters
+while (( "$#" )); do
+  case "$1" in
+    -h|--help)
+        display_help
+        ;;
+    -e)
+      DEDUP_EXE="$2"
+      shift 2
+      ;;
+    -w)
+      MAX_WINDOW="$2"
+      shift 2
+      ;;
+    -m)
+      SIMD_MODES="$2"
+      shift 2
+      ;;
+    *)
+      echo "Error: Unknown option $1"
+      exit 1
+      ;;
+  esac
+done
+
+if [ ! -x "$DEDUP_EXE" ]; then
+    echo "Error: $DEDUP_EXE not found, build dedup.exe first or pass its path with -e"
+    exit 1
+fi
+
+# The config parser lowercases its values, so the output files go to a lowercase path
+WORK_DIR="maxp_equivalence_$$"
+mkdir -p "$WORK_DIR/data"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# Odd lengths around the smallest searchable chunk of small windows, and longer than the maximum block size
+for length in 1 3 5 7 9 31 33 63 65 67 129 257 1001 4095 4097 9999 65537; do
+    head -c $length /dev/urandom > "$WORK_DIR/data/random_$length"
+done
+# Few distinct bytes, so maxima tie and repeat in runs
+head -c 400000 /dev/urandom | tr -dc 'abc' | head -c 30001 > "$WORK_DIR/data/ties_30001"
+head -c 20001 /dev/zero > "$WORK_DIR/data/zero_20001"
+
+# Prints the output file of a run with the given simd_mode, window size and run_skip
+function run_dedup() {
+    local config="$WORK_DIR/$1_$2_$3.conf"
+    local output="$WORK_DIR/$1_$2_$3.out"
+    cat > "$config" << EOF
+chunking_algo=maxp
+hashing_algo=xxhash128
+output_file=$output
+simd_mode=$1
+buffer_size=10001
+maxp_window_size=$2
+maxp_max_block_size=4096
+run_skip=$3
+EOF
+    if ! "$DEDUP_EXE" "$WORK_DIR/data" "$config" > /dev/null 2>&1 || [ ! -f "$output" ]; then
+        echo "Error: dedup.exe failed with simd_mode=$1 maxp_window_size=$2 run_skip=$3"
+        exit 1
+    fi
+    echo "$output"
+}
+
+runs=0
+failures=0
+for window in $(seq 1 "$MAX_WINDOW"); do
+    for run_skip in false true; do
+        native=$(run_dedup none "$window" "$run_skip") || { echo "$native"; exit 1; }
+        for mode in $SIMD_MODES; do
+            simd=$(run_dedup "$mode" "$window" "$run_skip") || { echo "$simd"; exit 1; }
+            runs=$((runs + 1))
+            if ! cmp -s "$native" "$simd"; then
+                failures=$((failures + 1))
+                echo "MISMATCH: simd_mode=$mode maxp_window_size=$window run_skip=$run_skip"
+            fi
+        done
+    done
+done
+
+echo "$runs runs, $failures mismatches"
+[ "$failures" -eq 0 ]
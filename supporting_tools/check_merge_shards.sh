@@ -0,0 +1,104 @@
+#!/bin/bash
+
+# Checks that merge-shards.exe accounts for every byte of a file split into byte ranges,
+# whether the ranges resynchronize at a common boundary or not (manifest_range_overlap=1)
+
+BUILD_DIR="../build"
+FILE_SIZE=3000001
+SHARDS=4
+TECHNIQUES="gear fastcdc rabins"
+
+
+function display_help() {
+    echo "Usage: $0 [OPTIONS]"
+    echo "Options:"
+    echo "  -h, --help          Show this help message"
+    echo "  -b, Directory holding dedup.exe and merge-shards.exe {$BUILD_DIR}"
+    echo "  -s, Size in bytes of the random file that is split {$FILE_SIZE}"
+    echo "  -n, Number of byte ranges {$SHARDS}"
+    echo "  -t, Chunking techniques, each using its config in config_unaccelerated_8kb of the build directory {\"$TECHNIQUES\"}"
+    exit 1
+}
+
+# Process parameters
+while (( "$#" )); do
+  case "$1" in
+    -h|--help)
+        display_help
+        ;;
+    -b)
+      BUILD_DIR="$2"
+      shift 2
+      ;;
+    -s)
+      FILE_SIZE="$2"
+      shift 2
+      ;;
+    -n)
+      SHARDS="$2"
+      shift 2
+      ;;
+    -t)
+      TECHNIQUES="$2"
+      shift 2
+      ;;
+    *)
+      echo "Error: Unknown option $1"
+      exit 1
+      ;;
+  esac
+done
+
+for exe in dedup.exe merge-shards.exe; do
+    if [ ! -x "$BUILD_DIR/$exe" ]; then
+        echo "Error: $BUILD_DIR/$exe not found, build it first or pass its directory with -b"
+        exit 1
+    fi
+done
+
+# The config parser lowercases its values, so the output files go to a lowercase path
+WORK_DIR="merge_shards_check_$$"
+mkdir -p "$WORK_DIR"
+trap 'rm -rf "$WORK_DIR"' EXIT
+head -c "$FILE_SIZE" /dev/urandom > "$WORK_DIR/data"
+
+failures=0
+for overlap in 1 default; do
+    for technique in $TECHNIQUES; do
+        config="$BUILD_DIR/config_unaccelerated_8kb/${technique}_8kb.conf"
+        if [ ! -f "$config" ]; then
+            echo "Error: $config not found"
+            exit 1
+        fi
+        outputs=()
+        range_size=$(( (FILE_SIZE + SHARDS - 1) / SHARDS ))
+        for (( shard = 0; shard < SHARDS; shard++ )); do
+            start=$(( shard * range_size ))
+            end=$(( start + range_size < FILE_SIZE ? start + range_size : FILE_SIZE ))
+            printf '%s\t%d\t%d\n' "$WORK_DIR/data" $start $end > "$WORK_DIR/shard_$shard.manifest"
+            grep -v "output_file" "$config" > "$WORK_DIR/shard_$shard.conf"
+            echo "output_file=$WORK_DIR/shard_$shard.out" >> "$WORK_DIR/shard_$shard.conf"
+            if [ "$overlap" != "default" ]; then
+                echo "manifest_range_overlap=$overlap" >> "$WORK_DIR/shard_$shard.conf"
+            fi
+            if ! "$BUILD_DIR/dedup.exe" --manifest "$WORK_DIR/shard_$shard.manifest" "$WORK_DIR/shard_$shard.conf" \
+                    > /dev/null 2>&1 || [ ! -f "$WORK_DIR/shard_$shard.out" ]; then
+                echo "Error: dedup.exe failed on shard $shard with $config"
+                exit 1
+            fi
+            outputs+=("$WORK_DIR/shard_$shard.out")
+        done
+
+        merged_bytes=$("$BUILD_DIR/merge-shards.exe" "$WORK_DIR/merged.out" "${outputs[@]}" 2> /dev/null |
+                       grep "Total bytes without dedup" | grep -o "[0-9]*$")
+        file_bytes=$(awk -F, '{ total += $NF } END { print total + 0 }' "$WORK_DIR/merged.out")
+        if [ "$merged_bytes" != "$FILE_SIZE" ] || [ "$file_bytes" != "$FILE_SIZE" ]; then
+            failures=$((failures + 1))
+            echo "MISMATCH: $technique manifest_range_overlap=$overlap: reported $merged_bytes bytes," \
+                 "merged file holds $file_bytes, file has $FILE_SIZE"
+        fi
+    done
+done
+
+echo "$failures mismatches"
+[ "$failures" -eq 0 ]
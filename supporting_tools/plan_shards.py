@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+import os, sys, argparse
+
+# Pieces of a file smaller than this are not split off into their own range
+DEFAULT_MIN_SPLIT_SIZE = 64 * 1024 * 1024
+
+
+def list_files(dataset_dir: str) -> list:
+    """
+    Returns (path, size) of every regular file under a directory, in a stable order
+    @param dataset_dir: Root of the dataset
+    """
+    files = []
+    for root, dirs, names in os.walk(dataset_dir):
+        dirs.sort()
+        for name in sorted(names):
+            path = os.path.abspath(os.path.join(root, name))
+            if os.path.isfile(path) and not os.path.islink(path):
+                files.append((path, os.path.getsize(path)))
+    return files
+
+
+def plan_shards(files: list, num_shards: int, min_split_size: int) -> list:
+    """
+    Splits the dataset into num_shards lists of (path, start, end) of about the same size.
+    Files are assigned in order and split at the shard boundary when large enough.
+    @param files: (path, size) of every file
+    @param num_shards: Number of shards to create
+    @param min_split_size: Smallest byte range split off a file
+    """
+    total_bytes = sum(size for _, size in files)
+    target = max(1, -(-total_bytes // num_shards))
+    shards = [[] for _ in range(num_shards)]
+    shard = 0
+    shard_bytes = 0
+
+    for path, size in files:
+        start = 0
+        while True:
+            remaining = size - start
+            room = target - shard_bytes
+            last_shard = (shard == num_shards - 1)
+            if last_shard or remaining <= room:
+                shards[shard].append((path, start, size))
+                shard_bytes += remaining
+                break
+            if room >= min_split_size and remaining - room >= min_split_size:
+                # Split the file at the shard boundary
+                shards[shard].append((path, start, start + room))
+                start += room
+            elif remaining - room < min_split_size and room > 0:
+                # The leftover would be too small for a range of its own
+                shards[shard].append((path, start, size))
+                shard_bytes += remaining
+                break
+            shard += 1
+            shard_bytes = 0
+        if shard_bytes >= target and shard < num_shards - 1:
+            shard += 1
+            shard_bytes = 0
+    return shards
+
+
+def write_manifests(shards: list, output_prefix: str) -> None:
+    """
+    Writes one manifest per shard in the format read by dedup.exe --manifest
+    @param shards: Output of plan_shards
+    @param output_prefix: Manifest files are named <output_prefix>_<shard>.manifest
+    """
+    for idx, shard in enumerate(shards):
+        manifest_path = "{}_{}.manifest".format(output_prefix, idx)
+        shard_bytes = 0
+        with open(manifest_path, "w") as manifest:
+            for path, start, end in shard:
+                manifest.write("{}\t{}\t{}\n".format(path, start, end))
+                shard_bytes += end - start
+        print(manifest_path, ":", len(shard), "ranges,", shard_bytes, "bytes")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Split a dataset into manifests for sharded dedup.exe runs")
+    parser.add_argument("dataset_dir", help="Directory containing the dataset")
+    parser.add_argument("num_shards", type=int, help="Number of shards (dedup.exe processes)")
+    parser.add_argument("--output-prefix", default="shard", help="Prefix of the manifest files")
+    parser.add_argument("--min-split-size", type=int, default=DEFAULT_MIN_SPLIT_SIZE,
+                        help="Smallest byte range split off a file (default: 64 MiB)")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.dataset_dir):
+        print(args.dataset_dir, "is not a directory")
+        sys.exit(1)
+    if args.num_shards < 1:
+        print("num_shards must be at least 1")
+        sys.exit(1)
+
+    files = list_files(args.dataset_dir)
+    write_manifests(plan_shards(files, args.num_shards, args.min_split_size), args.output_prefix)